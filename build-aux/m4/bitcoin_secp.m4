@@ -14,6 +14,61 @@ AC_COMPILE_IFELSE([AC_LANG_PROGRAM([[
 AC_MSG_RESULT([$has_64bit_asm])
 ])
 
+dnl Sets has_sha256_hw to x86, arm or no depending on which hardware SHA256
+dnl intrinsics can be compiled for a function-level target, and on x86 whether
+dnl the compiler runtime can tell if the CPU supports them.
+AC_DEFUN([SECP_SHA256_HW_CHECK],[
+AC_MSG_CHECKING(for hardware SHA256 intrinsics)
+has_sha256_hw=no
+AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+  #include <immintrin.h>
+  __attribute__((target("sha,sse4.1"))) static __m128i f(__m128i a, __m128i b, __m128i c) {
+    return _mm_sha256rnds2_epu32(_mm_sha256msg1_epu32(a, b), _mm_blend_epi16(b, c, 0xF0), c);
+  }]],[[
+  __m128i x = _mm_setzero_si128();
+  if (__builtin_cpu_supports("sha") && __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1")) {
+    x = f(x, x, x);
+  }
+  (void)x;
+  ]])],[has_sha256_hw=x86])
+if test x"$has_sha256_hw" = x"no"; then
+  AC_COMPILE_IFELSE([AC_LANG_PROGRAM([[
+    #include <arm_neon.h>
+    #if defined(__clang__)
+    __attribute__((target("crypto")))
+    #else
+    __attribute__((target("+crypto")))
+    #endif
+    static uint32x4_t f(uint32x4_t a, uint32x4_t b, uint32x4_t c) {
+      return vsha256h2q_u32(vsha256hq_u32(a, b, c), vsha256su1q_u32(vsha256su0q_u32(a, b), b, c), c);
+    }]],[[
+    uint32x4_t x = vdupq_n_u32(0);
+    x = f(x, x, x);
+    (void)x;
+    ]])],[has_sha256_hw=arm])
+fi
+AC_MSG_RESULT([$has_sha256_hw])
+])
+
+dnl Sets has_field_ifma to yes if the AVX-512 IFMA intrinsics used by the
+dnl lane-parallel field multiplication can be compiled for a function-level target
+dnl and the compiler runtime can tell if the CPU supports them.
+AC_DEFUN([SECP_FIELD_SIMD_CHECK],[
+AC_MSG_CHECKING(for AVX-512 IFMA field multiplication support)
+AC_LINK_IFELSE([AC_LANG_PROGRAM([[
+  #include <immintrin.h>
+  __attribute__((target("avx2,avx512f,avx512vl,avx512ifma,prefer-vector-width=256"))) static void f(long long *r) {
+    __m256i x = _mm256_loadu_si256((const __m256i *)r);
+    _mm256_storeu_si256((__m256i *)r, _mm256_madd52hi_epu64(_mm256_madd52lo_epu64(x, x, x), x, x));
+  }]],[[
+  long long r[4] = {0};
+  if (__builtin_cpu_supports("avx512ifma") && __builtin_cpu_supports("avx512vl")) {
+    f(r);
+  }
+  ]])],[has_field_ifma=yes],[has_field_ifma=no])
+AC_MSG_RESULT([$has_field_ifma])
+])
+
 dnl
 AC_DEFUN([SECP_OPENSSL_CHECK],[
   has_libcrypto=no
@@ -106,6 +106,27 @@ typedef int (*secp256k1_nonce_function)(
     unsigned int attempt
 );
 
+/** A pointer to a function that runs a set of independent tasks, possibly in parallel.
+ *
+ *  The function must call fn(idx, fn_data) exactly once for every idx in
+ *  [0, n), in any order and from any thread, and must only return after all
+ *  of these calls have returned. The library never calls it recursively.
+ *
+ *  In:      fn:      the task to run (will not be NULL)
+ *           fn_data: opaque pointer that must be passed through to fn
+ *           n:       number of tasks
+ *           data:    Arbitrary data pointer that is passed through.
+ *
+ *  A trivial implementation is a loop that calls fn for idx = 0, ..., n-1.
+ *  Real implementations typically hand the calls to an existing thread pool.
+ */
+typedef void (*secp256k1_parallel_for_function)(
+    void (*fn)(size_t idx, void *fn_data),
+    void *fn_data,
+    size_t n,
+    void *data
+);
+
 # if !defined(SECP256K1_GNUC_PREREQ)
 #  if defined(__GNUC__)&&defined(__GNUC_MINOR__)
 #   define SECP256K1_GNUC_PREREQ(_maj,_min) \
@@ -220,18 +241,47 @@ SECP256K1_API secp256k1_context* secp256k1_context_clone(
     const secp256k1_context* ctx
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_WARN_UNUSED_RESULT;
 
+/** Copy a secp256k1 context object, sharing its precomputed tables.
+ *
+ *  The copy only consists of the context's own state, such as the
+ *  randomization set by secp256k1_context_randomize and the callbacks, which
+ *  can be changed independently for each copy. The precomputed tables, which
+ *  are never modified, are shared with ctx, and they are freed when the last
+ *  context sharing them is destroyed, in any order. This makes creating a
+ *  context per thread cheap in time and memory. Copies of the returned
+ *  context made by this function or by secp256k1_context_clone share the
+ *  same tables; copies of it cannot be made with
+ *  secp256k1_context_preallocated_clone.
+ *
+ *  The tables can only be shared if ctx (or the context it shares its
+ *  tables with) was created with secp256k1_context_create or
+ *  secp256k1_context_clone and the compiler provides atomic operations.
+ *  Otherwise this is the same as secp256k1_context_clone.
+ *
+ *  This function uses malloc to allocate memory. It is guaranteed that malloc is
+ *  called at most once for every call of this function.
+ *
+ *  Returns: a newly created context object, to be destroyed with
+ *           secp256k1_context_destroy.
+ *  Args:    ctx: an existing context to copy (cannot be NULL)
+ */
+SECP256K1_API secp256k1_context* secp256k1_context_clone_shared(
+    const secp256k1_context* ctx
+) SECP256K1_ARG_NONNULL(1) SECP256K1_WARN_UNUSED_RESULT;
+
 /** Destroy a secp256k1 context object (created in dynamically allocated memory).
  *
  *  The context pointer may not be used afterwards.
  *
- *  The context to destroy must have been created using secp256k1_context_create
- *  or secp256k1_context_clone. If the context has instead been created using
- *  secp256k1_context_preallocated_create or secp256k1_context_preallocated_clone, the
- *  behaviour is undefined. In that case, secp256k1_context_preallocated_destroy must
- *  be used instead.
+ *  The context to destroy must have been created using secp256k1_context_create,
+ *  secp256k1_context_clone or secp256k1_context_clone_shared. If the context has
+ *  instead been created using secp256k1_context_preallocated_create or
+ *  secp256k1_context_preallocated_clone, the behaviour is undefined. In that case,
+ *  secp256k1_context_preallocated_destroy must be used instead.
  *
  *  Args:   ctx: an existing context to destroy, constructed using
- *               secp256k1_context_create or secp256k1_context_clone
+ *               secp256k1_context_create, secp256k1_context_clone or
+ *               secp256k1_context_clone_shared
  */
 SECP256K1_API void secp256k1_context_destroy(
     secp256k1_context* ctx
@@ -473,6 +523,35 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify(
     const secp256k1_pubkey *pubkey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Verify a set of ECDSA signatures, each with its own message and public key.
+ *
+ *  Returns: 1: all signatures are correct (in particular if n_sigs is 0)
+ *           0: at least one signature is incorrect or unparseable
+ *  Args:    ctx:       a secp256k1 context object, initialized for verification.
+ *  Out:     results:   pointer to an array of n_sigs ints. results[i] is set to 1 if
+ *                      the i-th signature is correct and to 0 otherwise (can be NULL
+ *                      if only the combined result is of interest)
+ *  In:      sig:       array of pointers to signatures, or NULL if there are no signatures
+ *           msg32:     array of pointers to 32-byte message hashes, or NULL if there
+ *                      are no signatures
+ *           pubkey:    array of pointers to public keys, or NULL if there are no signatures
+ *           n_sigs:    number of signatures in above arrays. Must be 0 if they are NULL.
+ *
+ * Every signature is checked independently and with the same rules as
+ * secp256k1_ecdsa_verify, so a single invalid signature does not affect the
+ * result of the others. This function is faster than repeated calls to
+ * secp256k1_ecdsa_verify because the modular inversions of the signatures'
+ * s values are computed together.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify_batch(
+    const secp256k1_context* ctx,
+    int *results,
+    const secp256k1_ecdsa_signature *const *sig,
+    const unsigned char *const *msg32,
+    const secp256k1_pubkey *const *pubkey,
+    size_t n_sigs
+) SECP256K1_ARG_NONNULL(1);
+
 /** Convert a signature to a normalized lower-S form.
  *
  *  Returns: 1 if sigin was not normalized, 0 if it already was.
@@ -565,6 +644,37 @@ SECP256K1_API int secp256k1_ecdsa_sign(
     const void *ndata
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Create ECDSA signatures for a set of messages with the same secret key.
+ *
+ *  Produces the same signatures as calling secp256k1_ecdsa_sign for each message,
+ *  but the nonce points are converted to affine coordinates and the nonces are
+ *  inverted with one shared inversion per batch. With RFC6979 nonces, the part of
+ *  the nonce derivation that only depends on the secret key is computed once.
+ *
+ *  Returns: 1: all signatures were created
+ *           0: the secret key was invalid, or the nonce generation function failed
+ *              for at least one message
+ *  Args:    ctx:    pointer to a context object, initialized for signing (cannot be NULL)
+ *  Out:     sig:    pointer to an array of n_sigs signatures. Signatures that could not
+ *                   be created are zeroed. (cannot be NULL unless n_sigs is 0)
+ *  In:      msg32:  array of n_sigs pointers to 32-byte message hashes (cannot be NULL
+ *                   unless n_sigs is 0)
+ *           n_sigs: the number of signatures to create
+ *           seckey: pointer to a 32-byte secret key (cannot be NULL unless n_sigs is 0)
+ *           noncefp:pointer to a nonce generation function. If NULL, secp256k1_nonce_function_default is used
+ *           ndata:  pointer to arbitrary data passed to every call of the nonce
+ *                   generation function (can be NULL)
+ */
+SECP256K1_API int secp256k1_ecdsa_sign_batch(
+    const secp256k1_context* ctx,
+    secp256k1_ecdsa_signature *sig,
+    const unsigned char *const *msg32,
+    size_t n_sigs,
+    const unsigned char *seckey,
+    secp256k1_nonce_function noncefp,
+    const void *ndata
+) SECP256K1_ARG_NONNULL(1);
+
 /** Verify an ECDSA secret key.
  *
  *  Returns: 1: secret key is valid
@@ -591,6 +701,38 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_create(
     const unsigned char *seckey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Compute the public keys for a set of secret keys.
+ *
+ *  Returns: 1: all secret keys were valid
+ *           0: at least one secret key was invalid
+ *  Args:   ctx:        pointer to a context object, initialized for signing (cannot be NULL)
+ *  Out:    results:    pointer to an array of n ints. results[i] is set to 1 if the i-th
+ *                      secret key was valid and to 0 otherwise (can be NULL if only the
+ *                      combined result is of interest)
+ *          pubkey:     pointer to an array of n public keys. The public keys of invalid
+ *                      secret keys are zeroed. (cannot be NULL unless n is 0)
+ *          output33:   pointer to n*33 bytes to be filled with the compressed
+ *                      serializations of the public keys, in order, or NULL if they
+ *                      are not needed. The serialization of an invalid secret key's
+ *                      public key is zeroed.
+ *  In:     seckey:     pointer to n*32 bytes holding the secret keys one after the
+ *                      other (cannot be NULL unless n is 0)
+ *          n:          the number of secret keys
+ *
+ *  The result is the same as calling secp256k1_ec_pubkey_create (and
+ *  secp256k1_ec_pubkey_serialize with SECP256K1_EC_COMPRESSED) for every key,
+ *  but the conversions to affine coordinates share one field inversion per
+ *  batch, and the point multiplications are interleaved where the CPU allows.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_create_batch(
+    const secp256k1_context* ctx,
+    int *results,
+    secp256k1_pubkey *pubkey,
+    unsigned char *output33,
+    const unsigned char *seckey,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
 /** Negates a private key in place.
  *
  *  Returns: 1 always
@@ -644,6 +786,37 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_tweak_add(
     const unsigned char *tweak
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
 
+/** Tweak a set of public keys by adding tweak times the generator to each.
+ *
+ *  Returns: 1: all public keys were tweaked successfully
+ *           0: at least one tweak was out of range, one resulting public key would
+ *              be invalid, or one input public key could not be loaded
+ *  Args:    ctx:     pointer to a context object initialized for validation or for
+ *                    signing (cannot be NULL). The latter is faster.
+ *  Out:     results: pointer to an array of n ints. results[i] is set to 1 if the
+ *                    i-th public key was tweaked successfully and to 0 otherwise
+ *                    (can be NULL if only the combined result is of interest)
+ *           output:  pointer to an array of n public keys, set to *pubkey[i] tweaked
+ *                    by tweak32[i], or zeroed if that failed. output[i] may be the
+ *                    same object as *pubkey[i], but may not overlap any other input.
+ *  In:      pubkey:  array of n pointers to public keys. Pointers may repeat, e.g. to
+ *                    derive many children of the same parent key.
+ *           tweak32: array of n pointers to 32-byte tweaks
+ *           n:       the number of public keys. pubkey and tweak32 may be NULL if
+ *                    it is 0.
+ *
+ *  The results are the same as those of secp256k1_ec_pubkey_tweak_add, but the
+ *  conversions to affine coordinates share one field inversion per batch.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ec_pubkey_tweak_add_batch(
+    const secp256k1_context* ctx,
+    int *results,
+    secp256k1_pubkey *output,
+    const secp256k1_pubkey *const *pubkey,
+    const unsigned char *const *tweak32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
 /** Tweak a private key by multiplying it by a tweak.
  * Returns: 0 if the tweak was out of range (chance of around 1 in 2^128 for
  *          uniformly random 32-byte arrays, or equal to zero. 1 otherwise.
@@ -855,6 +1028,35 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_xonly_pubkey_tweak_add(
     const unsigned char *tweak32
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Tweak a set of x-only public keys by adding tweak times the generator to each.
+ *
+ *  Returns: 1: all public keys were tweaked successfully
+ *           0: at least one tweak was out of range, one resulting public key would
+ *              be invalid, or one input public key could not be loaded
+ *  Args:       ctx: pointer to a context object initialized for validation or for
+ *                   signing (cannot be NULL). The latter is faster.
+ *  Out:    results: pointer to an array of n ints, set as in
+ *                   secp256k1_ec_pubkey_tweak_add_batch (can be NULL)
+ *           output: pointer to an array of n x-only public keys, set as
+ *                   secp256k1_xonly_pubkey_tweak_add would set *pubkey[i], or zeroed
+ *                   if that failed. output[i] may be the same object as *pubkey[i],
+ *                   but may not overlap any other input.
+ *       is_negated: pointer to an array of n ints, set as secp256k1_xonly_pubkey_tweak_add
+ *                   would (0 if the tweak failed). (cannot be NULL unless n is 0)
+ *  In:      pubkey: array of n pointers to x-only public keys. Pointers may repeat.
+ *          tweak32: array of n pointers to 32-byte tweaks
+ *                n: the number of public keys
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_xonly_pubkey_tweak_add_batch(
+    const secp256k1_context* ctx,
+    int *results,
+    secp256k1_xonly_pubkey *output,
+    int *is_negated,
+    const secp256k1_xonly_pubkey *const *pubkey,
+    const unsigned char *const *tweak32,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
 /** Tests that output_pubkey and is_negated are the result of calling
  *  secp256k1_xonly_pubkey_tweak_add with internal_pubkey and tweak32. Note
  *  that this alone does _not_ verify that output_pubkey is a commitment. If the
@@ -882,6 +1084,95 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_xonly_pubkey_tweak_test
     const unsigned char *tweak32
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
 
+/** Opaque data structure that holds a keypair consisting of a secret and a
+ *  public key. The secret key is stored negated if necessary so that it
+ *  matches the x-only public key, which lets signing functions skip
+ *  recomputing the public key.
+ *
+ *  The exact representation of data inside is implementation defined and not
+ *  guaranteed to be portable between different platforms or versions. It is
+ *  however guaranteed to be 96 bytes in size, and can be safely copied/moved.
+ *  It contains the secret key, so it should be cleared when no longer needed.
+ */
+typedef struct {
+    unsigned char data[96];
+} secp256k1_keypair;
+
+/** Compute the keypair for a secret key.
+ *
+ *  Returns: 1: secret was valid, keypair is ready to use
+ *           0: secret was invalid, try again with a different secret
+ *  Args:    ctx: pointer to a context object, initialized for signing (cannot be NULL)
+ *  Out: keypair: pointer to the created keypair (cannot be NULL)
+ *  In:   seckey: pointer to a 32-byte secret key (cannot be NULL)
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_keypair_create(
+    const secp256k1_context* ctx,
+    secp256k1_keypair *keypair,
+    const unsigned char *seckey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Get the x-only public key from a keypair.
+ *
+ *  Returns: 0 if the arguments are invalid. 1 otherwise.
+ *  Args:    ctx: pointer to a context object (cannot be NULL)
+ *  Out:  pubkey: pointer to an x-only public key object, set to the same key that
+ *                secp256k1_xonly_pubkey_create computes from the secret key
+ *                (cannot be NULL)
+ *  In:  keypair: pointer to a keypair (cannot be NULL)
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_keypair_xonly_pub(
+    const secp256k1_context* ctx,
+    secp256k1_xonly_pubkey *pubkey,
+    const secp256k1_keypair *keypair
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Opaque data structure that holds a table of precomputed multiples of a
+ *  public key. Functions which multiply the same public keys with many
+ *  different scalars, such as secp256k1_musig_pubkey_combine_tables, can use
+ *  it to skip rebuilding the table on every call.
+ *
+ *  The exact representation of data inside is implementation defined and not
+ *  guaranteed to be portable between different platforms or versions. It is
+ *  however guaranteed to be 4096 bytes in size, contains no pointers and can be
+ *  safely copied/moved, for example into preallocated or memory-mapped
+ *  storage. A table must only be used with the build of the library that
+ *  created it.
+ *
+ *  Functions taking a table only check that its first entry is the public key
+ *  it is used with. The caller is responsible for the integrity of the rest of
+ *  the table: a corrupted table results in wrong outputs, not in an error.
+ */
+typedef struct {
+    unsigned char data[4096];
+} secp256k1_pubkey_table;
+
+/** Compute the table of precomputed multiples of a public key.
+ *
+ *  Returns: 1 if the public key was valid and the table was created, 0 otherwise.
+ *  Args:    ctx: a secp256k1 context object.
+ *  Out:   table: pointer to the table to be filled (cannot be NULL)
+ *  In:   pubkey: pointer to an initialized public key (cannot be NULL)
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_pubkey_table_create(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey_table *table,
+    const secp256k1_pubkey *pubkey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
+/** Same as secp256k1_pubkey_table_create, but for an xonly public key.
+ *
+ *  Returns: 1 if the public key was valid and the table was created, 0 otherwise.
+ *  Args:    ctx: a secp256k1 context object.
+ *  Out:   table: pointer to the table to be filled (cannot be NULL)
+ *  In:   pubkey: pointer to an initialized xonly public key (cannot be NULL)
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_xonly_pubkey_table_create(
+    const secp256k1_context* ctx,
+    secp256k1_pubkey_table *table,
+    const secp256k1_xonly_pubkey *pubkey
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3);
+
 #ifdef __cplusplus
 }
 #endif
@@ -159,6 +159,34 @@ SECP256K1_API int secp256k1_musig_pubkey_combine(
     size_t n_pubkeys
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(5);
 
+/** Same as secp256k1_musig_pubkey_combine, but uses precomputed tables of
+ *  the public keys (see secp256k1_xonly_pubkey_table_create) to speed up the
+ *  multiexponentiation. Useful for long-running signers that combine the same
+ *  set of keys repeatedly.
+ *
+ *  Returns: 1 if the public keys were successfully combined, 0 otherwise
+ *           (including if the first entry of a table is not its public key)
+ *  Args:        ctx: pointer to a context object initialized for verification
+ *                    (cannot be NULL)
+ *  Out: combined_pk: the MuSig-combined xonly public key (cannot be NULL)
+ *       pre_session: if non-NULL, pointer to a musig_pre_session struct to be used in
+ *                    `musig_session_init` or `musig_pubkey_tweak_add`.
+ *   In:     pubkeys: input array of public keys to combine. The order is important;
+ *                    a different order will result in a different combined public
+ *                    key (cannot be NULL)
+ *            tables: array of n_pubkeys tables, where tables[i] was created
+ *                    from pubkeys[i] (cannot be NULL)
+ *         n_pubkeys: length of pubkeys and tables arrays. Must be greater than 0.
+ */
+SECP256K1_API int secp256k1_musig_pubkey_combine_tables(
+    const secp256k1_context* ctx,
+    secp256k1_xonly_pubkey *combined_pk,
+    secp256k1_musig_pre_session *pre_session,
+    const secp256k1_xonly_pubkey *pubkeys,
+    const secp256k1_pubkey_table *tables,
+    size_t n_pubkeys
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5);
+
 /** Tweak a MuSig-combined public key by adding tweak times the generator to it.
  *  Passes `secp256k1_xonly_pubkey_tweak_test`. `musig_pubkey_tweak_add` is
  *  only useful before initializing a signing session. Otherwise just use
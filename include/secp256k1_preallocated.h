@@ -66,6 +66,48 @@ SECP256K1_API secp256k1_context* secp256k1_context_preallocated_create(
     unsigned int flags
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_WARN_UNUSED_RESULT;
 
+/** Determine the memory size of a secp256k1 context object with a given
+ *  verification window size to be created in caller-provided memory.
+ *
+ *  Returns: the required size of the caller-provided memory block, or 0 if
+ *           the flags or window size are invalid.
+ *  In:      flags:  which parts of the context to initialize.
+ *           window: the window size, see
+ *                   secp256k1_context_preallocated_create_with_window.
+ */
+SECP256K1_API size_t secp256k1_context_preallocated_size_with_window(
+    unsigned int flags,
+    unsigned int window
+) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Create a secp256k1 context object with a given verification window size in
+ *  caller-provided memory.
+ *
+ *  Same as secp256k1_context_preallocated_create, but the table of multiples
+ *  of the generator used for verification has 2^(window-2) entries instead of
+ *  the number chosen at build time with --with-ecmult-window. Larger windows
+ *  make verification faster at the cost of memory and of the time to build the
+ *  table when the context is created; the build-time window size is a good
+ *  compromise. The window size is kept when the context is cloned.
+ *
+ *  The caller must provide a pointer to a rewritable contiguous block of memory
+ *  of size at least secp256k1_context_preallocated_size_with_window(flags, window)
+ *  bytes, suitably aligned to hold an object of any type. Its ownership is as
+ *  described for secp256k1_context_preallocated_create.
+ *
+ *  Returns: a newly created context object, or NULL if the flags or window
+ *           size are invalid.
+ *  In:      prealloc: a pointer to a rewritable contiguous block of memory as
+ *                     detailed above (cannot be NULL)
+ *           flags:    which parts of the context to initialize.
+ *           window:   the window size, in the range [2..24].
+ */
+SECP256K1_API secp256k1_context* secp256k1_context_preallocated_create_with_window(
+    void* prealloc,
+    unsigned int flags,
+    unsigned int window
+) SECP256K1_ARG_NONNULL(1) SECP256K1_WARN_UNUSED_RESULT;
+
 /** Determine the memory size of a secp256k1 context object to be copied into
  *  caller-provided memory.
  *
@@ -121,6 +163,114 @@ SECP256K1_API void secp256k1_context_preallocated_destroy(
     secp256k1_context* ctx
 );
 
+/* The precomputed tables of a context (the table for signing and the multiples
+ * of the generator for verification, whose size grows with the ecmult window
+ * size) can be serialized into a versioned and checksummed format. When the
+ * result is written to a file, processes can map that file read-only and
+ * create contexts that use the tables in place. They then share one physical
+ * copy of the tables through the page cache, and creating a context takes the
+ * same time regardless of the window size.
+ *
+ * Serialized tables are only usable with a build of the library that has the
+ * same endomorphism setting, signing table layout (--with-ecmult-gen-blocks
+ * and --with-ecmult-gen-teeth) and internal representation of points as the
+ * one that created them. Their verification window size is that of the context
+ * they were serialized from.
+ */
+
+/** Determine the size of the serialized precomputed tables.
+ *
+ *  Returns: the size of the output of secp256k1_context_precomputed_serialize
+ *           for the given flags, or 0 if the flags are invalid.
+ *  In:      flags: which tables to serialize (SECP256K1_CONTEXT_SIGN,
+ *                  SECP256K1_CONTEXT_VERIFY, or both combined).
+ */
+SECP256K1_API size_t secp256k1_context_precomputed_size(
+    unsigned int flags
+) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Determine the size of the serialized precomputed tables of a context
+ *  created with the given verification window size (see
+ *  secp256k1_context_preallocated_create_with_window).
+ *
+ *  Returns: the size of the output of secp256k1_context_precomputed_serialize
+ *           for the given flags and window size, or 0 if they are invalid.
+ *  In:      flags:  which tables to serialize.
+ *           window: the window size of the context.
+ */
+SECP256K1_API size_t secp256k1_context_precomputed_size_with_window(
+    unsigned int flags,
+    unsigned int window
+) SECP256K1_WARN_UNUSED_RESULT;
+
+/** Serialize the precomputed tables of a context.
+ *
+ *  Returns: 1 if the tables were serialized, 0 if ctx was not initialized for
+ *           the requested flags or output is too small.
+ *  Args:    ctx:       a secp256k1 context object initialized for every part
+ *                      requested in flags (cannot be NULL)
+ *  Out:     output:    pointer to a buffer of outputlen bytes (cannot be NULL)
+ *  In:      outputlen: size of output, at least
+ *                      secp256k1_context_precomputed_size_with_window(flags, w)
+ *                      where w is the window size of ctx
+ *           flags:     which tables to serialize.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_context_precomputed_serialize(
+    const secp256k1_context* ctx,
+    unsigned char *output,
+    size_t outputlen,
+    unsigned int flags
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Check that serialized precomputed tables are intact and usable by this build.
+ *
+ *  In addition to the checks done by
+ *  secp256k1_context_preallocated_create_precomputed, this verifies the
+ *  checksum over the entire input, so it reads all of it. It is meant to be
+ *  called once after writing or installing a table file, not at every context
+ *  creation.
+ *
+ *  Returns: 1 if the tables are valid, 0 otherwise.
+ *  Args:    ctx:      a secp256k1 context object (cannot be NULL)
+ *  In:      input:    pointer to the serialized tables (cannot be NULL)
+ *           inputlen: size of input in bytes
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_context_precomputed_verify(
+    const secp256k1_context* ctx,
+    const unsigned char *input,
+    size_t inputlen
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2);
+
+/** Create a secp256k1 context object in caller-provided memory that uses
+ *  serialized precomputed tables in place instead of building its own.
+ *
+ *  The caller must provide a pointer to a rewritable contiguous block of memory
+ *  of size at least secp256k1_context_preallocated_size(SECP256K1_CONTEXT_NONE)
+ *  bytes, suitably aligned to hold an object of any type. Its ownership is as
+ *  described for secp256k1_context_preallocated_create.
+ *
+ *  The tables are neither copied nor fully checked (see
+ *  secp256k1_context_precomputed_verify). input must be suitably aligned to hold
+ *  an object of any type, which is the case for the start of a memory mapping,
+ *  and must remain valid and unmodified until the context and all its clones
+ *  have been destroyed.
+ *
+ *  Returns: a newly created context object, or NULL if input is not a
+ *           serialization of tables for every part requested in flags that is
+ *           usable by this build.
+ *  In:      prealloc: a pointer to a rewritable contiguous block of memory as
+ *                     detailed above (cannot be NULL)
+ *           flags:    which parts of the context to initialize.
+ *           input:    pointer to the serialized tables (cannot be NULL)
+ *           inputlen: size of input in bytes
+ */
+SECP256K1_API secp256k1_context* secp256k1_context_preallocated_create_precomputed(
+    void* prealloc,
+    unsigned int flags,
+    const unsigned char *input,
+    size_t inputlen
+) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(3) SECP256K1_WARN_UNUSED_RESULT;
+
 #ifdef __cplusplus
 }
 #endif
@@ -189,6 +189,49 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_rangeproof_verify(
   const secp256k1_generator* gen
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4) SECP256K1_ARG_NONNULL(5) SECP256K1_ARG_NONNULL(9);
 
+/** Verify a set of range proofs, each for its own commitment.
+ * Returns 1: All proofs are valid (in particular if n_proofs is 0).
+ *         0: At least one proof failed or other error.
+ * In:   ctx: pointer to a context object, initialized for range-proof and commitment (cannot be NULL)
+ *       scratch: scratch space used to verify many proofs at once. If it is NULL, too small
+ *                to hold a single proof or allocating from it fails, the proofs are verified
+ *                one by one; the outputs are written in every case.
+ *       commit: array of pointers to the commitments being proved, or NULL if n_proofs is 0.
+ *       proof: array of pointers to character arrays with the proofs, or NULL if n_proofs is 0.
+ *       plen: array of proof lengths in bytes, or NULL if n_proofs is 0.
+ *       extra_commit: array of pointers to additional data covered in each rangeproof signature.
+ *                     Can be NULL if no proof has extra data, and extra_commit[i] can be NULL
+ *                     if proof i has none.
+ *       extra_commit_len: array of lengths of the extra_commit byte arrays (can be NULL if extra_commit is)
+ *       gen: array of pointers to the additional generators 'h' of each proof, or NULL if n_proofs is 0.
+ *       n_proofs: number of proofs in above arrays.
+ * Out:  results: pointer to an array of n_proofs ints. results[i] is set to 1 if the i-th proof is
+ *                valid and to 0 otherwise (can be NULL if only the combined result is of interest).
+ *       min_value: pointer to an array of n_proofs unsigned int64 which will be updated with the minimum
+ *                  value that each commit could have (can be NULL).
+ *       max_value: pointer to an array of n_proofs unsigned int64 which will be updated with the maximum
+ *                  value that each commit could have (can be NULL).
+ *
+ * Every proof is checked with the same rules as secp256k1_rangeproof_verify, so an invalid proof does
+ * not affect the result of the others. Proofs are faster to verify in a batch because the challenge
+ * chains of all their rings are processed in lockstep, sharing the field inversions which convert the
+ * ring members to affine coordinates.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_rangeproof_verify_batch(
+  const secp256k1_context* ctx,
+  secp256k1_scratch_space *scratch,
+  int *results,
+  uint64_t *min_value,
+  uint64_t *max_value,
+  const secp256k1_pedersen_commitment * const *commit,
+  const unsigned char * const *proof,
+  const size_t *plen,
+  const unsigned char * const *extra_commit,
+  const size_t *extra_commit_len,
+  const secp256k1_generator * const *gen,
+  size_t n_proofs
+) SECP256K1_ARG_NONNULL(1);
+
 /** Verify a range proof proof and rewind the proof to recover information sent by its author.
  *  Returns 1: Value is within the range [0..2^64), the specifically proven range is in the min/max value outputs, and the value and blinding were recovered.
  *          0: Proof failed, rewind failed, or other error.
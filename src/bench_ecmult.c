@@ -148,6 +148,9 @@ int main(int argc, char **argv) {
         if(have_flag(argc, argv, "pippenger_wnaf")) {
             printf("Using pippenger_wnaf:\n");
             data.ecmult_multi = secp256k1_ecmult_pippenger_batch_single;
+        } else if(have_flag(argc, argv, "pippenger_affine")) {
+            printf("Using pippenger_wnaf with affine buckets:\n");
+            data.ecmult_multi = secp256k1_ecmult_pippenger_affine_batch_single;
         } else if(have_flag(argc, argv, "strauss_wnaf")) {
             printf("Using strauss_wnaf:\n");
             data.ecmult_multi = secp256k1_ecmult_strauss_batch_single;
@@ -158,7 +161,7 @@ int main(int argc, char **argv) {
             data.scratch = NULL;
         } else {
             fprintf(stderr, "%s: unrecognized argument '%s'.\n", argv[0], argv[1]);
-            fprintf(stderr, "Use 'pippenger_wnaf', 'strauss_wnaf', 'simple' or no argument to benchmark a combined algorithm.\n");
+            fprintf(stderr, "Use 'pippenger_wnaf', 'pippenger_affine', 'strauss_wnaf', 'simple' or no argument to benchmark a combined algorithm.\n");
             return 1;
         }
     }
@@ -23,6 +23,8 @@ typedef struct {
     secp256k1_fe fe_x, fe_y;
     secp256k1_ge ge_x, ge_y;
     secp256k1_gej gej_x, gej_y;
+    secp256k1_fe_lanes lanes_x, lanes_y;
+    secp256k1_context *ctx;
     unsigned char data[64];
     int wnaf[256];
 } bench_inv;
@@ -52,6 +54,8 @@ void bench_setup(void* arg) {
     CHECK(secp256k1_ge_set_xo_var(&data->ge_y, &data->fe_y, 1));
     secp256k1_gej_set_ge(&data->gej_x, &data->ge_x);
     secp256k1_gej_set_ge(&data->gej_y, &data->ge_y);
+    secp256k1_fe_lanes_set_all(&data->lanes_x, &data->fe_x);
+    secp256k1_fe_lanes_set_all(&data->lanes_y, &data->fe_y);
     memcpy(data->data, init_x, 32);
     memcpy(data->data + 32, init_y, 32);
 }
@@ -161,6 +165,26 @@ void bench_field_sqr(void* arg) {
     }
 }
 
+/* The lane benchmarks process SECP256K1_FE_LANES elements per iteration and are
+ * reported per element. */
+void bench_field_lanes_mul(void* arg) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+
+    for (i = 0; i < 200000 / SECP256K1_FE_LANES; i++) {
+        secp256k1_fe_lanes_mul(&data->lanes_x, &data->lanes_x, &data->lanes_y);
+    }
+}
+
+void bench_field_lanes_sqr(void* arg) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+
+    for (i = 0; i < 200000 / SECP256K1_FE_LANES; i++) {
+        secp256k1_fe_lanes_sqr(&data->lanes_x, &data->lanes_x);
+    }
+}
+
 void bench_field_inverse(void* arg) {
     int i;
     bench_inv *data = (bench_inv*)arg;
@@ -193,6 +217,19 @@ void bench_field_sqrt(void* arg) {
     }
 }
 
+void bench_field_is_quad_var(void* arg) {
+    int i, j = 0;
+    bench_inv *data = (bench_inv*)arg;
+    secp256k1_fe t = data->fe_x;
+
+    for (i = 0; i < 20000; i++) {
+        j += secp256k1_fe_is_quad_var(&t);
+        secp256k1_fe_add(&t, &data->fe_y);
+        secp256k1_fe_normalize_var(&t);
+    }
+    CHECK(j <= 20000);
+}
+
 void bench_group_double_var(void* arg) {
     int i;
     bench_inv *data = (bench_inv*)arg;
@@ -238,6 +275,32 @@ void bench_group_jacobi_var(void* arg) {
     }
 }
 
+void bench_ecmult_gen(void* arg) {
+    int i;
+    bench_inv *data = (bench_inv*)arg;
+
+    for (i = 0; i < 2000; i++) {
+        secp256k1_ecmult_gen(&data->ctx->ecmult_gen_ctx, &data->gej_x, &data->scalar_x);
+        secp256k1_scalar_add(&data->scalar_x, &data->scalar_x, &data->scalar_y);
+    }
+}
+
+void bench_ecmult_gen_multi(void* arg) {
+    int i, j;
+    bench_inv *data = (bench_inv*)arg;
+    secp256k1_scalar s[SECP256K1_FE_LANES];
+    secp256k1_gej r[SECP256K1_FE_LANES];
+
+    for (i = 0; i < 2000 / SECP256K1_FE_LANES; i++) {
+        for (j = 0; j < SECP256K1_FE_LANES; j++) {
+            secp256k1_scalar_add(&data->scalar_x, &data->scalar_x, &data->scalar_y);
+            s[j] = data->scalar_x;
+        }
+        secp256k1_ecmult_gen_multi(&data->ctx->ecmult_gen_ctx, r, s, SECP256K1_FE_LANES);
+    }
+    data->gej_x = r[0];
+}
+
 void bench_ecmult_wnaf(void* arg) {
     int i;
     bench_inv *data = (bench_inv*)arg;
@@ -328,6 +391,8 @@ void bench_num_jacobi(void* arg) {
 
 int main(int argc, char **argv) {
     bench_inv data;
+    /* Creating a context also selects the field implementations. */
+    data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
     if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "add")) run_benchmark("scalar_add", bench_scalar_add, bench_setup, NULL, &data, 10, 2000000);
     if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "negate")) run_benchmark("scalar_negate", bench_scalar_negate, bench_setup, NULL, &data, 10, 2000000);
     if (have_flag(argc, argv, "scalar") || have_flag(argc, argv, "sqr")) run_benchmark("scalar_sqr", bench_scalar_sqr, bench_setup, NULL, &data, 10, 200000);
@@ -342,9 +407,12 @@ int main(int argc, char **argv) {
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "normalize")) run_benchmark("field_normalize_weak", bench_field_normalize_weak, bench_setup, NULL, &data, 10, 2000000);
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "sqr")) run_benchmark("field_sqr", bench_field_sqr, bench_setup, NULL, &data, 10, 200000);
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "mul")) run_benchmark("field_mul", bench_field_mul, bench_setup, NULL, &data, 10, 200000);
+    if (have_flag(argc, argv, "field") || have_flag(argc, argv, "sqr") || have_flag(argc, argv, "lanes")) run_benchmark("field_lanes_sqr", bench_field_lanes_sqr, bench_setup, NULL, &data, 10, 200000);
+    if (have_flag(argc, argv, "field") || have_flag(argc, argv, "mul") || have_flag(argc, argv, "lanes")) run_benchmark("field_lanes_mul", bench_field_lanes_mul, bench_setup, NULL, &data, 10, 200000);
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "inverse")) run_benchmark("field_inverse", bench_field_inverse, bench_setup, NULL, &data, 10, 20000);
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "inverse")) run_benchmark("field_inverse_var", bench_field_inverse_var, bench_setup, NULL, &data, 10, 20000);
     if (have_flag(argc, argv, "field") || have_flag(argc, argv, "sqrt")) run_benchmark("field_sqrt", bench_field_sqrt, bench_setup, NULL, &data, 10, 20000);
+    if (have_flag(argc, argv, "field") || have_flag(argc, argv, "jacobi")) run_benchmark("field_is_quad_var", bench_field_is_quad_var, bench_setup, NULL, &data, 10, 20000);
 
     if (have_flag(argc, argv, "group") || have_flag(argc, argv, "double")) run_benchmark("group_double_var", bench_group_double_var, bench_setup, NULL, &data, 10, 200000);
     if (have_flag(argc, argv, "group") || have_flag(argc, argv, "add")) run_benchmark("group_add_var", bench_group_add_var, bench_setup, NULL, &data, 10, 200000);
@@ -354,6 +422,8 @@ int main(int argc, char **argv) {
 
     if (have_flag(argc, argv, "ecmult") || have_flag(argc, argv, "wnaf")) run_benchmark("wnaf_const", bench_wnaf_const, bench_setup, NULL, &data, 10, 20000);
     if (have_flag(argc, argv, "ecmult") || have_flag(argc, argv, "wnaf")) run_benchmark("ecmult_wnaf", bench_ecmult_wnaf, bench_setup, NULL, &data, 10, 20000);
+    if (have_flag(argc, argv, "ecmult") || have_flag(argc, argv, "gen")) run_benchmark("ecmult_gen", bench_ecmult_gen, bench_setup, NULL, &data, 10, 2000);
+    if (have_flag(argc, argv, "ecmult") || have_flag(argc, argv, "gen") || have_flag(argc, argv, "lanes")) run_benchmark("ecmult_gen_multi", bench_ecmult_gen_multi, bench_setup, NULL, &data, 10, 2000);
 
     if (have_flag(argc, argv, "hash") || have_flag(argc, argv, "sha256")) run_benchmark("hash_sha256", bench_sha256, bench_setup, NULL, &data, 10, 20000);
     if (have_flag(argc, argv, "hash") || have_flag(argc, argv, "hmac")) run_benchmark("hash_hmac_sha256", bench_hmac_sha256, bench_setup, NULL, &data, 10, 20000);
@@ -365,5 +435,6 @@ int main(int argc, char **argv) {
 #ifndef USE_NUM_NONE
     if (have_flag(argc, argv, "num") || have_flag(argc, argv, "jacobi")) run_benchmark("num_jacobi", bench_num_jacobi, bench_setup, NULL, &data, 10, 200000);
 #endif
+    secp256k1_context_destroy(data.ctx);
     return 0;
 }
@@ -18,8 +18,11 @@ typedef struct {
     size_t len;
     int min_bits;
     uint64_t v;
+    secp256k1_scratch_space *scratch;
 } bench_rangeproof_t;
 
+#define BATCH_SIZE 64
+
 static void bench_rangeproof_setup(void* arg) {
     int i;
     uint64_t minv;
@@ -49,6 +52,26 @@ static void bench_rangeproof(void* arg) {
     }
 }
 
+static void bench_rangeproof_batch(void* arg) {
+    int i;
+    size_t j;
+    bench_rangeproof_t *data = (bench_rangeproof_t*)arg;
+    const secp256k1_pedersen_commitment *commit[BATCH_SIZE];
+    const unsigned char *proof[BATCH_SIZE];
+    size_t plen[BATCH_SIZE];
+    const secp256k1_generator *gen[BATCH_SIZE];
+
+    for (j = 0; j < BATCH_SIZE; j++) {
+        commit[j] = &data->commit;
+        proof[j] = data->proof;
+        plen[j] = data->len;
+        gen[j] = secp256k1_generator_h;
+    }
+    for (i = 0; i < 1000 / BATCH_SIZE; i++) {
+        CHECK(secp256k1_rangeproof_verify_batch(data->ctx, data->scratch, NULL, NULL, NULL, commit, proof, plen, NULL, NULL, gen, BATCH_SIZE));
+    }
+}
+
 int main(void) {
     bench_rangeproof_t data;
 
@@ -56,7 +79,12 @@ int main(void) {
 
     data.min_bits = 32;
 
+    data.scratch = secp256k1_scratch_space_create(data.ctx, 4 * 1024 * 1024);
+
     run_benchmark("rangeproof_verify_bit", bench_rangeproof, bench_rangeproof_setup, NULL, &data, 10, 1000 * data.min_bits);
+    run_benchmark("rangeproof_verify_batch_bit", bench_rangeproof_batch, bench_rangeproof_setup, NULL, &data, 10, (1000 / BATCH_SIZE) * BATCH_SIZE * data.min_bits);
+
+    secp256k1_scratch_space_destroy(data.ctx, data.scratch);
 
     secp256k1_context_destroy(data.ctx);
     return 0;
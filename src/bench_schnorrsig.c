@@ -13,6 +13,10 @@
 #include "bench.h"
 
 #define MAX_SIGS	(32768)
+/* Number of signatures in the find_invalid and batch object benchmarks, and of planted
+ * invalid ones in the former */
+#define FIND_INVALID_SIGS	(1024)
+#define FIND_INVALID_BAD	(4)
 
 typedef struct {
     secp256k1_context *ctx;
@@ -21,6 +25,12 @@ typedef struct {
     const unsigned char **pk;
     const secp256k1_schnorrsig **sigs;
     const unsigned char **msgs;
+    secp256k1_keypair keypair;
+    const secp256k1_keypair **keypairs;
+    secp256k1_schnorrsig *batch_sigs;
+    const secp256k1_schnorrsig **bad_sigs;
+    const secp256k1_xonly_pubkey **xonly_pk;
+    int *results;
 } bench_schnorrsig_data;
 
 void bench_schnorrsig_sign(void* arg) {
@@ -39,6 +49,25 @@ void bench_schnorrsig_sign(void* arg) {
     }
 }
 
+void bench_schnorrsig_sign_keypair(void* arg) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+    size_t i;
+    unsigned char msg[32] = "benchmarkexamplemessagetemplate";
+    secp256k1_schnorrsig sig;
+
+    for (i = 0; i < 1000; i++) {
+        msg[0] = i;
+        msg[1] = i >> 8;
+        CHECK(secp256k1_schnorrsig_sign_keypair(data->ctx, &sig, msg, &data->keypair, NULL, NULL));
+    }
+}
+
+void bench_schnorrsig_sign_batch(void* arg) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+
+    CHECK(secp256k1_schnorrsig_sign_batch(data->ctx, data->batch_sigs, data->msgs, data->keypairs, 1000, NULL, NULL));
+}
+
 void bench_schnorrsig_verify(void* arg) {
     bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
     size_t i;
@@ -70,6 +99,46 @@ void bench_schnorrsig_verify_n(void* arg) {
     free(pk);
 }
 
+/* Verifies a batch with planted invalid signatures, and falls back to verifying every
+ * signature individually to find them. */
+void bench_schnorrsig_verify_fallback(void* arg) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+    size_t i;
+    int n_bad = 0;
+
+    CHECK(!secp256k1_schnorrsig_verify_batch(data->ctx, data->scratch, data->bad_sigs, data->msgs, data->xonly_pk, FIND_INVALID_SIGS));
+    for (i = 0; i < FIND_INVALID_SIGS; i++) {
+        data->results[i] = secp256k1_schnorrsig_verify(data->ctx, data->bad_sigs[i], data->msgs[i], data->xonly_pk[i]);
+        n_bad += !data->results[i];
+    }
+    CHECK(n_bad == FIND_INVALID_BAD);
+}
+
+void bench_schnorrsig_verify_find_invalid(void* arg) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+    size_t i;
+    int n_bad = 0;
+
+    CHECK(!secp256k1_schnorrsig_verify_batch_find_invalid(data->ctx, data->scratch, data->results, data->bad_sigs, data->msgs, data->xonly_pk, FIND_INVALID_SIGS));
+    for (i = 0; i < FIND_INVALID_SIGS; i++) {
+        n_bad += !data->results[i];
+    }
+    CHECK(n_bad == FIND_INVALID_BAD);
+}
+
+/* Adds the signatures to a secp256k1_batch one by one and verifies it */
+void bench_schnorrsig_batch_object(void* arg) {
+    bench_schnorrsig_data *data = (bench_schnorrsig_data *)arg;
+    secp256k1_batch *batch = secp256k1_batch_create(data->ctx, FIND_INVALID_SIGS);
+    size_t i;
+
+    for (i = 0; i < FIND_INVALID_SIGS; i++) {
+        CHECK(secp256k1_batch_add_schnorrsig(data->ctx, batch, data->sigs[i], data->msgs[i], data->xonly_pk[i]));
+    }
+    CHECK(secp256k1_batch_verify(data->ctx, data->scratch, batch));
+    secp256k1_batch_destroy(data->ctx, batch);
+}
+
 int main(void) {
     size_t i;
     bench_schnorrsig_data data;
@@ -79,6 +148,8 @@ int main(void) {
     data.pk = (const unsigned char **)malloc(MAX_SIGS * sizeof(unsigned char *));
     data.msgs = (const unsigned char **)malloc(MAX_SIGS * sizeof(unsigned char *));
     data.sigs = (const secp256k1_schnorrsig **)malloc(MAX_SIGS * sizeof(secp256k1_schnorrsig *));
+    data.keypairs = (const secp256k1_keypair **)malloc(1000 * sizeof(secp256k1_keypair *));
+    data.batch_sigs = (secp256k1_schnorrsig *)malloc(1000 * sizeof(secp256k1_schnorrsig));
 
     for (i = 0; i < MAX_SIGS; i++) {
         unsigned char sk[32];
@@ -102,8 +173,35 @@ int main(void) {
         CHECK(secp256k1_schnorrsig_sign(data.ctx, sig, msg, sk, NULL, NULL));
     }
 
+    data.bad_sigs = (const secp256k1_schnorrsig **)malloc(FIND_INVALID_SIGS * sizeof(secp256k1_schnorrsig *));
+    data.xonly_pk = (const secp256k1_xonly_pubkey **)malloc(FIND_INVALID_SIGS * sizeof(secp256k1_xonly_pubkey *));
+    data.results = (int *)malloc(FIND_INVALID_SIGS * sizeof(int));
+    for (i = 0; i < FIND_INVALID_SIGS; i++) {
+        secp256k1_xonly_pubkey *pk = (secp256k1_xonly_pubkey *)malloc(sizeof(*pk));
+        CHECK(secp256k1_xonly_pubkey_parse(data.ctx, pk, data.pk[i]) == 1);
+        data.xonly_pk[i] = pk;
+        data.bad_sigs[i] = data.sigs[i];
+    }
+    for (i = 0; i < FIND_INVALID_BAD; i++) {
+        secp256k1_schnorrsig *sig = (secp256k1_schnorrsig *)malloc(sizeof(*sig));
+        size_t idx = 97 + i * (FIND_INVALID_SIGS / FIND_INVALID_BAD);
+        *sig = *data.sigs[idx];
+        sig->data[63] ^= 1;
+        data.bad_sigs[idx] = sig;
+    }
+
+    CHECK(secp256k1_keypair_create(data.ctx, &data.keypair, (const unsigned char *) "benchmarkexample secrettemplate"));
+    for (i = 0; i < 1000; i++) {
+        data.keypairs[i] = &data.keypair;
+    }
+
     run_benchmark("schnorrsig_sign", bench_schnorrsig_sign, NULL, NULL, (void *) &data, 10, 1000);
+    run_benchmark("schnorrsig_sign_keypair", bench_schnorrsig_sign_keypair, NULL, NULL, (void *) &data, 10, 1000);
+    run_benchmark("schnorrsig_sign_batch", bench_schnorrsig_sign_batch, NULL, NULL, (void *) &data, 10, 1000);
     run_benchmark("schnorrsig_verify", bench_schnorrsig_verify, NULL, NULL, (void *) &data, 10, 1000);
+    run_benchmark("schnorrsig_verify_fallback", bench_schnorrsig_verify_fallback, NULL, NULL, (void *) &data, 3, FIND_INVALID_SIGS);
+    run_benchmark("schnorrsig_verify_find_invalid", bench_schnorrsig_verify_find_invalid, NULL, NULL, (void *) &data, 3, FIND_INVALID_SIGS);
+    run_benchmark("schnorrsig_batch_object", bench_schnorrsig_batch_object, NULL, NULL, (void *) &data, 3, FIND_INVALID_SIGS);
     for (i = 1; i <= MAX_SIGS; i *= 2) {
         char name[64];
         sprintf(name, "schnorrsig_batch_verify_%d", (int) i);
@@ -112,6 +210,15 @@ int main(void) {
         run_benchmark(name, bench_schnorrsig_verify_n, NULL, NULL, (void *) &data, 3, MAX_SIGS);
     }
 
+    for (i = 0; i < FIND_INVALID_SIGS; i++) {
+        if (data.bad_sigs[i] != data.sigs[i]) {
+            free((void *)data.bad_sigs[i]);
+        }
+        free((void *)data.xonly_pk[i]);
+    }
+    free(data.bad_sigs);
+    free(data.xonly_pk);
+    free(data.results);
     for (i = 0; i < MAX_SIGS; i++) {
         free((void *)data.pk[i]);
         free((void *)data.msgs[i]);
@@ -120,6 +227,8 @@ int main(void) {
     free(data.pk);
     free(data.msgs);
     free(data.sigs);
+    free(data.keypairs);
+    free(data.batch_sigs);
 
     secp256k1_scratch_space_destroy(data.ctx, data.scratch);
     secp256k1_context_destroy(data.ctx);
@@ -8,10 +8,17 @@
 #include "util.h"
 #include "bench.h"
 
+#define BATCH_KEYS 1000
+
 typedef struct {
     secp256k1_context* ctx;
     unsigned char msg[32];
     unsigned char key[32];
+    unsigned char batch_keys[BATCH_KEYS][32];
+    secp256k1_pubkey batch_pubkeys[BATCH_KEYS];
+    unsigned char batch_output[BATCH_KEYS][33];
+    const unsigned char *batch_msg_ptr[BATCH_KEYS];
+    secp256k1_ecdsa_signature batch_sigs[BATCH_KEYS];
 } bench_sign;
 
 static void bench_sign_setup(void* arg) {
@@ -44,12 +51,82 @@ static void bench_sign_run(void* arg) {
     }
 }
 
+static void bench_pubkey_setup(void* arg) {
+    int i, j;
+    bench_sign *data = (bench_sign*)arg;
+
+    for (i = 0; i < BATCH_KEYS; i++) {
+        for (j = 0; j < 32; j++) {
+            data->batch_keys[i][j] = j + 65;
+        }
+        data->batch_keys[i][0] = i;
+        data->batch_keys[i][1] = i >> 8;
+    }
+}
+
+static void bench_pubkey_create_run(void* arg) {
+    int i, j;
+    bench_sign *data = (bench_sign*)arg;
+
+    for (i = 0; i < 20000 / BATCH_KEYS; i++) {
+        for (j = 0; j < BATCH_KEYS; j++) {
+            size_t len = 33;
+            CHECK(secp256k1_ec_pubkey_create(data->ctx, &data->batch_pubkeys[j], data->batch_keys[j]));
+            CHECK(secp256k1_ec_pubkey_serialize(data->ctx, data->batch_output[j], &len, &data->batch_pubkeys[j], SECP256K1_EC_COMPRESSED));
+        }
+    }
+}
+
+static void bench_pubkey_create_batch_run(void* arg) {
+    int i;
+    bench_sign *data = (bench_sign*)arg;
+
+    for (i = 0; i < 20000 / BATCH_KEYS; i++) {
+        CHECK(secp256k1_ec_pubkey_create_batch(data->ctx, NULL, data->batch_pubkeys, data->batch_output[0], data->batch_keys[0], BATCH_KEYS));
+    }
+}
+
+static void bench_sign_batch_setup(void* arg) {
+    int i;
+    bench_sign *data = (bench_sign*)arg;
+
+    bench_sign_setup(arg);
+    bench_pubkey_setup(arg);
+    for (i = 0; i < BATCH_KEYS; i++) {
+        data->batch_msg_ptr[i] = data->batch_keys[i];
+    }
+}
+
+static void bench_sign_many_run(void* arg) {
+    int i, j;
+    bench_sign *data = (bench_sign*)arg;
+
+    for (i = 0; i < 20000 / BATCH_KEYS; i++) {
+        for (j = 0; j < BATCH_KEYS; j++) {
+            CHECK(secp256k1_ecdsa_sign(data->ctx, &data->batch_sigs[j], data->batch_msg_ptr[j], data->key, NULL, NULL));
+        }
+    }
+}
+
+static void bench_sign_batch_run(void* arg) {
+    int i;
+    bench_sign *data = (bench_sign*)arg;
+
+    for (i = 0; i < 20000 / BATCH_KEYS; i++) {
+        CHECK(secp256k1_ecdsa_sign_batch(data->ctx, data->batch_sigs, data->batch_msg_ptr, BATCH_KEYS, data->key, NULL, NULL));
+    }
+}
+
 int main(void) {
     bench_sign data;
 
     data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN);
 
     run_benchmark("ecdsa_sign", bench_sign_run, bench_sign_setup, NULL, &data, 10, 20000);
+    run_benchmark("ecdsa_sign_many", bench_sign_many_run, bench_sign_batch_setup, NULL, &data, 10, 20000);
+    run_benchmark("ecdsa_sign_batch", bench_sign_batch_run, bench_sign_batch_setup, NULL, &data, 10, 20000);
+    run_benchmark("ec_pubkey_create", bench_pubkey_create_run, bench_pubkey_setup, NULL, &data, 10, 20000);
+    run_benchmark("ec_pubkey_create_batch", bench_pubkey_create_batch_run, bench_pubkey_setup, NULL, &data, 10, 20000);
 
     secp256k1_context_destroy(data.ctx);
     return 0;
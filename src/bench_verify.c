@@ -8,9 +8,12 @@
 #include <string.h>
 
 #include "include/secp256k1.h"
+#include "include/secp256k1_preallocated.h"
 #include "util.h"
 #include "bench.h"
 
+#define BATCH_SIGS 1000
+
 #ifdef ENABLE_OPENSSL_TESTS
 #include <openssl/bn.h>
 #include <openssl/ecdsa.h>
@@ -25,6 +28,13 @@ typedef struct {
     size_t siglen;
     unsigned char pubkey[33];
     size_t pubkeylen;
+    unsigned char batch_msgs[BATCH_SIGS][32];
+    secp256k1_ecdsa_signature batch_sigs[BATCH_SIGS];
+    secp256k1_pubkey batch_pubkeys[BATCH_SIGS];
+    const unsigned char *batch_msg_ptrs[BATCH_SIGS];
+    const secp256k1_ecdsa_signature *batch_sig_ptrs[BATCH_SIGS];
+    const secp256k1_pubkey *batch_pubkey_ptrs[BATCH_SIGS];
+    int batch_results[BATCH_SIGS];
 #ifdef ENABLE_OPENSSL_TESTS
     EC_GROUP* ec_group;
 #endif
@@ -49,6 +59,26 @@ static void benchmark_verify(void* arg) {
     }
 }
 
+static void benchmark_verify_single(void* arg) {
+    int i, j;
+    benchmark_verify_t* data = (benchmark_verify_t*)arg;
+
+    for (i = 0; i < 20000 / BATCH_SIGS; i++) {
+        for (j = 0; j < BATCH_SIGS; j++) {
+            CHECK(secp256k1_ecdsa_verify(data->ctx, data->batch_sig_ptrs[j], data->batch_msg_ptrs[j], data->batch_pubkey_ptrs[j]) == 1);
+        }
+    }
+}
+
+static void benchmark_verify_batch(void* arg) {
+    int i;
+    benchmark_verify_t* data = (benchmark_verify_t*)arg;
+
+    for (i = 0; i < 20000 / BATCH_SIGS; i++) {
+        CHECK(secp256k1_ecdsa_verify_batch(data->ctx, data->batch_results, data->batch_sig_ptrs, data->batch_msg_ptrs, data->batch_pubkey_ptrs, BATCH_SIGS) == 1);
+    }
+}
+
 #ifdef ENABLE_OPENSSL_TESTS
 static void benchmark_verify_openssl(void* arg) {
     int i;
@@ -79,6 +109,25 @@ static void benchmark_verify_openssl(void* arg) {
 }
 #endif
 
+/* Runs benchmark_verify with contexts whose table of multiples of G is built
+ * for a range of window sizes. */
+static void benchmark_verify_windows(benchmark_verify_t* data) {
+    secp256k1_context *ctx = data->ctx;
+    unsigned int window;
+    char name[32];
+
+    for (window = 4; window <= 20; window += 2) {
+        void *prealloc = malloc(secp256k1_context_preallocated_size_with_window(SECP256K1_CONTEXT_VERIFY, window));
+        CHECK(prealloc != NULL);
+        data->ctx = secp256k1_context_preallocated_create_with_window(prealloc, SECP256K1_CONTEXT_VERIFY, window);
+        sprintf(name, "ecdsa_verify_window_%u", window);
+        run_benchmark(name, benchmark_verify, NULL, NULL, data, 3, 20000);
+        secp256k1_context_preallocated_destroy(data->ctx);
+        free(prealloc);
+    }
+    data->ctx = ctx;
+}
+
 int main(void) {
     int i;
     secp256k1_pubkey pubkey;
@@ -100,7 +149,23 @@ int main(void) {
     data.pubkeylen = 33;
     CHECK(secp256k1_ec_pubkey_serialize(data.ctx, data.pubkey, &data.pubkeylen, &pubkey, SECP256K1_EC_COMPRESSED) == 1);
 
+    for (i = 0; i < BATCH_SIGS; i++) {
+        memcpy(data.batch_msgs[i], data.msg, 32);
+        data.batch_msgs[i][0] = i;
+        data.batch_msgs[i][1] = i >> 8;
+        data.key[0] = i;
+        data.key[1] = i >> 8;
+        CHECK(secp256k1_ecdsa_sign(data.ctx, &data.batch_sigs[i], data.batch_msgs[i], data.key, NULL, NULL));
+        CHECK(secp256k1_ec_pubkey_create(data.ctx, &data.batch_pubkeys[i], data.key));
+        data.batch_msg_ptrs[i] = data.batch_msgs[i];
+        data.batch_sig_ptrs[i] = &data.batch_sigs[i];
+        data.batch_pubkey_ptrs[i] = &data.batch_pubkeys[i];
+    }
+
     run_benchmark("ecdsa_verify", benchmark_verify, NULL, NULL, &data, 10, 20000);
+    run_benchmark("ecdsa_verify_single", benchmark_verify_single, NULL, NULL, &data, 10, 20000);
+    run_benchmark("ecdsa_verify_batch", benchmark_verify_batch, NULL, NULL, &data, 10, 20000);
+    benchmark_verify_windows(&data);
 #ifdef ENABLE_OPENSSL_TESTS
     data.ec_group = EC_GROUP_new_by_curve_name(NID_secp256k1);
     run_benchmark("ecdsa_verify_openssl", benchmark_verify_openssl, NULL, NULL, &data, 10, 20000);
@@ -16,6 +16,11 @@
 static int secp256k1_ecdsa_sig_parse(secp256k1_scalar *r, secp256k1_scalar *s, const unsigned char *sig, size_t size);
 static int secp256k1_ecdsa_sig_serialize(unsigned char *sig, size_t *size, const secp256k1_scalar *r, const secp256k1_scalar *s);
 static int secp256k1_ecdsa_sig_verify(const secp256k1_ecmult_context *ctx, const secp256k1_scalar* r, const secp256k1_scalar* s, const secp256k1_ge *pubkey, const secp256k1_scalar *message);
+/** Like secp256k1_ecdsa_sig_verify, but takes the inverse of a nonzero s instead of s itself. */
+static int secp256k1_ecdsa_sig_verify_sinv(const secp256k1_ecmult_context *ctx, const secp256k1_scalar* r, const secp256k1_scalar* sinv, const secp256k1_ge *pubkey, const secp256k1_scalar *message);
 static int secp256k1_ecdsa_sig_sign(const secp256k1_ecmult_gen_context *ctx, secp256k1_scalar* r, secp256k1_scalar* s, const secp256k1_scalar *seckey, const secp256k1_scalar *message, const secp256k1_scalar *nonce, int *recid);
+/** Like secp256k1_ecdsa_sig_sign, but takes the nonce point rp = nonce*G (which cannot be
+ *  infinity) and the inverse of the nonce instead of the nonce itself. */
+static int secp256k1_ecdsa_sig_sign_finish(secp256k1_scalar* r, secp256k1_scalar* s, const secp256k1_ge *rp, const secp256k1_scalar *seckey, const secp256k1_scalar *message, const secp256k1_scalar *noncei, int *recid);
 
 #endif /* SECP256K1_ECDSA_H */
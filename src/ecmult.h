@@ -18,11 +18,13 @@ typedef struct {
 #ifdef USE_ENDOMORPHISM
     secp256k1_ge_storage (*pre_g_128)[]; /* odd multiples of 2^128*generator */
 #endif
+    int window_g; /* window size of the tables above */
 } secp256k1_ecmult_context;
 
-static const size_t SECP256K1_ECMULT_CONTEXT_PREALLOCATED_SIZE;
+/** Memory needed by secp256k1_ecmult_context_build for tables of the given window size. */
+static size_t secp256k1_ecmult_context_prealloc_size(int window_g);
 static void secp256k1_ecmult_context_init(secp256k1_ecmult_context *ctx);
-static void secp256k1_ecmult_context_build(secp256k1_ecmult_context *ctx, void **prealloc);
+static void secp256k1_ecmult_context_build(secp256k1_ecmult_context *ctx, int window_g, void **prealloc);
 static void secp256k1_ecmult_context_finalize_memcpy(secp256k1_ecmult_context *dst, const secp256k1_ecmult_context *src);
 static void secp256k1_ecmult_context_clear(secp256k1_ecmult_context *ctx);
 static int secp256k1_ecmult_context_is_built(const secp256k1_ecmult_context *ctx);
@@ -32,6 +34,27 @@ static void secp256k1_ecmult(const secp256k1_ecmult_context *ctx, secp256k1_gej
 
 typedef int (secp256k1_ecmult_multi_callback)(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data);
 
+/** Window size of precomputed point tables. A table holds the odd multiples
+ *  1*P, 3*P, ..., (2^(ECMULT_POINT_TABLE_WINDOW-1)-1)*P as
+ *  ECMULT_POINT_TABLE_SIZE serialized secp256k1_ge_storage entries. */
+#define ECMULT_POINT_TABLE_WINDOW 8
+#define ECMULT_POINT_TABLE_SIZE (1 << (ECMULT_POINT_TABLE_WINDOW - 2))
+
+/** Fill table (ECMULT_POINT_TABLE_SIZE * sizeof(secp256k1_ge_storage) bytes,
+ *  no alignment requirement) with the odd multiples of p. p must not be
+ *  infinity. */
+static void secp256k1_ecmult_point_table(unsigned char *table, const secp256k1_ge *p);
+
+typedef int (secp256k1_ecmult_multi_table_callback)(secp256k1_scalar *sc, const unsigned char **table, size_t idx, void *data);
+
+/**
+ * Multi-multiply with precomputed tables: R = inp_g_sc * G + sum_i ni * Ai,
+ * where the callback provides ni and the table for Ai created by
+ * secp256k1_ecmult_point_table. Does not need a scratch space.
+ * Returns: 1 on success, 0 if the callback returns 0
+ */
+static int secp256k1_ecmult_multi_table_var(const secp256k1_ecmult_context *ctx, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_table_callback cb, void *cbdata, size_t n);
+
 /**
  * Multi-multiply: R = inp_g_sc * G + sum_i ni * Ai.
  * Chooses the right algorithm for a given number of points and scratch space
@@ -45,4 +68,16 @@ typedef int (secp256k1_ecmult_multi_callback)(secp256k1_scalar *sc, secp256k1_ge
  */
 static int secp256k1_ecmult_multi_var(const secp256k1_callback* error_callback, const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n);
 
+/**
+ * Multi-multiply split into up to n_scratch independent tasks which are run
+ * through parallel_for. Each task computes ecmult_multi_var on a contiguous
+ * slice of the points using its own scratch space scratch[i], and the partial
+ * results are added up at the end. cb must be safe to call concurrently for
+ * distinct idx. If parallel_for is NULL the tasks are run one after another.
+ * A small amount of memory for the partial results is taken from scratch[0];
+ * if that fails this falls back to ecmult_multi_var on scratch[0].
+ * Returns: the same as ecmult_multi_var.
+ */
+static int secp256k1_ecmult_multi_var_parallel(const secp256k1_callback* error_callback, const secp256k1_ecmult_context *ctx, secp256k1_scratch *const *scratch, size_t n_scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n, secp256k1_parallel_for_function parallel_for, void *parallel_data);
+
 #endif /* SECP256K1_ECMULT_H */
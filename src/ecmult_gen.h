@@ -10,22 +10,89 @@
 #include "scalar.h"
 #include "group.h"
 
+/* Configuration parameters for the signed-digit multi-comb algorithm:
+ *
+ * - COMB_BLOCKS is the number of blocks the input is split into. Each
+ *   has a corresponding table.
+ * - COMB_TEETH is the number of bits simultaneously covered by one table.
+ * - COMB_RANGE is the number of bits in supported scalars. For production
+ *   purposes, only 256 is reasonable, but smaller numbers are supported for
+ *   exhaustive test mode.
+ *
+ * The comb's spacing (COMB_SPACING), or the distance between the teeth,
+ * is defined as ceil(COMB_RANGE / (COMB_BLOCKS * COMB_TEETH)). Each block covers
+ * COMB_SPACING * COMB_TEETH consecutive bits in the input.
+ *
+ * The size of the precomputed table is COMB_BLOCKS * (1 << (COMB_TEETH - 1))
+ * secp256k1_ge_storages.
+ *
+ * The number of point additions equals COMB_BLOCKS * COMB_SPACING. Each point
+ * addition involves a cmov from (1 << (COMB_TEETH - 1)) table entries and a
+ * conditional negation.
+ *
+ * The number of point doublings is COMB_SPACING - 1.
+ */
+#if defined(EXHAUSTIVE_TEST_ORDER)
+/* The table must not contain the point at infinity (secp256k1_ge_storage cannot
+ * represent it), which fixes the layout for the small test groups. */
+#  undef ECMULT_GEN_COMB_BLOCKS
+#  undef ECMULT_GEN_COMB_TEETH
+#  if EXHAUSTIVE_TEST_ORDER == 13
+#    define COMB_RANGE 4
+#    define ECMULT_GEN_COMB_BLOCKS 1
+#    define ECMULT_GEN_COMB_TEETH 2
+#  elif EXHAUSTIVE_TEST_ORDER == 199
+#    define COMB_RANGE 8
+#    define ECMULT_GEN_COMB_BLOCKS 2
+#    define ECMULT_GEN_COMB_TEETH 3
+#  else
+#    error No known comb layout for the specified exhaustive test group order.
+#  endif
+#else
+#  define COMB_RANGE 256
+#endif
+
+#ifndef ECMULT_GEN_COMB_BLOCKS
+#  define ECMULT_GEN_COMB_BLOCKS 11
+#endif
+#ifndef ECMULT_GEN_COMB_TEETH
+#  define ECMULT_GEN_COMB_TEETH 6
+#endif
+
+#define COMB_BLOCKS ECMULT_GEN_COMB_BLOCKS
+#define COMB_TEETH ECMULT_GEN_COMB_TEETH
+
+#if COMB_BLOCKS < 1 || COMB_BLOCKS > 256
+#  error Set ECMULT_GEN_COMB_BLOCKS to an integer in range [1..256].
+#endif
+#if COMB_TEETH < 1 || COMB_TEETH > 8
+#  error Set ECMULT_GEN_COMB_TEETH to an integer in range [1..8].
+#endif
+
+#define COMB_SPACING ((COMB_RANGE + COMB_BLOCKS * COMB_TEETH - 1) / (COMB_BLOCKS * COMB_TEETH))
+#define COMB_BITS (COMB_BLOCKS * COMB_TEETH * COMB_SPACING)
+#define COMB_POINTS (1 << (COMB_TEETH - 1))
+
 typedef struct {
     /* For accelerating the computation of a*G:
      * To harden against timing attacks, use the following mechanism:
-     * * Break up the multiplicand into groups of 4 bits, called n_0, n_1, n_2, ..., n_63.
-     * * Compute sum(n_i * 16^i * G + U_i, i=0..63), where:
-     *   * U_i = U * 2^i (for i=0..62)
-     *   * U_i = U * (1-2^63) (for i=63)
-     *   where U is a point with no known corresponding scalar. Note that sum(U_i, i=0..63) = 0.
-     * For each i, and each of the 16 possible values of n_i, (n_i * 16^i * G + U_i) is
-     * precomputed (call it prec(i, n_i)). The formula now becomes sum(prec(i, n_i), i=0..63).
-     * None of the resulting prec group elements have a known scalar, and neither do any of
-     * the intermediate sums while computing a*G.
+     * * Compute d = a + scalar_offset and split its COMB_BITS bits (d_0 up to
+     *   d_{COMB_BITS-1}) over the teeth of COMB_BLOCKS combs.
+     * * Every bit contributes (2*d_i - 1) * 2^(i-1) * G, so every bit adds or
+     *   subtracts a point and no table entry is the point at infinity. The sum
+     *   of all contributions is (d - (2^COMB_BITS - 1)/2) * G.
+     * * prec[b][m] holds the sum of the contributions of the teeth of block b
+     *   for the bit pattern m of the lower COMB_TEETH - 1 teeth with the top
+     *   tooth clear; patterns with the top tooth set are the negations of these.
+     * * scalar_offset = (2^COMB_BITS - 1)/2 - b and ge_offset = b*G for a random
+     *   blinding value b, so the result is (a - b)*G + b*G = a*G.
+     * * The first table lookup is additionally rescaled by proj_blind to
+     *   randomize the projective coordinates of all intermediate results.
      */
-    secp256k1_ge_storage (*prec)[64][16]; /* prec[j][i] = 16^j * i * G + U_i */
-    secp256k1_scalar blind;
-    secp256k1_gej initial;
+    secp256k1_ge_storage (*prec)[COMB_BLOCKS][COMB_POINTS];
+    secp256k1_scalar scalar_offset;
+    secp256k1_ge ge_offset;
+    secp256k1_fe proj_blind;
 } secp256k1_ecmult_gen_context;
 
 static const size_t SECP256K1_ECMULT_GEN_CONTEXT_PREALLOCATED_SIZE;
@@ -38,6 +105,11 @@ static int secp256k1_ecmult_gen_context_is_built(const secp256k1_ecmult_gen_cont
 /** Multiply with the generator: R = a*G */
 static void secp256k1_ecmult_gen(const secp256k1_ecmult_gen_context* ctx, secp256k1_gej *r, const secp256k1_scalar *a);
 
+/** Multiply n scalars with the generator: r[i] = a[i]*G. This is faster than n calls to
+ *  secp256k1_ecmult_gen if secp256k1_fe_lanes_accelerated, and has the same side channel
+ *  resistance. */
+static void secp256k1_ecmult_gen_multi(const secp256k1_ecmult_gen_context* ctx, secp256k1_gej *r, const secp256k1_scalar *a, size_t n);
+
 static void secp256k1_ecmult_gen_blind(secp256k1_ecmult_gen_context *ctx, const unsigned char *seed32);
 
 #endif /* SECP256K1_ECMULT_GEN_H */
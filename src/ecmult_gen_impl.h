@@ -10,10 +10,14 @@
 #include "util.h"
 #include "scalar.h"
 #include "group.h"
+#include "group_lanes_impl.h"
 #include "ecmult_gen.h"
 #include "hash_impl.h"
 #ifdef USE_ECMULT_STATIC_PRECOMPUTATION
 #include "ecmult_static_context.h"
+#if SECP256K1_ECMULT_STATIC_CONTEXT_BLOCKS != COMB_BLOCKS || SECP256K1_ECMULT_STATIC_CONTEXT_TEETH != COMB_TEETH
+#  error ecmult_static_context.h was generated for a different comb layout
+#endif
 #endif
 
 #ifndef USE_ECMULT_STATIC_PRECOMPUTATION
@@ -22,16 +26,111 @@
     static const size_t SECP256K1_ECMULT_GEN_CONTEXT_PREALLOCATED_SIZE = 0;
 #endif
 
+/* Compute the comb table for the generator gen with the given layout. The table
+ * holds blocks * 2^(teeth-1) entries, stored block by block, where entry m of
+ * block b is the sum of (2*bit - 1) * 2^((b*teeth + t)*spacing) * gen/2 over the
+ * teeth t, with bit taken from m for the lower teeth and 0 for the top tooth.
+ * The layout is passed at runtime so that gen_context can generate tables for
+ * any configuration. */
+static void secp256k1_ecmult_gen_compute_table(secp256k1_ge_storage *table, const secp256k1_ge *gen, int blocks, int teeth, int spacing) {
+    secp256k1_gej vs[1 << 7]; /* Jacobian versions of the entries of one block. */
+    secp256k1_ge prec[1 << 7];
+    secp256k1_gej ds[8];
+    secp256k1_gej u;
+    secp256k1_scalar two, half;
+    int points = 1 << (teeth - 1);
+    int block, tooth, i;
+
+    VERIFY_CHECK(teeth >= 1 && teeth <= 8);
+
+    /* u is the running power of two times gen we're working with, initially gen/2.
+     * A simple double-and-add ladder avoids depending on ecmult. */
+    secp256k1_scalar_set_int(&two, 2);
+    secp256k1_scalar_inverse(&half, &two);
+    secp256k1_gej_set_infinity(&u);
+    for (i = 255; i >= 0; i--) {
+        secp256k1_gej_double_var(&u, &u, NULL);
+        if (secp256k1_scalar_get_bits(&half, i, 1)) {
+            secp256k1_gej_add_ge_var(&u, &u, gen, NULL);
+        }
+    }
+
+    for (block = 0; block < blocks; block++) {
+        secp256k1_gej sum;
+        secp256k1_gej_set_infinity(&sum);
+        for (tooth = 0; tooth < teeth; tooth++) {
+            /* Here u = 2^((block*teeth + tooth)*spacing) * gen/2. */
+            secp256k1_gej_add_var(&sum, &sum, &u, NULL);
+            /* ds[tooth] = 2^((block*teeth + tooth)*spacing) * gen is the difference
+             * between the tooth's bit being set and clear. */
+            secp256k1_gej_double_var(&u, &u, NULL);
+            ds[tooth] = u;
+            for (i = 1; i < spacing; i++) {
+                secp256k1_gej_double_var(&u, &u, NULL);
+            }
+        }
+
+        /* Start with all teeth clear, then double the number of entries teeth-1
+         * times by setting the next tooth in all entries computed so far. */
+        secp256k1_gej_neg(&vs[0], &sum);
+        for (tooth = 0; tooth < teeth - 1; tooth++) {
+            int stride = 1 << tooth;
+            for (i = 0; i < stride; i++) {
+                secp256k1_gej_add_var(&vs[stride + i], &vs[i], &ds[tooth], NULL);
+            }
+        }
+
+        secp256k1_ge_set_all_gej_var(prec, vs, points);
+        for (i = 0; i < points; i++) {
+            VERIFY_CHECK(!secp256k1_ge_is_infinity(&prec[i]));
+            secp256k1_ge_to_storage(&table[block * points + i], &prec[i]);
+        }
+    }
+}
+
+/* Check that the first entry of a comb table for gen with the given layout is
+ * -(sum of 2^(t*spacing) over the teeth t) * gen/2, as computed by
+ * secp256k1_ecmult_gen_compute_table. This catches tables written with a
+ * different representation of field elements. */
+static int secp256k1_ecmult_gen_table_check(const secp256k1_ge_storage *table, const secp256k1_ge *gen, int teeth, int spacing) {
+    secp256k1_scalar k, pow, two, half;
+    secp256k1_gej r;
+    secp256k1_ge expected, entry;
+    int tooth, i;
+
+    secp256k1_scalar_set_int(&two, 2);
+    secp256k1_scalar_inverse_var(&half, &two);
+    secp256k1_scalar_set_int(&k, 0);
+    secp256k1_scalar_set_int(&pow, 1);
+    for (tooth = 0; tooth < teeth; tooth++) {
+        secp256k1_scalar_add(&k, &k, &pow);
+        for (i = 0; i < spacing; i++) {
+            secp256k1_scalar_add(&pow, &pow, &pow);
+        }
+    }
+    secp256k1_scalar_mul(&k, &k, &half);
+    secp256k1_scalar_negate(&k, &k);
+
+    secp256k1_gej_set_infinity(&r);
+    for (i = 255; i >= 0; i--) {
+        secp256k1_gej_double_var(&r, &r, NULL);
+        if (secp256k1_scalar_get_bits(&k, i, 1)) {
+            secp256k1_gej_add_ge_var(&r, &r, gen, NULL);
+        }
+    }
+    secp256k1_ge_set_gej_var(&expected, &r);
+    secp256k1_ge_from_storage(&entry, &table[0]);
+    return !secp256k1_ge_is_infinity(&expected)
+        && secp256k1_fe_equal_var(&entry.x, &expected.x)
+        && secp256k1_fe_equal_var(&entry.y, &expected.y);
+}
+
 static void secp256k1_ecmult_gen_context_init(secp256k1_ecmult_gen_context *ctx) {
     ctx->prec = NULL;
 }
 
 static void secp256k1_ecmult_gen_context_build(secp256k1_ecmult_gen_context *ctx, void **prealloc) {
 #ifndef USE_ECMULT_STATIC_PRECOMPUTATION
-    secp256k1_ge prec[1024];
-    secp256k1_gej gj;
-    secp256k1_gej nums_gej;
-    int i, j;
     size_t const prealloc_size = SECP256K1_ECMULT_GEN_CONTEXT_PREALLOCATED_SIZE;
     void* const base = *prealloc;
 #endif
@@ -40,63 +139,11 @@ static void secp256k1_ecmult_gen_context_build(secp256k1_ecmult_gen_context *ctx
         return;
     }
 #ifndef USE_ECMULT_STATIC_PRECOMPUTATION
-    ctx->prec = (secp256k1_ge_storage (*)[64][16])manual_alloc(prealloc, prealloc_size, base, prealloc_size);
-
-    /* get the generator */
-    secp256k1_gej_set_ge(&gj, &secp256k1_ge_const_g);
-
-    /* Construct a group element with no known corresponding scalar (nothing up my sleeve). */
-    {
-        static const unsigned char nums_b32[33] = "The scalar for this x is unknown";
-        secp256k1_fe nums_x;
-        secp256k1_ge nums_ge;
-        int r;
-        r = secp256k1_fe_set_b32(&nums_x, nums_b32);
-        (void)r;
-        VERIFY_CHECK(r);
-        r = secp256k1_ge_set_xo_var(&nums_ge, &nums_x, 0);
-        (void)r;
-        VERIFY_CHECK(r);
-        secp256k1_gej_set_ge(&nums_gej, &nums_ge);
-        /* Add G to make the bits in x uniformly distributed. */
-        secp256k1_gej_add_ge_var(&nums_gej, &nums_gej, &secp256k1_ge_const_g, NULL);
-    }
-
-    /* compute prec. */
-    {
-        secp256k1_gej precj[1024]; /* Jacobian versions of prec. */
-        secp256k1_gej gbase;
-        secp256k1_gej numsbase;
-        gbase = gj; /* 16^j * G */
-        numsbase = nums_gej; /* 2^j * nums. */
-        for (j = 0; j < 64; j++) {
-            /* Set precj[j*16 .. j*16+15] to (numsbase, numsbase + gbase, ..., numsbase + 15*gbase). */
-            precj[j*16] = numsbase;
-            for (i = 1; i < 16; i++) {
-                secp256k1_gej_add_var(&precj[j*16 + i], &precj[j*16 + i - 1], &gbase, NULL);
-            }
-            /* Multiply gbase by 16. */
-            for (i = 0; i < 4; i++) {
-                secp256k1_gej_double_var(&gbase, &gbase, NULL);
-            }
-            /* Multiply numbase by 2. */
-            secp256k1_gej_double_var(&numsbase, &numsbase, NULL);
-            if (j == 62) {
-                /* In the last iteration, numsbase is (1 - 2^j) * nums instead. */
-                secp256k1_gej_neg(&numsbase, &numsbase);
-                secp256k1_gej_add_var(&numsbase, &numsbase, &nums_gej, NULL);
-            }
-        }
-        secp256k1_ge_set_all_gej_var(prec, precj, 1024);
-    }
-    for (j = 0; j < 64; j++) {
-        for (i = 0; i < 16; i++) {
-            secp256k1_ge_to_storage(&(*ctx->prec)[j][i], &prec[j*16 + i]);
-        }
-    }
+    ctx->prec = (secp256k1_ge_storage (*)[COMB_BLOCKS][COMB_POINTS])manual_alloc(prealloc, prealloc_size, base, prealloc_size);
+    secp256k1_ecmult_gen_compute_table(&(*ctx->prec)[0][0], &secp256k1_ge_const_g, COMB_BLOCKS, COMB_TEETH, COMB_SPACING);
 #else
     (void)prealloc;
-    ctx->prec = (secp256k1_ge_storage (*)[64][16])secp256k1_ecmult_static_context;
+    ctx->prec = (secp256k1_ge_storage (*)[COMB_BLOCKS][COMB_POINTS])secp256k1_ecmult_static_context;
 #endif
     secp256k1_ecmult_gen_blind(ctx, NULL);
 }
@@ -109,7 +156,7 @@ static void secp256k1_ecmult_gen_context_finalize_memcpy(secp256k1_ecmult_gen_co
 #ifndef USE_ECMULT_STATIC_PRECOMPUTATION
     if (src->prec != NULL) {
         /* We cast to void* first to suppress a -Wcast-align warning. */
-        dst->prec = (secp256k1_ge_storage (*)[64][16])(void*)((unsigned char*)dst + ((unsigned char*)src->prec - (unsigned char*)src));
+        dst->prec = (secp256k1_ge_storage (*)[COMB_BLOCKS][COMB_POINTS])(void*)((unsigned char*)dst + ((unsigned char*)src->prec - (unsigned char*)src));
     }
 #else
     (void)dst, (void)src;
@@ -117,62 +164,240 @@ static void secp256k1_ecmult_gen_context_finalize_memcpy(secp256k1_ecmult_gen_co
 }
 
 static void secp256k1_ecmult_gen_context_clear(secp256k1_ecmult_gen_context *ctx) {
-    secp256k1_scalar_clear(&ctx->blind);
-    secp256k1_gej_clear(&ctx->initial);
+    secp256k1_scalar_clear(&ctx->scalar_offset);
+    secp256k1_ge_clear(&ctx->ge_offset);
+    secp256k1_fe_clear(&ctx->proj_blind);
     ctx->prec = NULL;
 }
 
 static void secp256k1_ecmult_gen(const secp256k1_ecmult_gen_context *ctx, secp256k1_gej *r, const secp256k1_scalar *gn) {
     secp256k1_ge add;
     secp256k1_ge_storage adds;
-    secp256k1_scalar gnb;
-    int bits;
-    int i, j;
+    secp256k1_fe neg;
+    secp256k1_scalar d;
+    unsigned char d32[32];
+    uint32_t recoded[(COMB_BITS + 31) >> 5] = {0};
+    uint32_t bits, sign, idx;
+    int first = 1;
+    int comb_off, block, tooth, bit_pos, i;
+
     memset(&adds, 0, sizeof(adds));
-    *r = ctx->initial;
-    /* Blind scalar/point multiplication by computing (n-b)G + bG instead of nG. */
-    secp256k1_scalar_add(&gnb, gn, &ctx->blind);
-    add.infinity = 0;
-    for (j = 0; j < 64; j++) {
-        bits = secp256k1_scalar_get_bits(&gnb, j * 4, 4);
-        for (i = 0; i < 16; i++) {
-            /** This uses a conditional move to avoid any secret data in array indexes.
-             *   _Any_ use of secret indexes has been demonstrated to result in timing
-             *   sidechannels, even when the cache-line access patterns are uniform.
-             *  See also:
-             *   "A word of warning", CHES 2013 Rump Session, by Daniel J. Bernstein and Peter Schwabe
-             *    (https://cryptojedi.org/peter/data/chesrump-20130822.pdf) and
-             *   "Cache Attacks and Countermeasures: the Case of AES", RSA 2006,
-             *    by Dag Arne Osvik, Adi Shamir, and Eran Tromer
-             *    (http://www.tau.ac.il/~tromer/papers/cache.pdf)
-             */
-            secp256k1_ge_storage_cmov(&adds, &(*ctx->prec)[j][i], i == bits);
+    /* Blind scalar/point multiplication by computing (d - (2^COMB_BITS - 1)/2)*G + b*G
+     * with d = gn + scalar_offset. */
+    secp256k1_scalar_add(&d, gn, &ctx->scalar_offset);
+    secp256k1_scalar_get_b32(d32, &d);
+    for (i = 0; i < 8 && i < (int)(sizeof(recoded) / sizeof(recoded[0])); i++) {
+        recoded[i] = (uint32_t)d32[31 - 4*i] | (uint32_t)d32[30 - 4*i] << 8 | (uint32_t)d32[29 - 4*i] << 16 | (uint32_t)d32[28 - 4*i] << 24;
+    }
+
+    for (comb_off = COMB_SPACING - 1; comb_off >= 0; comb_off--) {
+        bit_pos = comb_off;
+        for (block = 0; block < COMB_BLOCKS; block++) {
+            /* Gather the bits of d selected by the teeth of this block. */
+            bits = 0;
+            for (tooth = 0; tooth < COMB_TEETH; tooth++) {
+                bits |= ((recoded[bit_pos >> 5] >> (bit_pos & 0x1f)) & 1) << tooth;
+                bit_pos += COMB_SPACING;
+            }
+            /* If the top tooth is set, look up the entry for the complemented bits
+             * and negate it. */
+            sign = (bits >> (COMB_TEETH - 1)) & 1;
+            idx = (bits ^ -sign) & (COMB_POINTS - 1);
+
+            for (i = 0; i < COMB_POINTS; i++) {
+                /** This uses a conditional move to avoid any secret data in array indexes.
+                 *   _Any_ use of secret indexes has been demonstrated to result in timing
+                 *   sidechannels, even when the cache-line access patterns are uniform.
+                 *  See also:
+                 *   "A word of warning", CHES 2013 Rump Session, by Daniel J. Bernstein and Peter Schwabe
+                 *    (https://cryptojedi.org/peter/data/chesrump-20130822.pdf) and
+                 *   "Cache Attacks and Countermeasures: the Case of AES", RSA 2006,
+                 *    by Dag Arne Osvik, Adi Shamir, and Eran Tromer
+                 *    (http://www.tau.ac.il/~tromer/papers/cache.pdf)
+                 */
+                secp256k1_ge_storage_cmov(&adds, &(*ctx->prec)[block][i], (uint32_t)i == idx);
+            }
+            secp256k1_ge_from_storage(&add, &adds);
+            secp256k1_fe_negate(&neg, &add.y, 1);
+            secp256k1_fe_cmov(&add.y, &neg, sign);
+
+            if (first) {
+                /* Randomize the projection of the first entry to defend against
+                 * multiplier sidechannels. */
+                secp256k1_gej_set_ge(r, &add);
+                secp256k1_gej_rescale(r, &ctx->proj_blind);
+                first = 0;
+            } else {
+                secp256k1_gej_add_ge(r, r, &add);
+            }
+        }
+        if (comb_off > 0) {
+            secp256k1_gej_double(r, r);
         }
-        secp256k1_ge_from_storage(&add, &adds);
-        secp256k1_gej_add_ge(r, r, &add);
     }
-    bits = 0;
+    secp256k1_gej_add_ge(r, r, &ctx->ge_offset);
+
+    bits = sign = idx = 0;
+    memset(recoded, 0, sizeof(recoded));
+    memset(d32, 0, sizeof(d32));
     secp256k1_ge_clear(&add);
-    secp256k1_scalar_clear(&gnb);
+    secp256k1_fe_clear(&neg);
+    secp256k1_scalar_clear(&d);
+}
+
+/* Compute r[l] = gn[l]*G for all l < SECP256K1_FE_LANES, running the blinded comb of
+ * secp256k1_ecmult_gen on every lane at once. */
+static void secp256k1_ecmult_gen_lanes_inner(const secp256k1_ecmult_gen_context *ctx, secp256k1_gej *r, const secp256k1_scalar *gn) {
+    secp256k1_gej_lanes acc;
+    secp256k1_ge_lanes add, offset;
+    secp256k1_fe_lanes neg, blind;
+    secp256k1_scalar d;
+    unsigned char d32[32];
+    uint32_t recoded[SECP256K1_FE_LANES][(COMB_BITS + 31) >> 5];
+    uint32_t bits, idx[SECP256K1_FE_LANES];
+    int sign[SECP256K1_FE_LANES];
+    int first = 1;
+    int comb_off, block, tooth, bit_pos, pos, i, l;
+
+    memset(recoded, 0, sizeof(recoded));
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        secp256k1_scalar_add(&d, &gn[l], &ctx->scalar_offset);
+        secp256k1_scalar_get_b32(d32, &d);
+        for (i = 0; i < 8 && i < (int)(sizeof(recoded[l]) / sizeof(recoded[l][0])); i++) {
+            recoded[l][i] = (uint32_t)d32[31 - 4*i] | (uint32_t)d32[30 - 4*i] << 8 | (uint32_t)d32[29 - 4*i] << 16 | (uint32_t)d32[28 - 4*i] << 24;
+        }
+        secp256k1_ge_lanes_set_ge(&offset, l, &ctx->ge_offset);
+    }
+    secp256k1_fe_lanes_set_all(&blind, &ctx->proj_blind);
+
+    for (comb_off = COMB_SPACING - 1; comb_off >= 0; comb_off--) {
+        bit_pos = comb_off;
+        for (block = 0; block < COMB_BLOCKS; block++) {
+            for (l = 0; l < SECP256K1_FE_LANES; l++) {
+                bits = 0;
+                pos = bit_pos;
+                for (tooth = 0; tooth < COMB_TEETH; tooth++) {
+                    bits |= ((recoded[l][pos >> 5] >> (pos & 0x1f)) & 1) << tooth;
+                    pos += COMB_SPACING;
+                }
+                sign[l] = (bits >> (COMB_TEETH - 1)) & 1;
+                idx[l] = (bits ^ -(uint32_t)sign[l]) & (COMB_POINTS - 1);
+            }
+            bit_pos += COMB_TEETH * COMB_SPACING;
+            secp256k1_ge_lanes_table_lookup(&add, (*ctx->prec)[block], COMB_POINTS, idx);
+            secp256k1_fe_lanes_negate(&neg, &add.y, 1);
+            secp256k1_fe_lanes_cmov(&add.y, &neg, sign);
+
+            if (first) {
+                secp256k1_gej_lanes_set_ge(&acc, &add);
+                secp256k1_gej_lanes_rescale(&acc, &blind);
+                first = 0;
+            } else {
+                secp256k1_gej_lanes_add_ge(&acc, &acc, &add);
+            }
+        }
+        if (comb_off > 0) {
+            secp256k1_gej_lanes_double(&acc, &acc);
+        }
+    }
+    secp256k1_gej_lanes_add_ge(&acc, &acc, &offset);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        secp256k1_gej_lanes_get_gej(&r[l], &acc, l);
+    }
+
+    bits = 0;
+    memset(idx, 0, sizeof(idx));
+    memset(sign, 0, sizeof(sign));
+    memset(recoded, 0, sizeof(recoded));
+    memset(d32, 0, sizeof(d32));
+    secp256k1_ge_lanes_clear(&add);
+    memset(&neg, 0, sizeof(neg));
+    secp256k1_gej_lanes_clear(&acc);
+    secp256k1_scalar_clear(&d);
+}
+
+/* Uses the copy compiled for the lane engine returned by secp256k1_fe_lanes_engine. */
+#if defined(USE_FIELD_LANES_IFMA)
+SECP256K1_FE_LANES_IFMA_CLONE
+static void secp256k1_ecmult_gen_lanes_ifma(const secp256k1_ecmult_gen_context *ctx, secp256k1_gej *r, const secp256k1_scalar *gn) {
+    secp256k1_ecmult_gen_lanes_inner(ctx, r, gn);
+}
+#endif
+
+static void secp256k1_ecmult_gen_lanes(const secp256k1_ecmult_gen_context *ctx, secp256k1_gej *r, const secp256k1_scalar *gn) {
+#if defined(USE_FIELD_LANES_IFMA)
+    if (secp256k1_fe_lanes_engine() == SECP256K1_FE_LANES_IFMA) {
+        secp256k1_ecmult_gen_lanes_ifma(ctx, r, gn);
+        return;
+    }
+#endif
+    secp256k1_ecmult_gen_lanes_inner(ctx, r, gn);
+}
+
+static void secp256k1_ecmult_gen_multi(const secp256k1_ecmult_gen_context *ctx, secp256k1_gej *r, const secp256k1_scalar *gn, size_t n) {
+    secp256k1_gej rl[SECP256K1_FE_LANES];
+    secp256k1_scalar gl[SECP256K1_FE_LANES];
+    size_t i = 0, j;
+
+    if (secp256k1_fe_lanes_accelerated()) {
+        for (; i + SECP256K1_FE_LANES <= n; i += SECP256K1_FE_LANES) {
+            secp256k1_ecmult_gen_lanes(ctx, &r[i], &gn[i]);
+        }
+        if (n - i >= 2) {
+            /* Fill the unused lanes of the last group with its first scalar. */
+            for (j = 0; j < SECP256K1_FE_LANES; j++) {
+                gl[j] = gn[i + (i + j < n ? j : 0)];
+            }
+            secp256k1_ecmult_gen_lanes(ctx, rl, gl);
+            for (j = 0; i + j < n; j++) {
+                r[i + j] = rl[j];
+            }
+            i = n;
+            memset(gl, 0, sizeof(gl));
+            memset(rl, 0, sizeof(rl));
+        }
+    }
+    for (; i < n; i++) {
+        secp256k1_ecmult_gen(ctx, &r[i], &gn[i]);
+    }
+}
+
+/* Compute the scalar (2^COMB_BITS - 1)/2, the offset between the result of the
+ * comb and the scalar whose bits it consumed. */
+static void secp256k1_ecmult_gen_scalar_diff(secp256k1_scalar *diff) {
+    secp256k1_scalar two, neghalf;
+    int i;
+
+    secp256k1_scalar_set_int(&two, 2);
+    secp256k1_scalar_inverse(&neghalf, &two);
+    secp256k1_scalar_negate(&neghalf, &neghalf);
+    secp256k1_scalar_set_int(diff, 1);
+    for (i = 0; i < COMB_BITS - 1; i++) {
+        secp256k1_scalar_add(diff, diff, diff);
+    }
+    secp256k1_scalar_add(diff, diff, &neghalf);
 }
 
 /* Setup blinding values for secp256k1_ecmult_gen. */
 static void secp256k1_ecmult_gen_blind(secp256k1_ecmult_gen_context *ctx, const unsigned char *seed32) {
     secp256k1_scalar b;
+    secp256k1_scalar diff;
     secp256k1_gej gb;
     secp256k1_fe s;
     unsigned char nonce32[32];
     secp256k1_rfc6979_hmac_sha256 rng;
     int retry;
     unsigned char keydata[64] = {0};
+    secp256k1_ecmult_gen_scalar_diff(&diff);
     if (seed32 == NULL) {
-        /* When seed is NULL, reset the initial point and blinding value. */
-        secp256k1_gej_set_ge(&ctx->initial, &secp256k1_ge_const_g);
-        secp256k1_gej_neg(&ctx->initial, &ctx->initial);
-        secp256k1_scalar_set_int(&ctx->blind, 1);
+        /* When seed is NULL, reset the offsets and projection to those of a blinding value of -1. */
+        secp256k1_ge_neg(&ctx->ge_offset, &secp256k1_ge_const_g);
+        secp256k1_scalar_set_int(&ctx->scalar_offset, 1);
+        secp256k1_scalar_add(&ctx->scalar_offset, &ctx->scalar_offset, &diff);
+        secp256k1_fe_set_int(&ctx->proj_blind, 1);
     }
     /* The prior blinding value (if not reset) is chained forward by including it in the hash. */
-    secp256k1_scalar_get_b32(nonce32, &ctx->blind);
+    secp256k1_scalar_get_b32(nonce32, &ctx->scalar_offset);
     /** Using a CSPRNG allows a failure free interface, avoids needing large amounts of random data,
      *   and guards against weak or adversarial seeds.  This is a simpler and safer interface than
      *   asking the caller for blinding values directly and expecting them to retry on failure.
@@ -189,21 +414,22 @@ static void secp256k1_ecmult_gen_blind(secp256k1_ecmult_gen_context *ctx, const
         retry = !secp256k1_fe_set_b32(&s, nonce32);
         retry = retry || secp256k1_fe_is_zero(&s);
     } while (retry); /* This branch true is cryptographically unreachable. Requires sha256_hmac output > Fp. */
-    /* Randomize the projection to defend against multiplier sidechannels. */
-    secp256k1_gej_rescale(&ctx->initial, &s);
-    secp256k1_fe_clear(&s);
     do {
         secp256k1_rfc6979_hmac_sha256_generate(&rng, nonce32, 32);
         secp256k1_scalar_set_b32(&b, nonce32, &retry);
-        /* A blinding value of 0 works, but would undermine the projection hardening. */
+        /* A blinding value of 0 would make ge_offset infinity, which secp256k1_gej_add_ge cannot add. */
         retry = retry || secp256k1_scalar_is_zero(&b);
     } while (retry); /* This branch true is cryptographically unreachable. Requires sha256_hmac output > order. */
     secp256k1_rfc6979_hmac_sha256_finalize(&rng);
     memset(nonce32, 0, 32);
+    /* For the blinding value b, set ge_offset = b*G and scalar_offset = diff - b. */
     secp256k1_ecmult_gen(ctx, &gb, &b);
     secp256k1_scalar_negate(&b, &b);
-    ctx->blind = b;
-    ctx->initial = gb;
+    secp256k1_scalar_add(&ctx->scalar_offset, &b, &diff);
+    secp256k1_ge_set_gej(&ctx->ge_offset, &gb);
+    /* Randomize the projection to defend against multiplier sidechannels. */
+    ctx->proj_blind = s;
+    secp256k1_fe_clear(&s);
     secp256k1_scalar_clear(&b);
     secp256k1_gej_clear(&gb);
 }
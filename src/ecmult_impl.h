@@ -14,6 +14,9 @@
 #include "group.h"
 #include "scalar.h"
 #include "ecmult.h"
+#ifdef USE_ECMULT_VERIFY_STATIC_PRECOMPUTATION
+#include "ecmult_static_pre_g.h"
+#endif
 
 #if defined(EXHAUSTIVE_TEST_ORDER)
 /* We need to lower these values for exhaustive tests because
@@ -74,8 +77,14 @@
 #define PIPPENGER_SCRATCH_OBJECTS 6
 #define STRAUSS_SCRATCH_OBJECTS 6
 
+#define PIPPENGER_AFFINE_SCRATCH_OBJECTS 13
+
 #define PIPPENGER_MAX_BUCKET_WINDOW 12
 
+/* Number of affine bucket additions in pippenger_wnaf_affine that share a
+ * single field inversion */
+#define PIPPENGER_AFFINE_BATCH 256
+
 /* Minimum number of points for which pippenger_wnaf is faster than strauss wnaf */
 #ifdef USE_ENDOMORPHISM
     #define ECMULT_PIPPENGER_THRESHOLD 88
@@ -89,6 +98,10 @@
     #define ECMULT_MAX_POINTS_PER_BATCH 10000000
 #endif
 
+/* Minimum number of points per task in ecmult_multi_var_parallel. Smaller
+ * tasks are not worth the extra summation and scheduling overhead. */
+#define ECMULT_PARALLEL_MIN_POINTS 32
+
 /** Fill a table 'prej' with precomputed odd multiples of a. Prej will contain
  *  the values [1*a,3*a,...,(2*n-1)*a], so it space for n values. zr[0] will
  *  contain prej[0].z / a.z. The other zr[i] values = prej[i].z / prej[i-1].z.
@@ -311,71 +324,94 @@ static void secp256k1_ecmult_odd_multiples_table_storage_var(const int n, secp25
     } \
 } while(0)
 
-static const size_t SECP256K1_ECMULT_CONTEXT_PREALLOCATED_SIZE =
-    ROUND_TO_ALIGN(sizeof((*((secp256k1_ecmult_context*) NULL)->pre_g)[0]) * ECMULT_TABLE_SIZE(WINDOW_G))
+#if defined(USE_ECMULT_VERIFY_STATIC_PRECOMPUTATION) && SECP256K1_ECMULT_STATIC_PRE_G_WINDOW != WINDOW_G
+#  error ecmult_static_pre_g.h was generated for a different ECMULT_WINDOW_SIZE
+#endif
+
+static size_t secp256k1_ecmult_context_prealloc_size(int window_g) {
+#ifdef USE_ECMULT_VERIFY_STATIC_PRECOMPUTATION
+    if (window_g == WINDOW_G) {
+        return 0;
+    }
+#endif
+    return ROUND_TO_ALIGN(sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(window_g))
 #ifdef USE_ENDOMORPHISM
-    + ROUND_TO_ALIGN(sizeof((*((secp256k1_ecmult_context*) NULL)->pre_g_128)[0]) * ECMULT_TABLE_SIZE(WINDOW_G))
+        + ROUND_TO_ALIGN(sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(window_g))
 #endif
-    ;
+        ;
+}
 
 static void secp256k1_ecmult_context_init(secp256k1_ecmult_context *ctx) {
     ctx->pre_g = NULL;
 #ifdef USE_ENDOMORPHISM
     ctx->pre_g_128 = NULL;
 #endif
+    ctx->window_g = WINDOW_G;
 }
 
-static void secp256k1_ecmult_context_build(secp256k1_ecmult_context *ctx, void **prealloc) {
+static void secp256k1_ecmult_context_build(secp256k1_ecmult_context *ctx, int window_g, void **prealloc) {
     secp256k1_gej gj;
     void* const base = *prealloc;
-    size_t const prealloc_size = SECP256K1_ECMULT_CONTEXT_PREALLOCATED_SIZE;
+    size_t const prealloc_size = secp256k1_ecmult_context_prealloc_size(window_g);
 
     if (ctx->pre_g != NULL) {
         return;
     }
+    VERIFY_CHECK(window_g >= 2 && window_g <= 24);
+    ctx->window_g = window_g;
+
+#ifdef USE_ECMULT_VERIFY_STATIC_PRECOMPUTATION
+    if (window_g == WINDOW_G) {
+        ctx->pre_g = (secp256k1_ge_storage (*)[])secp256k1_ecmult_static_pre_g;
+#ifdef USE_ENDOMORPHISM
+        ctx->pre_g_128 = (secp256k1_ge_storage (*)[])secp256k1_ecmult_static_pre_g_128;
+#endif
+        return;
+    }
+#endif
 
     /* get the generator */
     secp256k1_gej_set_ge(&gj, &secp256k1_ge_const_g);
 
     {
-        size_t size = sizeof((*ctx->pre_g)[0]) * ((size_t)ECMULT_TABLE_SIZE(WINDOW_G));
+        size_t size = sizeof((*ctx->pre_g)[0]) * ((size_t)ECMULT_TABLE_SIZE(window_g));
         /* check for overflow */
-        VERIFY_CHECK(size / sizeof((*ctx->pre_g)[0]) == ((size_t)ECMULT_TABLE_SIZE(WINDOW_G)));
-        ctx->pre_g = (secp256k1_ge_storage (*)[])manual_alloc(prealloc, sizeof((*ctx->pre_g)[0]) * ECMULT_TABLE_SIZE(WINDOW_G), base, prealloc_size);
+        VERIFY_CHECK(size / sizeof((*ctx->pre_g)[0]) == ((size_t)ECMULT_TABLE_SIZE(window_g)));
+        ctx->pre_g = (secp256k1_ge_storage (*)[])manual_alloc(prealloc, sizeof((*ctx->pre_g)[0]) * ECMULT_TABLE_SIZE(window_g), base, prealloc_size);
     }
 
     /* precompute the tables with odd multiples */
-    secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(WINDOW_G), *ctx->pre_g, &gj);
+    secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(window_g), *ctx->pre_g, &gj);
 
 #ifdef USE_ENDOMORPHISM
     {
         secp256k1_gej g_128j;
         int i;
 
-        size_t size = sizeof((*ctx->pre_g_128)[0]) * ((size_t) ECMULT_TABLE_SIZE(WINDOW_G));
+        size_t size = sizeof((*ctx->pre_g_128)[0]) * ((size_t) ECMULT_TABLE_SIZE(window_g));
         /* check for overflow */
-        VERIFY_CHECK(size / sizeof((*ctx->pre_g_128)[0]) == ((size_t)ECMULT_TABLE_SIZE(WINDOW_G)));
-        ctx->pre_g_128 = (secp256k1_ge_storage (*)[])manual_alloc(prealloc, sizeof((*ctx->pre_g_128)[0]) * ECMULT_TABLE_SIZE(WINDOW_G), base, prealloc_size);
+        VERIFY_CHECK(size / sizeof((*ctx->pre_g_128)[0]) == ((size_t)ECMULT_TABLE_SIZE(window_g)));
+        ctx->pre_g_128 = (secp256k1_ge_storage (*)[])manual_alloc(prealloc, sizeof((*ctx->pre_g_128)[0]) * ECMULT_TABLE_SIZE(window_g), base, prealloc_size);
 
         /* calculate 2^128*generator */
         g_128j = gj;
         for (i = 0; i < 128; i++) {
             secp256k1_gej_double_var(&g_128j, &g_128j, NULL);
         }
-        secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(WINDOW_G), *ctx->pre_g_128, &g_128j);
+        secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(window_g), *ctx->pre_g_128, &g_128j);
     }
 #endif
 }
 
 static void secp256k1_ecmult_context_finalize_memcpy(secp256k1_ecmult_context *dst, const secp256k1_ecmult_context *src) {
-    if (src->pre_g != NULL) {
-        /* We cast to void* first to suppress a -Wcast-align warning. */
-        dst->pre_g = (secp256k1_ge_storage (*)[])(void*)((unsigned char*)dst + ((unsigned char*)(src->pre_g) - (unsigned char*)src));
+    /* Nothing to relocate if the tables are not built or static */
+    if (src->pre_g == NULL || secp256k1_ecmult_context_prealloc_size(src->window_g) == 0) {
+        return;
     }
+    /* We cast to void* first to suppress a -Wcast-align warning. */
+    dst->pre_g = (secp256k1_ge_storage (*)[])(void*)((unsigned char*)dst + ((unsigned char*)(src->pre_g) - (unsigned char*)src));
 #ifdef USE_ENDOMORPHISM
-    if (src->pre_g_128 != NULL) {
-        dst->pre_g_128 = (secp256k1_ge_storage (*)[])(void*)((unsigned char*)dst + ((unsigned char*)(src->pre_g_128) - (unsigned char*)src));
-    }
+    dst->pre_g_128 = (secp256k1_ge_storage (*)[])(void*)((unsigned char*)dst + ((unsigned char*)(src->pre_g_128) - (unsigned char*)src));
 #endif
 }
 
@@ -558,8 +594,8 @@ static void secp256k1_ecmult_strauss_wnaf(const secp256k1_ecmult_context *ctx, c
         secp256k1_scalar_split_128(&ng_1, &ng_128, ng);
 
         /* Build wnaf representation for ng_1 and ng_128 */
-        bits_ng_1   = secp256k1_ecmult_wnaf(wnaf_ng_1,   129, &ng_1,   WINDOW_G);
-        bits_ng_128 = secp256k1_ecmult_wnaf(wnaf_ng_128, 129, &ng_128, WINDOW_G);
+        bits_ng_1   = secp256k1_ecmult_wnaf(wnaf_ng_1,   129, &ng_1,   ctx->window_g);
+        bits_ng_128 = secp256k1_ecmult_wnaf(wnaf_ng_128, 129, &ng_128, ctx->window_g);
         if (bits_ng_1 > bits) {
             bits = bits_ng_1;
         }
@@ -569,7 +605,7 @@ static void secp256k1_ecmult_strauss_wnaf(const secp256k1_ecmult_context *ctx, c
     }
 #else
     if (ng) {
-        bits_ng     = secp256k1_ecmult_wnaf(wnaf_ng,     256, ng,      WINDOW_G);
+        bits_ng     = secp256k1_ecmult_wnaf(wnaf_ng,     256, ng,      ctx->window_g);
         if (bits_ng > bits) {
             bits = bits_ng;
         }
@@ -593,11 +629,11 @@ static void secp256k1_ecmult_strauss_wnaf(const secp256k1_ecmult_context *ctx, c
             }
         }
         if (i < bits_ng_1 && (n = wnaf_ng_1[i])) {
-            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g, n, WINDOW_G);
+            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g, n, ctx->window_g);
             secp256k1_gej_add_zinv_var(r, r, &tmpa, &Z);
         }
         if (i < bits_ng_128 && (n = wnaf_ng_128[i])) {
-            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g_128, n, WINDOW_G);
+            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g_128, n, ctx->window_g);
             secp256k1_gej_add_zinv_var(r, r, &tmpa, &Z);
         }
 #else
@@ -608,7 +644,7 @@ static void secp256k1_ecmult_strauss_wnaf(const secp256k1_ecmult_context *ctx, c
             }
         }
         if (i < bits_ng && (n = wnaf_ng[i])) {
-            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g, n, WINDOW_G);
+            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g, n, ctx->window_g);
             secp256k1_gej_add_zinv_var(r, r, &tmpa, &Z);
         }
 #endif
@@ -639,6 +675,167 @@ static void secp256k1_ecmult(const secp256k1_ecmult_context *ctx, secp256k1_gej
     secp256k1_ecmult_strauss_wnaf(ctx, &state, r, 1, a, na, ng);
 }
 
+/* Number of points handled at once by ecmult_multi_table_var. The wnafs of
+ * each point take about 1KB of stack. */
+#define ECMULT_MULTI_TABLE_CHUNK 16
+
+static void secp256k1_ecmult_point_table(unsigned char *table, const secp256k1_ge *p) {
+    secp256k1_ge_storage pre[ECMULT_POINT_TABLE_SIZE];
+    secp256k1_gej pj;
+
+    secp256k1_gej_set_ge(&pj, p);
+    secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_POINT_TABLE_SIZE, pre, &pj);
+    memcpy(table, pre, sizeof(pre));
+}
+
+/* Same as ECMULT_TABLE_GET_GE_STORAGE, for tables created by
+ * ecmult_point_table which may not be aligned. */
+static void secp256k1_ecmult_point_table_get_ge(secp256k1_ge *r, const unsigned char *table, int n) {
+    secp256k1_ge_storage s;
+    VERIFY_CHECK((n & 1) == 1);
+    VERIFY_CHECK(n >= -((1 << (ECMULT_POINT_TABLE_WINDOW-1)) - 1));
+    VERIFY_CHECK(n <=  ((1 << (ECMULT_POINT_TABLE_WINDOW-1)) - 1));
+    if (n > 0) {
+        memcpy(&s, &table[((n-1)/2) * sizeof(s)], sizeof(s));
+        secp256k1_ge_from_storage(r, &s);
+    } else {
+        memcpy(&s, &table[((-n-1)/2) * sizeof(s)], sizeof(s));
+        secp256k1_ge_from_storage(r, &s);
+        secp256k1_fe_negate(&r->y, &r->y, 1);
+    }
+}
+
+/* Computes r = ng*G + sum_i na[i]*P_i for num <= ECMULT_MULTI_TABLE_CHUNK
+ * points given by their precomputed tables. This is Strauss' algorithm
+ * without the table construction. */
+static void secp256k1_ecmult_multi_table_chunk(const secp256k1_ecmult_context *ctx, secp256k1_gej *r, const unsigned char *const *tables, const secp256k1_scalar *na, size_t num, const secp256k1_scalar *ng) {
+    secp256k1_ge tmpa;
+#ifdef USE_ENDOMORPHISM
+    int wnaf_na_1[ECMULT_MULTI_TABLE_CHUNK][130];
+    int wnaf_na_lam[ECMULT_MULTI_TABLE_CHUNK][130];
+    int bits_na_1[ECMULT_MULTI_TABLE_CHUNK];
+    int bits_na_lam[ECMULT_MULTI_TABLE_CHUNK];
+    secp256k1_scalar ng_1, ng_128;
+    int wnaf_ng_1[129];
+    int bits_ng_1 = 0;
+    int wnaf_ng_128[129];
+    int bits_ng_128 = 0;
+#else
+    int wnaf_na[ECMULT_MULTI_TABLE_CHUNK][256];
+    int bits_na[ECMULT_MULTI_TABLE_CHUNK];
+    int wnaf_ng[256];
+    int bits_ng = 0;
+#endif
+    int i;
+    int bits = 0;
+    size_t np;
+
+    VERIFY_CHECK(num <= ECMULT_MULTI_TABLE_CHUNK);
+    for (np = 0; np < num; ++np) {
+#ifdef USE_ENDOMORPHISM
+        secp256k1_scalar na_1, na_lam;
+        secp256k1_scalar_split_lambda(&na_1, &na_lam, &na[np]);
+        bits_na_1[np]   = secp256k1_ecmult_wnaf(wnaf_na_1[np],   130, &na_1,   ECMULT_POINT_TABLE_WINDOW);
+        bits_na_lam[np] = secp256k1_ecmult_wnaf(wnaf_na_lam[np], 130, &na_lam, ECMULT_POINT_TABLE_WINDOW);
+        VERIFY_CHECK(bits_na_1[np] <= 130);
+        VERIFY_CHECK(bits_na_lam[np] <= 130);
+        if (bits_na_1[np] > bits) {
+            bits = bits_na_1[np];
+        }
+        if (bits_na_lam[np] > bits) {
+            bits = bits_na_lam[np];
+        }
+#else
+        bits_na[np] = secp256k1_ecmult_wnaf(wnaf_na[np], 256, &na[np], ECMULT_POINT_TABLE_WINDOW);
+        if (bits_na[np] > bits) {
+            bits = bits_na[np];
+        }
+#endif
+    }
+
+#ifdef USE_ENDOMORPHISM
+    if (ng) {
+        secp256k1_scalar_split_128(&ng_1, &ng_128, ng);
+        bits_ng_1   = secp256k1_ecmult_wnaf(wnaf_ng_1,   129, &ng_1,   ctx->window_g);
+        bits_ng_128 = secp256k1_ecmult_wnaf(wnaf_ng_128, 129, &ng_128, ctx->window_g);
+        if (bits_ng_1 > bits) {
+            bits = bits_ng_1;
+        }
+        if (bits_ng_128 > bits) {
+            bits = bits_ng_128;
+        }
+    }
+#else
+    if (ng) {
+        bits_ng = secp256k1_ecmult_wnaf(wnaf_ng, 256, ng, ctx->window_g);
+        if (bits_ng > bits) {
+            bits = bits_ng;
+        }
+    }
+#endif
+
+    secp256k1_gej_set_infinity(r);
+
+    for (i = bits - 1; i >= 0; i--) {
+        int n;
+        secp256k1_gej_double_var(r, r, NULL);
+#ifdef USE_ENDOMORPHISM
+        for (np = 0; np < num; ++np) {
+            if (i < bits_na_1[np] && (n = wnaf_na_1[np][i])) {
+                secp256k1_ecmult_point_table_get_ge(&tmpa, tables[np], n);
+                secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+            }
+            if (i < bits_na_lam[np] && (n = wnaf_na_lam[np][i])) {
+                secp256k1_ecmult_point_table_get_ge(&tmpa, tables[np], n);
+                secp256k1_ge_mul_lambda(&tmpa, &tmpa);
+                secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+            }
+        }
+        if (i < bits_ng_1 && (n = wnaf_ng_1[i])) {
+            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g, n, ctx->window_g);
+            secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+        }
+        if (i < bits_ng_128 && (n = wnaf_ng_128[i])) {
+            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g_128, n, ctx->window_g);
+            secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+        }
+#else
+        for (np = 0; np < num; ++np) {
+            if (i < bits_na[np] && (n = wnaf_na[np][i])) {
+                secp256k1_ecmult_point_table_get_ge(&tmpa, tables[np], n);
+                secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+            }
+        }
+        if (i < bits_ng && (n = wnaf_ng[i])) {
+            ECMULT_TABLE_GET_GE_STORAGE(&tmpa, *ctx->pre_g, n, ctx->window_g);
+            secp256k1_gej_add_ge_var(r, r, &tmpa, NULL);
+        }
+#endif
+    }
+}
+
+static int secp256k1_ecmult_multi_table_var(const secp256k1_ecmult_context *ctx, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_table_callback cb, void *cbdata, size_t n) {
+    secp256k1_scalar sc[ECMULT_MULTI_TABLE_CHUNK];
+    const unsigned char *tables[ECMULT_MULTI_TABLE_CHUNK];
+    size_t offset = 0;
+
+    secp256k1_gej_set_infinity(r);
+    do {
+        size_t num = n - offset < ECMULT_MULTI_TABLE_CHUNK ? n - offset : ECMULT_MULTI_TABLE_CHUNK;
+        size_t i;
+        secp256k1_gej tmp;
+        for (i = 0; i < num; i++) {
+            if (!cb(&sc[i], &tables[i], offset + i, cbdata)) {
+                return 0;
+            }
+        }
+        secp256k1_ecmult_multi_table_chunk(ctx, &tmp, tables, sc, num, offset == 0 ? inp_g_sc : NULL);
+        secp256k1_gej_add_var(r, r, &tmp, NULL);
+        offset += num;
+    } while (offset < n);
+    return 1;
+}
+
 static size_t secp256k1_strauss_scratch_size(size_t n_points) {
 #ifdef USE_ENDOMORPHISM
     static const size_t point_size = (2 * sizeof(secp256k1_ge) + sizeof(secp256k1_gej) + sizeof(secp256k1_fe)) * ECMULT_TABLE_SIZE(WINDOW_A) + sizeof(struct secp256k1_strauss_point_state) + sizeof(secp256k1_gej) + sizeof(secp256k1_scalar);
@@ -778,6 +975,69 @@ struct secp256k1_pippenger_state {
     struct secp256k1_pippenger_point_state* ps;
 };
 
+/*
+ * Processes window i of pippenger_wnaf: first each point is added to a
+ * "bucket" corresponding to the point's wnaf[i]. Second, the buckets are added
+ * together and r is updated as
+ * r = 2^(bucket_window+1)*r + 1*bucket[0] + 3*bucket[1] + 5*bucket[2] + ...
+ */
+static void secp256k1_ecmult_pippenger_wnaf_window(secp256k1_gej *buckets, int bucket_window, const struct secp256k1_pippenger_state *state, secp256k1_gej *r, const secp256k1_ge *pt, size_t no, int i) {
+    size_t n_wnaf = WNAF_SIZE(bucket_window+1);
+    size_t np;
+    int j;
+    secp256k1_gej running_sum;
+
+    for(j = 0; j < ECMULT_TABLE_SIZE(bucket_window+2); j++) {
+        secp256k1_gej_set_infinity(&buckets[j]);
+    }
+
+    for (np = 0; np < no; ++np) {
+        int n = state->wnaf_na[np*n_wnaf + i];
+        struct secp256k1_pippenger_point_state point_state = state->ps[np];
+        secp256k1_ge tmp;
+        int idx;
+
+        if (i == 0) {
+            /* correct for wnaf skew */
+            int skew = point_state.skew_na;
+            if (skew) {
+                secp256k1_ge_neg(&tmp, &pt[point_state.input_pos]);
+                secp256k1_gej_add_ge_var(&buckets[0], &buckets[0], &tmp, NULL);
+            }
+        }
+        if (n > 0) {
+            idx = (n - 1)/2;
+            secp256k1_gej_add_ge_var(&buckets[idx], &buckets[idx], &pt[point_state.input_pos], NULL);
+        } else if (n < 0) {
+            idx = -(n + 1)/2;
+            secp256k1_ge_neg(&tmp, &pt[point_state.input_pos]);
+            secp256k1_gej_add_ge_var(&buckets[idx], &buckets[idx], &tmp, NULL);
+        }
+    }
+
+    for(j = 0; j < bucket_window; j++) {
+        secp256k1_gej_double_var(r, r, NULL);
+    }
+
+    secp256k1_gej_set_infinity(&running_sum);
+    /* Accumulate the sum: bucket[0] + 3*bucket[1] + 5*bucket[2] + 7*bucket[3] + ...
+     *                   = bucket[0] +   bucket[1] +   bucket[2] +   bucket[3] + ...
+     *                   +         2 *  (bucket[1] + 2*bucket[2] + 3*bucket[3] + ...)
+     * using an intermediate running sum:
+     * running_sum = bucket[0] +   bucket[1] +   bucket[2] + ...
+     *
+     * The doubling is done implicitly by deferring the final window doubling (of 'r').
+     */
+    for(j = ECMULT_TABLE_SIZE(bucket_window+2) - 1; j > 0; j--) {
+        secp256k1_gej_add_var(&running_sum, &running_sum, &buckets[j], NULL);
+        secp256k1_gej_add_var(r, r, &running_sum, NULL);
+    }
+
+    secp256k1_gej_add_var(&running_sum, &running_sum, &buckets[0], NULL);
+    secp256k1_gej_double_var(r, r, NULL);
+    secp256k1_gej_add_var(r, r, &running_sum, NULL);
+}
+
 /*
  * pippenger_wnaf computes the result of a multi-point multiplication as
  * follows: The scalars are brought into wnaf with n_wnaf elements each. Then
@@ -790,7 +1050,6 @@ static int secp256k1_ecmult_pippenger_wnaf(secp256k1_gej *buckets, int bucket_wi
     size_t np;
     size_t no = 0;
     int i;
-    int j;
 
     for (np = 0; np < num; ++np) {
         if (secp256k1_scalar_is_zero(&sc[np]) || secp256k1_ge_is_infinity(&pt[np])) {
@@ -807,58 +1066,234 @@ static int secp256k1_ecmult_pippenger_wnaf(secp256k1_gej *buckets, int bucket_wi
     }
 
     for (i = n_wnaf - 1; i >= 0; i--) {
-        secp256k1_gej running_sum;
+        secp256k1_ecmult_pippenger_wnaf_window(buckets, bucket_window, state, r, pt, no, i);
+    }
+    return 1;
+}
 
-        for(j = 0; j < ECMULT_TABLE_SIZE(bucket_window+2); j++) {
-            secp256k1_gej_set_infinity(&buckets[j]);
-        }
+/* Memory used by pippenger_wnaf_affine in addition to pippenger_state. */
+struct secp256k1_pippenger_affine_state {
+    /* The buckets, in affine coordinates */
+    secp256k1_ge *buckets;
+    /* For every bucket, 0 if it is not part of the current batch or its
+     * position in the batch plus one otherwise */
+    int *bucket_slot;
+    /* Pending additions buckets[batch_bucket[k]] += batch_pt[k] */
+    secp256k1_ge *batch_pt;
+    int *batch_bucket;
+    secp256k1_fe *batch_den;
+    secp256k1_fe *batch_inv;
+    /* Two lists of pending terms, given by their index into the state */
+    size_t *todo[2];
+};
 
-        for (np = 0; np < no; ++np) {
-            int n = state->wnaf_na[np*n_wnaf + i];
-            struct secp256k1_pippenger_point_state point_state = state->ps[np];
+/* Carries out the n_batch pending additions of state using a single field
+ * inversion for all of them. */
+static void secp256k1_ecmult_pippenger_affine_flush(struct secp256k1_pippenger_affine_state *state, size_t n_batch) {
+    size_t k;
+
+    secp256k1_fe_inv_all_var(state->batch_inv, state->batch_den, n_batch);
+    for (k = 0; k < n_batch; k++) {
+        secp256k1_ge *b = &state->buckets[state->batch_bucket[k]];
+        const secp256k1_ge *a = &state->batch_pt[k];
+        secp256k1_fe lambda, t, x3, y3;
+
+        /* lambda = (a.y - b.y) / (a.x - b.x) */
+        secp256k1_fe_negate(&t, &b->y, 1);
+        secp256k1_fe_add(&t, &a->y);
+        secp256k1_fe_mul(&lambda, &t, &state->batch_inv[k]);
+        /* x3 = lambda^2 - b.x - a.x */
+        secp256k1_fe_sqr(&x3, &lambda);
+        secp256k1_fe_negate(&t, &b->x, 1);
+        secp256k1_fe_add(&x3, &t);
+        secp256k1_fe_negate(&t, &a->x, 1);
+        secp256k1_fe_add(&x3, &t);
+        /* y3 = lambda*(b.x - x3) - b.y */
+        secp256k1_fe_negate(&t, &x3, 5);
+        secp256k1_fe_add(&t, &b->x);
+        secp256k1_fe_mul(&y3, &t, &lambda);
+        secp256k1_fe_negate(&t, &b->y, 1);
+        secp256k1_fe_add(&y3, &t);
+
+        secp256k1_fe_normalize_weak(&x3);
+        secp256k1_fe_normalize_weak(&y3);
+        b->x = x3;
+        b->y = y3;
+        state->bucket_slot[state->batch_bucket[k]] = 0;
+    }
+}
+
+/* Same as pippenger_wnaf_window, but keeps the buckets in affine coordinates.
+ * The bucket additions are collected into batches in which every bucket
+ * occurs at most once, so that all of them can be carried out with a single
+ * shared inversion. Terms whose bucket is already part of the current batch
+ * are deferred to the next pass over the pending terms. */
+static void secp256k1_ecmult_pippenger_wnaf_window_affine(struct secp256k1_pippenger_affine_state *astate, int bucket_window, const struct secp256k1_pippenger_state *state, secp256k1_gej *r, const secp256k1_ge *pt, size_t no, int i) {
+    size_t n_wnaf = WNAF_SIZE(bucket_window+1);
+    size_t np;
+    size_t n_todo = 0;
+    int n_passes_small = 0;
+    int cur = 0;
+    int j;
+    secp256k1_gej running_sum;
+    secp256k1_gej skew_sum;
+
+    for(j = 0; j < ECMULT_TABLE_SIZE(bucket_window+2); j++) {
+        secp256k1_ge_set_infinity(&astate->buckets[j]);
+        astate->bucket_slot[j] = 0;
+    }
+
+    /* The skew corrections would all end up in bucket[0] which would then
+     * need one pass per correction. Sum them up in Jacobian coordinates
+     * instead; they are added to r below where bucket[0] would be. */
+    secp256k1_gej_set_infinity(&skew_sum);
+    for (np = 0; np < no; ++np) {
+        if (i == 0 && state->ps[np].skew_na) {
             secp256k1_ge tmp;
-            int idx;
-
-            if (i == 0) {
-                /* correct for wnaf skew */
-                int skew = point_state.skew_na;
-                if (skew) {
-                    secp256k1_ge_neg(&tmp, &pt[point_state.input_pos]);
-                    secp256k1_gej_add_ge_var(&buckets[0], &buckets[0], &tmp, NULL);
+            secp256k1_ge_neg(&tmp, &pt[state->ps[np].input_pos]);
+            secp256k1_gej_add_ge_var(&skew_sum, &skew_sum, &tmp, NULL);
+        }
+        if (state->wnaf_na[np*n_wnaf + i] != 0) {
+            astate->todo[0][n_todo++] = np;
+        }
+    }
+
+    while (n_todo > 0) {
+        size_t n_next = 0;
+        size_t n_batch = 0;
+        size_t n_done = 0;
+        size_t k;
+
+        if (n_passes_small >= 2) {
+            /* Only a few distinct buckets are left (typically in the top
+             * window, whose digits are small). Batching would need one pass
+             * per remaining term in these buckets, so sum them up one
+             * bucket at a time in Jacobian coordinates instead. */
+            while (n_todo > 0) {
+                int idx0 = -1;
+                secp256k1_gej acc;
+                n_next = 0;
+                secp256k1_gej_set_infinity(&acc);
+                for (k = 0; k < n_todo; k++) {
+                    size_t term = astate->todo[cur][k];
+                    int n = state->wnaf_na[term*n_wnaf + i];
+                    int idx = n > 0 ? (n - 1)/2 : -(n + 1)/2;
+                    secp256k1_ge tmp;
+                    if (idx0 == -1) {
+                        idx0 = idx;
+                    } else if (idx != idx0) {
+                        astate->todo[cur ^ 1][n_next++] = term;
+                        continue;
+                    }
+                    if (n > 0) {
+                        tmp = pt[state->ps[term].input_pos];
+                    } else {
+                        secp256k1_ge_neg(&tmp, &pt[state->ps[term].input_pos]);
+                    }
+                    secp256k1_gej_add_ge_var(&acc, &acc, &tmp, NULL);
                 }
+                secp256k1_gej_add_ge_var(&acc, &acc, &astate->buckets[idx0], NULL);
+                secp256k1_ge_set_gej_var(&astate->buckets[idx0], &acc);
+                cur ^= 1;
+                n_todo = n_next;
             }
-            if (n > 0) {
-                idx = (n - 1)/2;
-                secp256k1_gej_add_ge_var(&buckets[idx], &buckets[idx], &pt[point_state.input_pos], NULL);
-            } else if (n < 0) {
-                idx = -(n + 1)/2;
-                secp256k1_ge_neg(&tmp, &pt[point_state.input_pos]);
-                secp256k1_gej_add_ge_var(&buckets[idx], &buckets[idx], &tmp, NULL);
-            }
+            break;
         }
 
-        for(j = 0; j < bucket_window; j++) {
-            secp256k1_gej_double_var(r, r, NULL);
-        }
+        for (k = 0; k < n_todo; k++) {
+            size_t term = astate->todo[cur][k];
+            int n = state->wnaf_na[term*n_wnaf + i];
+            int idx = n > 0 ? (n - 1)/2 : -(n + 1)/2;
+            secp256k1_ge tmp;
+            secp256k1_ge *b;
 
-        secp256k1_gej_set_infinity(&running_sum);
-        /* Accumulate the sum: bucket[0] + 3*bucket[1] + 5*bucket[2] + 7*bucket[3] + ...
-         *                   = bucket[0] +   bucket[1] +   bucket[2] +   bucket[3] + ...
-         *                   +         2 *  (bucket[1] + 2*bucket[2] + 3*bucket[3] + ...)
-         * using an intermediate running sum:
-         * running_sum = bucket[0] +   bucket[1] +   bucket[2] + ...
-         *
-         * The doubling is done implicitly by deferring the final window doubling (of 'r').
-         */
-        for(j = ECMULT_TABLE_SIZE(bucket_window+2) - 1; j > 0; j--) {
-            secp256k1_gej_add_var(&running_sum, &running_sum, &buckets[j], NULL);
-            secp256k1_gej_add_var(r, r, &running_sum, NULL);
+            if (astate->bucket_slot[idx] != 0) {
+                astate->todo[cur ^ 1][n_next++] = term;
+                continue;
+            }
+            if (n > 0) {
+                tmp = pt[state->ps[term].input_pos];
+            } else {
+                secp256k1_ge_neg(&tmp, &pt[state->ps[term].input_pos]);
+            }
+            /* The formulas in pippenger_affine_flush expect magnitude 1 */
+            secp256k1_fe_normalize_weak(&tmp.x);
+            secp256k1_fe_normalize_weak(&tmp.y);
+
+            n_done++;
+            b = &astate->buckets[idx];
+            if (secp256k1_ge_is_infinity(b)) {
+                *b = tmp;
+            } else if (secp256k1_fe_equal_var(&b->x, &tmp.x)) {
+                /* Doubling or cancellation, which the affine addition formula
+                 * does not cover. This is rare enough to not be worth batching. */
+                secp256k1_gej sum;
+                secp256k1_gej_set_ge(&sum, b);
+                secp256k1_gej_add_ge_var(&sum, &sum, &tmp, NULL);
+                secp256k1_ge_set_gej_var(b, &sum);
+            } else {
+                astate->batch_pt[n_batch] = tmp;
+                astate->batch_bucket[n_batch] = idx;
+                secp256k1_fe_negate(&astate->batch_den[n_batch], &b->x, 1);
+                secp256k1_fe_add(&astate->batch_den[n_batch], &tmp.x);
+                astate->bucket_slot[idx] = n_batch + 1;
+                n_batch++;
+                if (n_batch == PIPPENGER_AFFINE_BATCH) {
+                    secp256k1_ecmult_pippenger_affine_flush(astate, n_batch);
+                    n_batch = 0;
+                }
+            }
         }
+        secp256k1_ecmult_pippenger_affine_flush(astate, n_batch);
+        if (n_done < PIPPENGER_AFFINE_BATCH / 8) {
+            n_passes_small++;
+        }
+        cur ^= 1;
+        n_todo = n_next;
+    }
 
-        secp256k1_gej_add_var(&running_sum, &running_sum, &buckets[0], NULL);
+    for(j = 0; j < bucket_window; j++) {
         secp256k1_gej_double_var(r, r, NULL);
+    }
+
+    /* See pippenger_wnaf_window for how the buckets are summed up. */
+    secp256k1_gej_set_infinity(&running_sum);
+    for(j = ECMULT_TABLE_SIZE(bucket_window+2) - 1; j > 0; j--) {
+        secp256k1_gej_add_ge_var(&running_sum, &running_sum, &astate->buckets[j], NULL);
         secp256k1_gej_add_var(r, r, &running_sum, NULL);
     }
+
+    secp256k1_gej_add_ge_var(&running_sum, &running_sum, &astate->buckets[0], NULL);
+    secp256k1_gej_add_var(&running_sum, &running_sum, &skew_sum, NULL);
+    secp256k1_gej_double_var(r, r, NULL);
+    secp256k1_gej_add_var(r, r, &running_sum, NULL);
+}
+
+/* Same as pippenger_wnaf, but accumulates the buckets in affine coordinates
+ * using pippenger_wnaf_window_affine. */
+static int secp256k1_ecmult_pippenger_wnaf_affine(struct secp256k1_pippenger_affine_state *astate, int bucket_window, struct secp256k1_pippenger_state *state, secp256k1_gej *r, const secp256k1_scalar *sc, const secp256k1_ge *pt, size_t num) {
+    size_t n_wnaf = WNAF_SIZE(bucket_window+1);
+    size_t np;
+    size_t no = 0;
+    int i;
+
+    for (np = 0; np < num; ++np) {
+        if (secp256k1_scalar_is_zero(&sc[np]) || secp256k1_ge_is_infinity(&pt[np])) {
+            continue;
+        }
+        state->ps[no].input_pos = np;
+        state->ps[no].skew_na = secp256k1_wnaf_fixed(&state->wnaf_na[no*n_wnaf], &sc[np], bucket_window+1);
+        no++;
+    }
+    secp256k1_gej_set_infinity(r);
+
+    if (no == 0) {
+        return 1;
+    }
+
+    for (i = n_wnaf - 1; i >= 0; i--) {
+        secp256k1_ecmult_pippenger_wnaf_window_affine(astate, bucket_window, state, r, pt, no, i);
+    }
     return 1;
 }
 
@@ -988,7 +1423,22 @@ static size_t secp256k1_pippenger_scratch_size(size_t n_points, int bucket_windo
     return (sizeof(secp256k1_gej) << bucket_window) + sizeof(struct secp256k1_pippenger_state) + entries * entry_size;
 }
 
-static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_callback, const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n_points, size_t cb_offset) {
+/**
+ * Returns the scratch size required by pippenger_affine_batch for a given
+ * number of points (excluding base point G) without considering alignment.
+ */
+static size_t secp256k1_pippenger_affine_scratch_size(size_t n_points, int bucket_window) {
+#ifdef USE_ENDOMORPHISM
+    size_t entries = 2*n_points + 2;
+#else
+    size_t entries = n_points + 1;
+#endif
+    size_t entry_size = sizeof(secp256k1_ge) + sizeof(secp256k1_scalar) + sizeof(struct secp256k1_pippenger_point_state) + (WNAF_SIZE(bucket_window+1)+1)*sizeof(int) + 2*sizeof(size_t);
+    size_t batch_size = PIPPENGER_AFFINE_BATCH * (sizeof(secp256k1_ge) + sizeof(int) + 2*sizeof(secp256k1_fe));
+    return ((sizeof(secp256k1_ge) + sizeof(int)) << bucket_window) + sizeof(struct secp256k1_pippenger_state) + batch_size + entries * entry_size;
+}
+
+static int secp256k1_ecmult_pippenger_batch_internal(const secp256k1_callback* error_callback, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n_points, size_t cb_offset, int affine) {
     const size_t scratch_checkpoint = secp256k1_scratch_checkpoint(error_callback, scratch);
     /* Use 2(n+1) with the endomorphism, n+1 without, when calculating batch
      * sizes. The reason for +1 is that we add the G scalar to the list of
@@ -1000,14 +1450,15 @@ static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_call
 #endif
     secp256k1_ge *points;
     secp256k1_scalar *scalars;
-    secp256k1_gej *buckets;
+    secp256k1_gej *buckets = NULL;
+    struct secp256k1_pippenger_affine_state astate;
     struct secp256k1_pippenger_state *state_space;
     size_t idx = 0;
     size_t point_idx = 0;
     int i, j;
     int bucket_window;
 
-    (void)ctx;
+    astate.buckets = NULL;
     secp256k1_gej_set_infinity(r);
     if (inp_g_sc == NULL && n_points == 0) {
         return 1;
@@ -1024,11 +1475,31 @@ static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_call
 
     state_space->ps = (struct secp256k1_pippenger_point_state *) secp256k1_scratch_alloc(error_callback, scratch, entries * sizeof(*state_space->ps));
     state_space->wnaf_na = (int *) secp256k1_scratch_alloc(error_callback, scratch, entries*(WNAF_SIZE(bucket_window+1)) * sizeof(int));
-    buckets = (secp256k1_gej *) secp256k1_scratch_alloc(error_callback, scratch, (1<<bucket_window) * sizeof(*buckets));
-    if (state_space->ps == NULL || state_space->wnaf_na == NULL || buckets == NULL) {
+    if (state_space->ps == NULL || state_space->wnaf_na == NULL) {
         secp256k1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
         return 0;
     }
+    if (affine) {
+        astate.buckets = (secp256k1_ge *) secp256k1_scratch_alloc(error_callback, scratch, (1<<bucket_window) * sizeof(*astate.buckets));
+        astate.bucket_slot = (int *) secp256k1_scratch_alloc(error_callback, scratch, (1<<bucket_window) * sizeof(*astate.bucket_slot));
+        astate.batch_pt = (secp256k1_ge *) secp256k1_scratch_alloc(error_callback, scratch, PIPPENGER_AFFINE_BATCH * sizeof(*astate.batch_pt));
+        astate.batch_bucket = (int *) secp256k1_scratch_alloc(error_callback, scratch, PIPPENGER_AFFINE_BATCH * sizeof(*astate.batch_bucket));
+        astate.batch_den = (secp256k1_fe *) secp256k1_scratch_alloc(error_callback, scratch, PIPPENGER_AFFINE_BATCH * sizeof(*astate.batch_den));
+        astate.batch_inv = (secp256k1_fe *) secp256k1_scratch_alloc(error_callback, scratch, PIPPENGER_AFFINE_BATCH * sizeof(*astate.batch_inv));
+        astate.todo[0] = (size_t *) secp256k1_scratch_alloc(error_callback, scratch, entries * sizeof(size_t));
+        astate.todo[1] = (size_t *) secp256k1_scratch_alloc(error_callback, scratch, entries * sizeof(size_t));
+        if (astate.buckets == NULL || astate.bucket_slot == NULL || astate.batch_pt == NULL || astate.batch_bucket == NULL
+            || astate.batch_den == NULL || astate.batch_inv == NULL || astate.todo[0] == NULL || astate.todo[1] == NULL) {
+            secp256k1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+            return 0;
+        }
+    } else {
+        buckets = (secp256k1_gej *) secp256k1_scratch_alloc(error_callback, scratch, (1<<bucket_window) * sizeof(*buckets));
+        if (buckets == NULL) {
+            secp256k1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
+            return 0;
+        }
+    }
 
     if (inp_g_sc != NULL) {
         scalars[0] = *inp_g_sc;
@@ -1053,7 +1524,11 @@ static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_call
         point_idx++;
     }
 
-    secp256k1_ecmult_pippenger_wnaf(buckets, bucket_window, state_space, r, scalars, points, idx);
+    if (affine) {
+        secp256k1_ecmult_pippenger_wnaf_affine(&astate, bucket_window, state_space, r, scalars, points, idx);
+    } else {
+        secp256k1_ecmult_pippenger_wnaf(buckets, bucket_window, state_space, r, scalars, points, idx);
+    }
 
     /* Clear data */
     for(i = 0; (size_t)i < idx; i++) {
@@ -1064,17 +1539,260 @@ static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_call
         }
     }
     for(i = 0; i < 1<<bucket_window; i++) {
-        secp256k1_gej_clear(&buckets[i]);
+        if (affine) {
+            secp256k1_ge_clear(&astate.buckets[i]);
+        } else {
+            secp256k1_gej_clear(&buckets[i]);
+        }
     }
     secp256k1_scratch_apply_checkpoint(error_callback, scratch, scratch_checkpoint);
     return 1;
 }
 
+static int secp256k1_ecmult_pippenger_batch(const secp256k1_callback* error_callback, const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n_points, size_t cb_offset) {
+    (void)ctx;
+    return secp256k1_ecmult_pippenger_batch_internal(error_callback, scratch, r, inp_g_sc, cb, cbdata, n_points, cb_offset, 0);
+}
+
+/* Same as pippenger_batch, but uses affine bucket accumulation with batched
+ * inversions (see pippenger_wnaf_window_affine). This needs more memory, see
+ * pippenger_affine_scratch_size. */
+static int secp256k1_ecmult_pippenger_affine_batch(const secp256k1_callback* error_callback, const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n_points, size_t cb_offset) {
+    (void)ctx;
+    return secp256k1_ecmult_pippenger_batch_internal(error_callback, scratch, r, inp_g_sc, cb, cbdata, n_points, cb_offset, 1);
+}
+
+/* Wrapper for secp256k1_ecmult_multi_func interface */
+static int secp256k1_ecmult_pippenger_affine_batch_single(const secp256k1_callback* error_callback, const secp256k1_ecmult_context *actx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n) {
+    return secp256k1_ecmult_pippenger_affine_batch(error_callback, actx, scratch, r, inp_g_sc, cb, cbdata, n, 0);
+}
+
 /* Wrapper for secp256k1_ecmult_multi_func interface */
 static int secp256k1_ecmult_pippenger_batch_single(const secp256k1_callback* error_callback, const secp256k1_ecmult_context *actx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n) {
     return secp256k1_ecmult_pippenger_batch(error_callback, actx, scratch, r, inp_g_sc, cb, cbdata, n, 0);
 }
 
+/* Calls fn(idx, fn_data) for all idx < n, through parallel_for if it is not NULL. */
+static void secp256k1_ecmult_parallel_run(secp256k1_parallel_for_function parallel_for, void *parallel_data, void (*fn)(size_t idx, void *fn_data), void *fn_data, size_t n) {
+    size_t i;
+    if (parallel_for != NULL) {
+        parallel_for(fn, fn_data, n, parallel_data);
+    } else {
+        for (i = 0; i < n; i++) {
+            fn(i, fn_data);
+        }
+    }
+}
+
+struct secp256k1_pippenger_parallel_data {
+    secp256k1_ecmult_multi_callback *cb;
+    void *cbdata;
+    size_t cb_offset;
+    size_t n_points;
+    size_t n_task_points;
+    size_t n_tasks;
+    /* Number of leading entries taken by the G term */
+    size_t g_entries;
+    int bucket_window;
+    secp256k1_ge *points;
+    secp256k1_scalar *scalars;
+    struct secp256k1_pippenger_state *state;
+    size_t no;
+    /* One set of buckets per task */
+    secp256k1_gej **buckets;
+    /* window_sums[i] is the contribution of window i before shifting */
+    secp256k1_gej *window_sums;
+    int *ret;
+};
+
+/* First phase of pippenger_batch_parallel: task t obtains its slice of the
+ * points from the callback and computes their wnaf. Unlike pippenger_wnaf,
+ * zero terms are not removed but get an all-zero wnaf so that every task can
+ * write to a fixed range of the state. */
+static void secp256k1_ecmult_pippenger_load_task(size_t t, void *data) {
+    const struct secp256k1_pippenger_parallel_data *par = (const struct secp256k1_pippenger_parallel_data *) data;
+    size_t n_wnaf = WNAF_SIZE(par->bucket_window+1);
+#ifdef USE_ENDOMORPHISM
+    const size_t point_entries = 2;
+#else
+    const size_t point_entries = 1;
+#endif
+    size_t point_idx = par->n_task_points * t;
+    size_t point_end = point_idx + par->n_task_points;
+    size_t idx;
+    size_t idx_end;
+
+    if (point_idx > par->n_points) {
+        point_idx = par->n_points;
+    }
+    if (point_end > par->n_points) {
+        point_end = par->n_points;
+    }
+    /* The G term is handled by the first task */
+    idx = t == 0 ? 0 : par->g_entries + point_idx * point_entries;
+    idx_end = par->g_entries + point_end * point_entries;
+
+    par->ret[t] = 1;
+    for (; point_idx < point_end; point_idx++) {
+        size_t e = par->g_entries + point_idx * point_entries;
+        if (!par->cb(&par->scalars[e], &par->points[e], point_idx + par->cb_offset, par->cbdata)) {
+            par->ret[t] = 0;
+            return;
+        }
+#ifdef USE_ENDOMORPHISM
+        secp256k1_ecmult_endo_split(&par->scalars[e], &par->scalars[e + 1], &par->points[e], &par->points[e + 1]);
+#endif
+    }
+
+    for (; idx < idx_end; idx++) {
+        par->state->ps[idx].input_pos = idx;
+        if (secp256k1_scalar_is_zero(&par->scalars[idx]) || secp256k1_ge_is_infinity(&par->points[idx])) {
+            size_t j;
+            par->state->ps[idx].skew_na = 0;
+            for (j = 0; j < n_wnaf; j++) {
+                par->state->wnaf_na[idx*n_wnaf + j] = 0;
+            }
+        } else {
+            par->state->ps[idx].skew_na = secp256k1_wnaf_fixed(&par->state->wnaf_na[idx*n_wnaf], &par->scalars[idx], par->bucket_window+1);
+        }
+    }
+}
+
+/* Second phase of pippenger_batch_parallel: task t computes the sums of
+ * windows t, t + n_tasks, t + 2*n_tasks, ... using its own set of buckets. */
+static void secp256k1_ecmult_pippenger_window_task(size_t t, void *data) {
+    const struct secp256k1_pippenger_parallel_data *par = (const struct secp256k1_pippenger_parallel_data *) data;
+    size_t n_wnaf = WNAF_SIZE(par->bucket_window+1);
+    size_t i;
+
+    for (i = t; i < n_wnaf; i += par->n_tasks) {
+        secp256k1_gej_set_infinity(&par->window_sums[i]);
+        secp256k1_ecmult_pippenger_wnaf_window(par->buckets[t], par->bucket_window, par->state, &par->window_sums[i], par->points, par->no, i);
+    }
+}
+
+/* Same as pippenger_batch, but loads the points and accumulates the windows
+ * in up to n_scratch tasks run through parallel_for. Everything except the
+ * buckets is allocated on scratch[0]; task t keeps its buckets on scratch[t].
+ * The total amount of group operations is the same as for pippenger_batch
+ * except for one addition per window. Falls back to pippenger_batch on
+ * scratch[0] if the additional memory is not available. */
+static int secp256k1_ecmult_pippenger_batch_parallel(const secp256k1_callback* error_callback, const secp256k1_ecmult_context *ctx, secp256k1_scratch *const *scratch, size_t n_scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n_points, size_t cb_offset, secp256k1_parallel_for_function parallel_for, void *parallel_data) {
+    struct secp256k1_pippenger_parallel_data par;
+    size_t scratch_checkpoint;
+    size_t *scratch_checkpoints;
+#ifdef USE_ENDOMORPHISM
+    size_t entries = 2*n_points + 2;
+#else
+    size_t entries = n_points + 1;
+#endif
+    size_t n_wnaf;
+    size_t t;
+    int i, j;
+    int ret = 1;
+
+    secp256k1_gej_set_infinity(r);
+    if (inp_g_sc == NULL && n_points == 0) {
+        return 1;
+    }
+
+    par.bucket_window = secp256k1_pippenger_bucket_window(n_points);
+    n_wnaf = WNAF_SIZE(par.bucket_window+1);
+    par.n_tasks = n_scratch < n_wnaf ? n_scratch : n_wnaf;
+    if (par.n_tasks <= 1) {
+        return secp256k1_ecmult_pippenger_batch(error_callback, ctx, scratch[0], r, inp_g_sc, cb, cbdata, n_points, cb_offset);
+    }
+
+    scratch_checkpoint = secp256k1_scratch_checkpoint(error_callback, scratch[0]);
+    scratch_checkpoints = (size_t *) secp256k1_scratch_alloc(error_callback, scratch[0], par.n_tasks * sizeof(*scratch_checkpoints));
+    if (scratch_checkpoints == NULL) {
+        return secp256k1_ecmult_pippenger_batch(error_callback, ctx, scratch[0], r, inp_g_sc, cb, cbdata, n_points, cb_offset);
+    }
+    scratch_checkpoints[0] = scratch_checkpoint;
+    for (t = 1; t < par.n_tasks; t++) {
+        scratch_checkpoints[t] = secp256k1_scratch_checkpoint(error_callback, scratch[t]);
+    }
+
+    par.points = (secp256k1_ge *) secp256k1_scratch_alloc(error_callback, scratch[0], entries * sizeof(*par.points));
+    par.scalars = (secp256k1_scalar *) secp256k1_scratch_alloc(error_callback, scratch[0], entries * sizeof(*par.scalars));
+    par.state = (struct secp256k1_pippenger_state *) secp256k1_scratch_alloc(error_callback, scratch[0], sizeof(*par.state));
+    par.buckets = (secp256k1_gej **) secp256k1_scratch_alloc(error_callback, scratch[0], par.n_tasks * sizeof(*par.buckets));
+    par.window_sums = (secp256k1_gej *) secp256k1_scratch_alloc(error_callback, scratch[0], n_wnaf * sizeof(*par.window_sums));
+    par.ret = (int *) secp256k1_scratch_alloc(error_callback, scratch[0], par.n_tasks * sizeof(*par.ret));
+    if (par.points == NULL || par.scalars == NULL || par.state == NULL || par.buckets == NULL || par.window_sums == NULL || par.ret == NULL) {
+        secp256k1_scratch_apply_checkpoint(error_callback, scratch[0], scratch_checkpoint);
+        return secp256k1_ecmult_pippenger_batch(error_callback, ctx, scratch[0], r, inp_g_sc, cb, cbdata, n_points, cb_offset);
+    }
+    par.state->ps = (struct secp256k1_pippenger_point_state *) secp256k1_scratch_alloc(error_callback, scratch[0], entries * sizeof(*par.state->ps));
+    par.state->wnaf_na = (int *) secp256k1_scratch_alloc(error_callback, scratch[0], entries * n_wnaf * sizeof(int));
+    for (t = 0; t < par.n_tasks; t++) {
+        par.buckets[t] = (secp256k1_gej *) secp256k1_scratch_alloc(error_callback, scratch[t], (1<<par.bucket_window) * sizeof(secp256k1_gej));
+        if (par.buckets[t] == NULL) {
+            break;
+        }
+    }
+    if (par.state->ps == NULL || par.state->wnaf_na == NULL || t < par.n_tasks) {
+        for (t = par.n_tasks; t > 0; t--) {
+            secp256k1_scratch_apply_checkpoint(error_callback, scratch[t - 1], scratch_checkpoints[t - 1]);
+        }
+        return secp256k1_ecmult_pippenger_batch(error_callback, ctx, scratch[0], r, inp_g_sc, cb, cbdata, n_points, cb_offset);
+    }
+
+    par.cb = cb;
+    par.cbdata = cbdata;
+    par.cb_offset = cb_offset;
+    par.n_points = n_points;
+    par.n_task_points = n_points == 0 ? 0 : 1 + (n_points - 1) / par.n_tasks;
+    par.g_entries = 0;
+    if (inp_g_sc != NULL) {
+        par.scalars[0] = *inp_g_sc;
+        par.points[0] = secp256k1_ge_const_g;
+        par.g_entries++;
+#ifdef USE_ENDOMORPHISM
+        secp256k1_ecmult_endo_split(&par.scalars[0], &par.scalars[1], &par.points[0], &par.points[1]);
+        par.g_entries++;
+#endif
+    }
+#ifdef USE_ENDOMORPHISM
+    par.no = par.g_entries + 2*n_points;
+#else
+    par.no = par.g_entries + n_points;
+#endif
+
+    secp256k1_ecmult_parallel_run(parallel_for, parallel_data, secp256k1_ecmult_pippenger_load_task, &par, par.n_tasks);
+    for (t = 0; t < par.n_tasks; t++) {
+        ret &= par.ret[t];
+    }
+
+    if (ret) {
+        secp256k1_ecmult_parallel_run(parallel_for, parallel_data, secp256k1_ecmult_pippenger_window_task, &par, par.n_tasks);
+        for (i = n_wnaf - 1; i >= 0; i--) {
+            for (j = 0; j <= par.bucket_window; j++) {
+                secp256k1_gej_double_var(r, r, NULL);
+            }
+            secp256k1_gej_add_var(r, r, &par.window_sums[i], NULL);
+        }
+    }
+
+    /* Clear data */
+    for (t = 0; t < par.no; t++) {
+        secp256k1_scalar_clear(&par.scalars[t]);
+        par.state->ps[t].skew_na = 0;
+        for (j = 0; j < (int)n_wnaf; j++) {
+            par.state->wnaf_na[t * n_wnaf + j] = 0;
+        }
+    }
+    for (t = 0; t < par.n_tasks; t++) {
+        for (i = 0; i < 1<<par.bucket_window; i++) {
+            secp256k1_gej_clear(&par.buckets[t][i]);
+        }
+    }
+    for (t = par.n_tasks; t > 0; t--) {
+        secp256k1_scratch_apply_checkpoint(error_callback, scratch[t - 1], scratch_checkpoints[t - 1]);
+    }
+    return ret;
+}
+
 /**
  * Returns the maximum number of points in addition to G that can be used with
  * a given scratch space. The function ensures that fewer points may also be
@@ -1212,4 +1930,96 @@ static int secp256k1_ecmult_multi_var(const secp256k1_callback* error_callback,
     return 1;
 }
 
+/* Wraps an ecmult_multi callback so that point idx of a task maps to point
+ * offset + idx of the whole multiplication. */
+struct secp256k1_ecmult_multi_offset_data {
+    secp256k1_ecmult_multi_callback *cb;
+    void *cbdata;
+    size_t offset;
+};
+
+static int secp256k1_ecmult_multi_offset_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data) {
+    const struct secp256k1_ecmult_multi_offset_data *offset_data = (const struct secp256k1_ecmult_multi_offset_data *) data;
+    return offset_data->cb(sc, pt, offset_data->offset + idx, offset_data->cbdata);
+}
+
+struct secp256k1_ecmult_multi_parallel_data {
+    const secp256k1_callback *error_callback;
+    const secp256k1_ecmult_context *ctx;
+    secp256k1_scratch *const *scratch;
+    const secp256k1_scalar *inp_g_sc;
+    secp256k1_ecmult_multi_callback *cb;
+    void *cbdata;
+    size_t n;
+    size_t n_task_points;
+    /* Per-task outputs */
+    secp256k1_gej *r;
+    int *ret;
+};
+
+static void secp256k1_ecmult_multi_parallel_task(size_t idx, void *data) {
+    const struct secp256k1_ecmult_multi_parallel_data *par = (const struct secp256k1_ecmult_multi_parallel_data *) data;
+    struct secp256k1_ecmult_multi_offset_data offset_data;
+    size_t n_points = 0;
+
+    offset_data.cb = par->cb;
+    offset_data.cbdata = par->cbdata;
+    offset_data.offset = par->n_task_points * idx;
+    if (offset_data.offset < par->n) {
+        n_points = par->n - offset_data.offset;
+        if (n_points > par->n_task_points) {
+            n_points = par->n_task_points;
+        }
+    }
+    par->ret[idx] = secp256k1_ecmult_multi_var(par->error_callback, par->ctx, par->scratch[idx], &par->r[idx], idx == 0 ? par->inp_g_sc : NULL, secp256k1_ecmult_multi_offset_callback, &offset_data, n_points);
+}
+
+static int secp256k1_ecmult_multi_var_parallel(const secp256k1_callback* error_callback, const secp256k1_ecmult_context *ctx, secp256k1_scratch *const *scratch, size_t n_scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n, secp256k1_parallel_for_function parallel_for, void *parallel_data) {
+    struct secp256k1_ecmult_multi_parallel_data par;
+    size_t n_tasks;
+    size_t i;
+    size_t scratch_checkpoint;
+    int ret = 1;
+
+    VERIFY_CHECK(n_scratch > 0);
+    n_tasks = n / ECMULT_PARALLEL_MIN_POINTS;
+    if (n_tasks > n_scratch) {
+        n_tasks = n_scratch;
+    }
+    if (n_tasks <= 1) {
+        return secp256k1_ecmult_multi_var(error_callback, ctx, scratch[0], r, inp_g_sc, cb, cbdata, n);
+    }
+    /* If all points fit into a single Pippenger batch, parallelize within that
+     * batch. Unlike splitting the points this does not increase the total work. */
+    if (n >= ECMULT_PIPPENGER_THRESHOLD && n <= ECMULT_MAX_POINTS_PER_BATCH && secp256k1_pippenger_max_points(error_callback, scratch[0]) >= n) {
+        return secp256k1_ecmult_pippenger_batch_parallel(error_callback, ctx, scratch, n_scratch, r, inp_g_sc, cb, cbdata, n, 0, parallel_for, parallel_data);
+    }
+
+    scratch_checkpoint = secp256k1_scratch_checkpoint(error_callback, scratch[0]);
+    par.r = (secp256k1_gej*)secp256k1_scratch_alloc(error_callback, scratch[0], n_tasks * sizeof(secp256k1_gej));
+    par.ret = (int*)secp256k1_scratch_alloc(error_callback, scratch[0], n_tasks * sizeof(int));
+    if (par.r == NULL || par.ret == NULL) {
+        secp256k1_scratch_apply_checkpoint(error_callback, scratch[0], scratch_checkpoint);
+        return secp256k1_ecmult_multi_var(error_callback, ctx, scratch[0], r, inp_g_sc, cb, cbdata, n);
+    }
+    par.error_callback = error_callback;
+    par.ctx = ctx;
+    par.scratch = scratch;
+    par.inp_g_sc = inp_g_sc;
+    par.cb = cb;
+    par.cbdata = cbdata;
+    par.n = n;
+    par.n_task_points = 1 + (n - 1) / n_tasks;
+
+    secp256k1_ecmult_parallel_run(parallel_for, parallel_data, secp256k1_ecmult_multi_parallel_task, &par, n_tasks);
+
+    secp256k1_gej_set_infinity(r);
+    for (i = 0; i < n_tasks; i++) {
+        ret &= par.ret[i];
+        secp256k1_gej_add_var(r, r, &par.r[i], NULL);
+    }
+    secp256k1_scratch_apply_checkpoint(error_callback, scratch[0], scratch_checkpoint);
+    return ret;
+}
+
 #endif /* SECP256K1_ECMULT_IMPL_H */
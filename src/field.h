@@ -105,6 +105,11 @@ static int secp256k1_fe_sqrt(secp256k1_fe *r, const secp256k1_fe *a);
 /** Checks whether a field element is a quadratic residue. */
 static int secp256k1_fe_is_quad_var(const secp256k1_fe *a);
 
+/** Returns 1 if a is a quadratic residue (including 0), -1 if it is not, or 0 if
+ *  this could not be determined, which is extremely rare for random inputs.
+ *  Variable time. */
+static int secp256k1_fe_jacobi_maybe_var(const secp256k1_fe *a);
+
 /** Sets a field element to be the (modular) inverse of another. Requires the input's magnitude to be
  *  at most 8. The output magnitude is 1 (but not guaranteed to be normalized). */
 static void secp256k1_fe_inv(secp256k1_fe *r, const secp256k1_fe *a);
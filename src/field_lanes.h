@@ -0,0 +1,85 @@
+/**********************************************************************
+ * Copyright (c) 2020 the libsecp256k1 contributors                   *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef SECP256K1_FIELD_LANES_H
+#define SECP256K1_FIELD_LANES_H
+
+#include "field.h"
+
+/** Lane-parallel field arithmetic.
+ *
+ *  A secp256k1_fe_lanes holds SECP256K1_FE_LANES independent field elements,
+ *  interleaved so that limb i of lane l is n[i][l]. Every lane uses the 10x26
+ *  representation (independently of the field implementation selected for
+ *  secp256k1_fe), with each limb in its own 64-bit slot so that a vector unit
+ *  can process the same limb of all lanes at once. Magnitudes follow the rules
+ *  of the 10x26 implementation and are not tracked.
+ *
+ *  Multiplication and squaring use the fastest of the following engines that
+ *  the CPU supports, as returned by secp256k1_fe_lanes_engine:
+ *  - portable: plain C loops over the lanes;
+ *  - AVX-512 IFMA: 52x52->104 bit vector multiply-adds on 52-bit limbs.
+ *  Both engines compute the same field element, but not necessarily the same
+ *  representation of it.
+ */
+
+#define SECP256K1_FE_LANES 4
+
+typedef struct {
+    uint64_t n[10][SECP256K1_FE_LANES];
+} secp256k1_fe_lanes;
+
+#define SECP256K1_FE_LANES_PORTABLE 0
+#define SECP256K1_FE_LANES_IFMA 1
+
+/** Returns whether the library includes the given engine and the CPU supports it. */
+static int secp256k1_fe_lanes_engine_supported(int engine);
+
+/** Returns the engine used by secp256k1_fe_lanes_mul and secp256k1_fe_lanes_sqr: the
+ *  fastest supported one. */
+static int secp256k1_fe_lanes_engine(void);
+
+/** Returns whether the engine in use makes the lane-parallel code faster than processing
+ *  the elements one by one. */
+static int secp256k1_fe_lanes_accelerated(void);
+
+/** Set lane l of r to a (magnitude at most 8). The other lanes are not modified. */
+static void secp256k1_fe_lanes_set_fe(secp256k1_fe_lanes *r, int l, const secp256k1_fe *a);
+
+/** Set all lanes of r to a (magnitude at most 8). */
+static void secp256k1_fe_lanes_set_all(secp256k1_fe_lanes *r, const secp256k1_fe *a);
+
+/** Get lane l of a (magnitude at most 8). The result has magnitude 1. */
+static void secp256k1_fe_lanes_get_fe(secp256k1_fe *r, const secp256k1_fe_lanes *a, int l);
+
+/** Weakly normalize all lanes: reduce their magnitude to 1. */
+static void secp256k1_fe_lanes_normalize_weak(secp256k1_fe_lanes *r);
+
+/** For each lane, set zero[l] to whether it would normalize to zero (constant time). */
+static void secp256k1_fe_lanes_normalizes_to_zero(int *zero, const secp256k1_fe_lanes *r);
+
+/** Set r to -a, where a has magnitude at most m. The result has magnitude m+1. */
+static void secp256k1_fe_lanes_negate(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, int m);
+
+/** Multiply all lanes by a small integer. The magnitude is multiplied by a. */
+static void secp256k1_fe_lanes_mul_int(secp256k1_fe_lanes *r, int a);
+
+/** Add a to r. The magnitudes add up. */
+static void secp256k1_fe_lanes_add(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a);
+
+/** Set r = a*b, lane by lane. Inputs have magnitude at most 8, the output has magnitude 1.
+ *  r may alias a or b. */
+static void secp256k1_fe_lanes_mul(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, const secp256k1_fe_lanes *b);
+
+/** Set r = a^2, lane by lane. The input has magnitude at most 8, the output has magnitude 1.
+ *  r may alias a. */
+static void secp256k1_fe_lanes_sqr(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a);
+
+/** For each lane l with flag[l] equal to 1, replace lane l of r with lane l of a (constant time).
+ *  Every flag must be 0 or 1. */
+static void secp256k1_fe_lanes_cmov(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, const int *flag);
+
+#endif /* SECP256K1_FIELD_LANES_H */
@@ -0,0 +1,446 @@
+/**********************************************************************
+ * Copyright (c) 2020 the libsecp256k1 contributors                   *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef SECP256K1_FIELD_LANES_IMPL_H
+#define SECP256K1_FIELD_LANES_IMPL_H
+
+#if defined HAVE_CONFIG_H
+#include "libsecp256k1-config.h"
+#endif
+
+#include "util.h"
+#include "field_lanes.h"
+
+#if defined(USE_FIELD_LANES_IFMA)
+#include <immintrin.h>
+#endif
+
+#ifdef VERIFY
+/* Engine forced by the tests, or -1 to use the fastest supported one. */
+static int secp256k1_fe_lanes_engine_override = -1;
+#endif
+
+static int secp256k1_fe_lanes_engine_supported(int engine) {
+#if defined(USE_FIELD_LANES_IFMA)
+    /* __builtin_cpu_supports also requires the OS to save the AVX-512 registers. */
+    if (engine == SECP256K1_FE_LANES_IFMA) {
+        return __builtin_cpu_supports("avx512ifma") && __builtin_cpu_supports("avx512vl");
+    }
+#endif
+    return engine == SECP256K1_FE_LANES_PORTABLE;
+}
+
+static int secp256k1_fe_lanes_engine(void) {
+#ifdef VERIFY
+    if (secp256k1_fe_lanes_engine_override >= 0) {
+        return secp256k1_fe_lanes_engine_override;
+    }
+#endif
+    if (secp256k1_fe_lanes_engine_supported(SECP256K1_FE_LANES_IFMA)) {
+        return SECP256K1_FE_LANES_IFMA;
+    }
+    return SECP256K1_FE_LANES_PORTABLE;
+}
+
+/* Attribute for copies of code built on the lane operations, with everything it calls
+ * inlined and compiled for AVX-512, so that the lane loops of the operations other than
+ * secp256k1_fe_lanes_mul and secp256k1_fe_lanes_sqr are vectorized as well. Callers pick
+ * the copy matching secp256k1_fe_lanes_engine. */
+#if defined(USE_FIELD_LANES_IFMA)
+/* Without prefer-vector-width=256 the compiler moves the lanes around in 512-bit
+ * registers, which is much slower on current CPUs. */
+#define SECP256K1_FE_LANES_IFMA_CLONE __attribute__((target("avx2,avx512f,avx512vl,avx512ifma,prefer-vector-width=256"), flatten))
+#endif
+
+static int secp256k1_fe_lanes_accelerated(void) {
+    return secp256k1_fe_lanes_engine() == SECP256K1_FE_LANES_IFMA;
+}
+
+static void secp256k1_fe_lanes_set_fe(secp256k1_fe_lanes *r, int l, const secp256k1_fe *a) {
+    secp256k1_fe t = *a;
+    int i;
+    secp256k1_fe_normalize_weak(&t);
+#if defined(USE_FIELD_10X26)
+    for (i = 0; i < 10; i++) {
+        r->n[i][l] = t.n[i];
+    }
+#else
+    for (i = 0; i < 5; i++) {
+        r->n[2 * i][l] = t.n[i] & 0x3FFFFFFUL;
+        r->n[2 * i + 1][l] = t.n[i] >> 26;
+    }
+#endif
+}
+
+static void secp256k1_fe_lanes_set_all(secp256k1_fe_lanes *r, const secp256k1_fe *a) {
+    int l;
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        secp256k1_fe_lanes_set_fe(r, l, a);
+    }
+}
+
+static void secp256k1_fe_lanes_get_fe(secp256k1_fe *r, const secp256k1_fe_lanes *a, int l) {
+    uint64_t t[10], x;
+    int i;
+    for (i = 0; i < 10; i++) {
+        t[i] = a->n[i][l];
+    }
+    x = t[9] >> 22;
+    t[9] &= 0x03FFFFFUL;
+    t[0] += x * 0x3D1UL;
+    t[1] += (x << 6);
+    for (i = 0; i < 9; i++) {
+        t[i + 1] += t[i] >> 26;
+        t[i] &= 0x3FFFFFFUL;
+    }
+#if defined(USE_FIELD_10X26)
+    for (i = 0; i < 10; i++) {
+        r->n[i] = (uint32_t)t[i];
+    }
+#else
+    for (i = 0; i < 5; i++) {
+        r->n[i] = t[2 * i] | (t[2 * i + 1] << 26);
+    }
+#endif
+#ifdef VERIFY
+    r->magnitude = 1;
+    r->normalized = 0;
+    secp256k1_fe_verify(r);
+#endif
+}
+
+/* The remaining operations loop over the lanes innermost, so that the compiler can
+ * vectorize them when they are inlined into code compiled for a vector target (see
+ * SECP256K1_FE_LANES_IFMA_CLONE). The multiplications by small constants are written
+ * as 32x32->64 bit products, which AVX2 supports. */
+
+SECP256K1_INLINE static void secp256k1_fe_lanes_normalize_weak(secp256k1_fe_lanes *r) {
+    uint32_t x[SECP256K1_FE_LANES];
+    int i, l;
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        /* Below 2^32 for magnitudes up to 2^13 */
+        x[l] = r->n[9][l] >> 22;
+        r->n[9][l] &= 0x03FFFFFUL;
+        r->n[0][l] += (uint64_t)x[l] * 0x3D1UL;
+        r->n[1][l] += (uint64_t)x[l] << 6;
+    }
+    for (i = 0; i < 9; i++) {
+        for (l = 0; l < SECP256K1_FE_LANES; l++) {
+            r->n[i + 1][l] += r->n[i][l] >> 26;
+            r->n[i][l] &= 0x3FFFFFFUL;
+        }
+    }
+}
+
+SECP256K1_INLINE static void secp256k1_fe_lanes_normalizes_to_zero(int *zero, const secp256k1_fe_lanes *r) {
+    secp256k1_fe_lanes t = *r;
+    /* z0 tracks a possible raw value of 0, z1 tracks a possible raw value of P */
+    uint64_t z0[SECP256K1_FE_LANES], z1[SECP256K1_FE_LANES];
+    int i, l;
+    secp256k1_fe_lanes_normalize_weak(&t);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        z0[l] = t.n[0][l] | t.n[1][l] | t.n[9][l];
+        z1[l] = (t.n[0][l] ^ 0x3D0UL) & (t.n[1][l] ^ 0x40UL) & (t.n[9][l] ^ 0x3C00000UL);
+    }
+    for (i = 2; i < 9; i++) {
+        for (l = 0; l < SECP256K1_FE_LANES; l++) {
+            z0[l] |= t.n[i][l];
+            z1[l] &= t.n[i][l];
+        }
+    }
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        zero[l] = (z0[l] == 0) | (z1[l] == 0x3FFFFFFUL);
+    }
+}
+
+SECP256K1_INLINE static void secp256k1_fe_lanes_negate(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, int m) {
+    uint64_t f = 2 * (m + 1);
+    int i, l;
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        r->n[0][l] = 0x3FFFC2FUL * f - a->n[0][l];
+        r->n[1][l] = 0x3FFFFBFUL * f - a->n[1][l];
+        r->n[9][l] = 0x03FFFFFUL * f - a->n[9][l];
+    }
+    for (i = 2; i < 9; i++) {
+        for (l = 0; l < SECP256K1_FE_LANES; l++) {
+            r->n[i][l] = 0x3FFFFFFUL * f - a->n[i][l];
+        }
+    }
+}
+
+SECP256K1_INLINE static void secp256k1_fe_lanes_mul_int(secp256k1_fe_lanes *r, int a) {
+    int i, l;
+    for (i = 0; i < 10; i++) {
+        for (l = 0; l < SECP256K1_FE_LANES; l++) {
+            /* Limbs stay below 2^32 for the magnitudes used */
+            r->n[i][l] = (uint64_t)(uint32_t)r->n[i][l] * (uint32_t)a;
+        }
+    }
+}
+
+SECP256K1_INLINE static void secp256k1_fe_lanes_add(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a) {
+    int i, l;
+    for (i = 0; i < 10; i++) {
+        for (l = 0; l < SECP256K1_FE_LANES; l++) {
+            r->n[i][l] += a->n[i][l];
+        }
+    }
+}
+
+SECP256K1_INLINE static void secp256k1_fe_lanes_cmov(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, const int *flag) {
+    uint64_t mask0[SECP256K1_FE_LANES];
+    int i, l;
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        mask0[l] = (uint64_t)flag[l] + ~((uint64_t)0);
+    }
+    for (i = 0; i < 10; i++) {
+        for (l = 0; l < SECP256K1_FE_LANES; l++) {
+            r->n[i][l] = (r->n[i][l] & mask0[l]) | (a->n[i][l] & ~mask0[l]);
+        }
+    }
+}
+
+/* The portable engine computes the 19 columns p[k] = sum(a[i]*b[j], i+j=k) of
+ * 26-bit limb products (for magnitude 8 inputs the limbs are below 2^30 and every column
+ * fits in 64 bits), and reduces them with the following sequence of operations:
+ * - carry the columns so that p[0..18] are 26-bit and p[19] holds the excess;
+ * - fold column k+10 (weight 2^260 * 2^(26k)) into columns k and k+1 using
+ *   2^260 = 0x3D10 + 2^10 * 2^26 (mod p), which leaves a small multiple of 2^260
+ *   coming from p[19] that is folded the same way once more;
+ * - carry again, and fold the bits above 2^256 using 2^256 = 0x3D1 + 2^6 * 2^26.
+ * The result has magnitude 1. */
+
+static void secp256k1_fe_lanes_reduce_portable(secp256k1_fe_lanes *r, int l, uint64_t *p) {
+    const uint64_t M = 0x3FFFFFFUL, R0 = 0x3D10UL;
+    uint64_t t[10], w, x;
+    int k;
+    for (k = 0; k < 18; k++) {
+        p[k + 1] += p[k] >> 26;
+        p[k] &= M;
+    }
+    p[19] = p[18] >> 26;
+    p[18] &= M;
+    t[0] = p[0] + p[10] * R0;
+    for (k = 1; k < 10; k++) {
+        t[k] = p[k] + p[k + 10] * R0 + (p[k + 9] << 10);
+    }
+    w = p[19] << 10;
+    x = w >> 26;
+    w &= M;
+    t[0] += w * R0;
+    t[1] += (w << 10) + x * R0;
+    t[2] += x << 10;
+    for (k = 0; k < 9; k++) {
+        t[k + 1] += t[k] >> 26;
+        t[k] &= M;
+    }
+    x = t[9] >> 22;
+    t[9] &= 0x03FFFFFUL;
+    t[0] += x * 0x3D1UL;
+    t[1] += x << 6;
+    t[1] += t[0] >> 26;
+    t[0] &= M;
+    for (k = 0; k < 10; k++) {
+        r->n[k][l] = t[k];
+    }
+}
+
+static void secp256k1_fe_lanes_mul_portable(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, const secp256k1_fe_lanes *b) {
+    uint64_t p[20];
+    int i, k, l;
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        for (k = 0; k < 19; k++) {
+            p[k] = 0;
+            for (i = (k < 10 ? 0 : k - 9); i <= k && i < 10; i++) {
+                p[k] += a->n[i][l] * b->n[k - i][l];
+            }
+        }
+        secp256k1_fe_lanes_reduce_portable(r, l, p);
+    }
+}
+
+static void secp256k1_fe_lanes_sqr_portable(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a) {
+    uint64_t p[20];
+    int i, k, l;
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        for (k = 0; k < 19; k++) {
+            p[k] = (k & 1) ? 0 : a->n[k / 2][l] * a->n[k / 2][l];
+            for (i = (k < 10 ? 0 : k - 9); 2 * i < k; i++) {
+                p[k] += (a->n[i][l] * 2) * a->n[k - i][l];
+            }
+        }
+        secp256k1_fe_lanes_reduce_portable(r, l, p);
+    }
+}
+
+#if defined(USE_FIELD_LANES_IFMA)
+/* The IFMA engine regroups pairs of 26-bit limbs into 5 limbs of 52 bits (the top one of
+ * 48 bits), so that each 52x52 bit product takes two multiply-adds (madd52lo for the low
+ * 52 bits and madd52hi for the high 52 bits) instead of four 32x32 bit products. The
+ * 10 product columns are reduced with 2^260 = 0x1000003D10 (mod p) and converted back to
+ * 26-bit limbs of magnitude 1. */
+
+/* c += the low or high 52 bits of the 104-bit product x*y of 52-bit lanes */
+#define madd52lo(c, x, y) c = _mm256_madd52lo_epu64(c, x, y)
+#define madd52hi(c, x, y) c = _mm256_madd52hi_epu64(c, x, y)
+
+__attribute__((target("avx512ifma,avx512vl")))
+static void secp256k1_fe_lanes_to_52_ifma(__m256i *A, const secp256k1_fe_lanes *a) {
+    const __m256i M52 = _mm256_set1_epi64x(0xFFFFFFFFFFFFFULL), M48 = _mm256_set1_epi64x(0xFFFFFFFFFFFFULL);
+    const __m256i K = _mm256_set1_epi64x(0x1000003D1ULL);
+    __m256i t;
+    int i;
+    for (i = 0; i < 5; i++) {
+        A[i] = _mm256_add_epi64(_mm256_loadu_si256((const __m256i *)a->n[2 * i]),
+                                _mm256_slli_epi64(_mm256_loadu_si256((const __m256i *)a->n[2 * i + 1]), 26));
+    }
+    for (i = 0; i < 4; i++) {
+        A[i + 1] = _mm256_add_epi64(A[i + 1], _mm256_srli_epi64(A[i], 52));
+        A[i] = _mm256_and_si256(A[i], M52);
+    }
+    t = _mm256_srli_epi64(A[4], 48);
+    A[4] = _mm256_and_si256(A[4], M48);
+    A[0] = _mm256_madd52lo_epu64(A[0], t, K);
+    for (i = 0; i < 4; i++) {
+        A[i + 1] = _mm256_add_epi64(A[i + 1], _mm256_srli_epi64(A[i], 52));
+        A[i] = _mm256_and_si256(A[i], M52);
+    }
+}
+
+__attribute__((target("avx512ifma,avx512vl")))
+static void secp256k1_fe_lanes_reduce_ifma(secp256k1_fe_lanes *r, __m256i *C) {
+    const __m256i M52 = _mm256_set1_epi64x(0xFFFFFFFFFFFFFULL), M48 = _mm256_set1_epi64x(0xFFFFFFFFFFFFULL);
+    const __m256i M26 = _mm256_set1_epi64x(0x3FFFFFF);
+    const __m256i R = _mm256_set1_epi64x(0x1000003D10ULL), K = _mm256_set1_epi64x(0x1000003D1ULL);
+    __m256i T[5], s;
+    int k;
+    for (k = 0; k < 9; k++) {
+        C[k + 1] = _mm256_add_epi64(C[k + 1], _mm256_srli_epi64(C[k], 52));
+        C[k] = _mm256_and_si256(C[k], M52);
+    }
+    /* C[9] is below 2^47, so C[9]*R only spills into one more 52-bit limb. */
+    for (k = 0; k < 5; k++) {
+        T[k] = _mm256_madd52lo_epu64(C[k], C[k + 5], R);
+    }
+    for (k = 0; k < 4; k++) {
+        T[k + 1] = _mm256_madd52hi_epu64(T[k + 1], C[k + 5], R);
+    }
+    s = _mm256_madd52hi_epu64(_mm256_setzero_si256(), C[9], R);
+    T[0] = _mm256_madd52lo_epu64(T[0], s, R);
+    T[1] = _mm256_madd52hi_epu64(T[1], s, R);
+    for (k = 0; k < 4; k++) {
+        T[k + 1] = _mm256_add_epi64(T[k + 1], _mm256_srli_epi64(T[k], 52));
+        T[k] = _mm256_and_si256(T[k], M52);
+    }
+    s = _mm256_srli_epi64(T[4], 48);
+    T[4] = _mm256_and_si256(T[4], M48);
+    T[0] = _mm256_madd52lo_epu64(T[0], s, K);
+    for (k = 0; k < 5; k++) {
+        _mm256_storeu_si256((__m256i *)r->n[2 * k], _mm256_and_si256(T[k], M26));
+        _mm256_storeu_si256((__m256i *)r->n[2 * k + 1], _mm256_srli_epi64(T[k], 26));
+    }
+}
+
+__attribute__((target("avx512ifma,avx512vl")))
+static void secp256k1_fe_lanes_mul_ifma(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, const secp256k1_fe_lanes *b) {
+    __m256i A[5], B[5], C[10];
+    secp256k1_fe_lanes_to_52_ifma(A, a);
+    secp256k1_fe_lanes_to_52_ifma(B, b);
+    /* Column k collects the low halves of the products of weight k and the high halves
+     * of those of weight k-1. */
+    C[0] = _mm256_setzero_si256();
+    madd52lo(C[0], A[0], B[0]);
+    C[1] = _mm256_setzero_si256();
+    madd52lo(C[1], A[0], B[1]); madd52lo(C[1], A[1], B[0]); madd52hi(C[1], A[0], B[0]);
+    C[2] = _mm256_setzero_si256();
+    madd52lo(C[2], A[0], B[2]); madd52lo(C[2], A[1], B[1]); madd52lo(C[2], A[2], B[0]);
+    madd52hi(C[2], A[0], B[1]); madd52hi(C[2], A[1], B[0]);
+    C[3] = _mm256_setzero_si256();
+    madd52lo(C[3], A[0], B[3]); madd52lo(C[3], A[1], B[2]); madd52lo(C[3], A[2], B[1]);
+    madd52lo(C[3], A[3], B[0]); madd52hi(C[3], A[0], B[2]); madd52hi(C[3], A[1], B[1]);
+    madd52hi(C[3], A[2], B[0]);
+    C[4] = _mm256_setzero_si256();
+    madd52lo(C[4], A[0], B[4]); madd52lo(C[4], A[1], B[3]); madd52lo(C[4], A[2], B[2]);
+    madd52lo(C[4], A[3], B[1]); madd52lo(C[4], A[4], B[0]); madd52hi(C[4], A[0], B[3]);
+    madd52hi(C[4], A[1], B[2]); madd52hi(C[4], A[2], B[1]); madd52hi(C[4], A[3], B[0]);
+    C[5] = _mm256_setzero_si256();
+    madd52lo(C[5], A[1], B[4]); madd52lo(C[5], A[2], B[3]); madd52lo(C[5], A[3], B[2]);
+    madd52lo(C[5], A[4], B[1]); madd52hi(C[5], A[0], B[4]); madd52hi(C[5], A[1], B[3]);
+    madd52hi(C[5], A[2], B[2]); madd52hi(C[5], A[3], B[1]); madd52hi(C[5], A[4], B[0]);
+    C[6] = _mm256_setzero_si256();
+    madd52lo(C[6], A[2], B[4]); madd52lo(C[6], A[3], B[3]); madd52lo(C[6], A[4], B[2]);
+    madd52hi(C[6], A[1], B[4]); madd52hi(C[6], A[2], B[3]); madd52hi(C[6], A[3], B[2]);
+    madd52hi(C[6], A[4], B[1]);
+    C[7] = _mm256_setzero_si256();
+    madd52lo(C[7], A[3], B[4]); madd52lo(C[7], A[4], B[3]); madd52hi(C[7], A[2], B[4]);
+    madd52hi(C[7], A[3], B[3]); madd52hi(C[7], A[4], B[2]);
+    C[8] = _mm256_setzero_si256();
+    madd52lo(C[8], A[4], B[4]); madd52hi(C[8], A[3], B[4]); madd52hi(C[8], A[4], B[3]);
+    C[9] = _mm256_setzero_si256();
+    madd52hi(C[9], A[4], B[4]);
+    secp256k1_fe_lanes_reduce_ifma(r, C);
+}
+
+__attribute__((target("avx512ifma,avx512vl")))
+static void secp256k1_fe_lanes_sqr_ifma(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a) {
+    __m256i A[5], C[10];
+    secp256k1_fe_lanes_to_52_ifma(A, a);
+    /* As in secp256k1_fe_lanes_mul_ifma, but the products of distinct limbs are
+     * accumulated once and doubled before the squares are added. */
+    C[0] = _mm256_setzero_si256();
+    madd52lo(C[0], A[0], A[0]);
+    C[1] = _mm256_setzero_si256();
+    madd52lo(C[1], A[0], A[1]); C[1] = _mm256_slli_epi64(C[1], 1); madd52hi(C[1], A[0], A[0]);
+    C[2] = _mm256_setzero_si256();
+    madd52lo(C[2], A[0], A[2]); madd52hi(C[2], A[0], A[1]); C[2] = _mm256_slli_epi64(C[2], 1);
+    madd52lo(C[2], A[1], A[1]);
+    C[3] = _mm256_setzero_si256();
+    madd52lo(C[3], A[0], A[3]); madd52lo(C[3], A[1], A[2]); madd52hi(C[3], A[0], A[2]);
+    C[3] = _mm256_slli_epi64(C[3], 1); madd52hi(C[3], A[1], A[1]);
+    C[4] = _mm256_setzero_si256();
+    madd52lo(C[4], A[0], A[4]); madd52lo(C[4], A[1], A[3]); madd52hi(C[4], A[0], A[3]);
+    madd52hi(C[4], A[1], A[2]); C[4] = _mm256_slli_epi64(C[4], 1); madd52lo(C[4], A[2], A[2]);
+    C[5] = _mm256_setzero_si256();
+    madd52lo(C[5], A[1], A[4]); madd52lo(C[5], A[2], A[3]); madd52hi(C[5], A[0], A[4]);
+    madd52hi(C[5], A[1], A[3]); C[5] = _mm256_slli_epi64(C[5], 1); madd52hi(C[5], A[2], A[2]);
+    C[6] = _mm256_setzero_si256();
+    madd52lo(C[6], A[2], A[4]); madd52hi(C[6], A[1], A[4]); madd52hi(C[6], A[2], A[3]);
+    C[6] = _mm256_slli_epi64(C[6], 1); madd52lo(C[6], A[3], A[3]);
+    C[7] = _mm256_setzero_si256();
+    madd52lo(C[7], A[3], A[4]); madd52hi(C[7], A[2], A[4]); C[7] = _mm256_slli_epi64(C[7], 1);
+    madd52hi(C[7], A[3], A[3]);
+    C[8] = _mm256_setzero_si256();
+    madd52hi(C[8], A[3], A[4]); C[8] = _mm256_slli_epi64(C[8], 1); madd52lo(C[8], A[4], A[4]);
+    C[9] = _mm256_setzero_si256();
+    madd52hi(C[9], A[4], A[4]);
+    secp256k1_fe_lanes_reduce_ifma(r, C);
+}
+
+#undef madd52lo
+#undef madd52hi
+#endif
+
+static void secp256k1_fe_lanes_mul(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a, const secp256k1_fe_lanes *b) {
+#if defined(USE_FIELD_LANES_IFMA)
+    if (secp256k1_fe_lanes_engine() == SECP256K1_FE_LANES_IFMA) {
+        secp256k1_fe_lanes_mul_ifma(r, a, b);
+        return;
+    }
+#endif
+    secp256k1_fe_lanes_mul_portable(r, a, b);
+}
+
+static void secp256k1_fe_lanes_sqr(secp256k1_fe_lanes *r, const secp256k1_fe_lanes *a) {
+#if defined(USE_FIELD_LANES_IFMA)
+    if (secp256k1_fe_lanes_engine() == SECP256K1_FE_LANES_IFMA) {
+        secp256k1_fe_lanes_sqr_ifma(r, a);
+        return;
+    }
+#endif
+    secp256k1_fe_lanes_sqr_portable(r, a);
+}
+
+#endif /* SECP256K1_FIELD_LANES_IMPL_H */
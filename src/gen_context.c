@@ -26,14 +26,18 @@ static const secp256k1_callback default_error_callback = {
 };
 
 int main(int argc, char **argv) {
-    secp256k1_ecmult_gen_context ctx;
-    void *prealloc, *base;
+    secp256k1_ge_storage* table;
+    int blocks, teeth, spacing, points;
     int inner;
     int outer;
     FILE* fp;
 
-    (void)argc;
-    (void)argv;
+    if (argc != 3 || (blocks = atoi(argv[1])) < 1 || blocks > 256 || (teeth = atoi(argv[2])) < 1 || teeth > 8) {
+        fprintf(stderr, "Usage: %s <comb blocks in [1..256]> <comb teeth in [1..8]>\n", argv[0]);
+        return -1;
+    }
+    spacing = (256 + blocks * teeth - 1) / (blocks * teeth);
+    points = 1 << (teeth - 1);
 
     fp = fopen("src/ecmult_static_context.h","w");
     if (fp == NULL) {
@@ -44,32 +48,31 @@ int main(int argc, char **argv) {
     fprintf(fp, "#ifndef _SECP256K1_ECMULT_STATIC_CONTEXT_\n");
     fprintf(fp, "#define _SECP256K1_ECMULT_STATIC_CONTEXT_\n");
     fprintf(fp, "#include \"src/group.h\"\n");
+    fprintf(fp, "#define SECP256K1_ECMULT_STATIC_CONTEXT_BLOCKS %d\n", blocks);
+    fprintf(fp, "#define SECP256K1_ECMULT_STATIC_CONTEXT_TEETH %d\n", teeth);
     fprintf(fp, "#define SC SECP256K1_GE_STORAGE_CONST\n");
-    fprintf(fp, "static const secp256k1_ge_storage secp256k1_ecmult_static_context[64][16] = {\n");
+    fprintf(fp, "static const secp256k1_ge_storage secp256k1_ecmult_static_context[%d][%d] = {\n", blocks, points);
 
-    base = checked_malloc(&default_error_callback, SECP256K1_ECMULT_GEN_CONTEXT_PREALLOCATED_SIZE);
-    prealloc = base;
-    secp256k1_ecmult_gen_context_init(&ctx);
-    secp256k1_ecmult_gen_context_build(&ctx, &prealloc);
-    for(outer = 0; outer != 64; outer++) {
+    table = (secp256k1_ge_storage *)checked_malloc(&default_error_callback, blocks * points * sizeof(secp256k1_ge_storage));
+    secp256k1_ecmult_gen_compute_table(table, &secp256k1_ge_const_g, blocks, teeth, spacing);
+    for(outer = 0; outer != blocks; outer++) {
         fprintf(fp,"{\n");
-        for(inner = 0; inner != 16; inner++) {
-            fprintf(fp,"    SC(%uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu)", SECP256K1_GE_STORAGE_CONST_GET((*ctx.prec)[outer][inner]));
-            if (inner != 15) {
+        for(inner = 0; inner != points; inner++) {
+            fprintf(fp,"    SC(%uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu)", SECP256K1_GE_STORAGE_CONST_GET(table[outer * points + inner]));
+            if (inner != points - 1) {
                 fprintf(fp,",\n");
             } else {
                 fprintf(fp,"\n");
             }
         }
-        if (outer != 63) {
+        if (outer != blocks - 1) {
             fprintf(fp,"},\n");
         } else {
             fprintf(fp,"}\n");
         }
     }
     fprintf(fp,"};\n");
-    secp256k1_ecmult_gen_context_clear(&ctx);
-    free(base);
+    free(table);
 
     fprintf(fp, "#undef SC\n");
     fprintf(fp, "#endif\n");
@@ -0,0 +1,91 @@
+/**********************************************************************
+ * Copyright (c) 2020 the libsecp256k1 contributors                   *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#define USE_BASIC_CONFIG 1
+
+#include "basic-config.h"
+#include "include/secp256k1.h"
+#include "util.h"
+#include "field_impl.h"
+#include "scalar_impl.h"
+#include "group_impl.h"
+#include "scratch_impl.h"
+#include "ecmult_impl.h"
+
+static void default_error_callback_fn(const char* str, void* data) {
+    (void)data;
+    fprintf(stderr, "[libsecp256k1] internal consistency check failed: %s\n", str);
+    abort();
+}
+
+static const secp256k1_callback default_error_callback = {
+    default_error_callback_fn,
+    NULL
+};
+
+static void print_table(FILE *fp, const char *name, int window_g, const secp256k1_gej *gen) {
+    int j;
+    int n = ECMULT_TABLE_SIZE(window_g);
+    secp256k1_ge_storage *table = (secp256k1_ge_storage *)checked_malloc(&default_error_callback, n * sizeof(secp256k1_ge_storage));
+
+    secp256k1_ecmult_odd_multiples_table_storage_var(n, table, gen);
+
+    fprintf(fp, "static const secp256k1_ge_storage %s[%d] = {\n", name, n);
+    for (j = 0; j < n; j++) {
+        fprintf(fp,"    SC(%uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu)", SECP256K1_GE_STORAGE_CONST_GET(table[j]));
+        if (j != n - 1) {
+            fprintf(fp,",\n");
+        } else {
+            fprintf(fp,"\n");
+        }
+    }
+    fprintf(fp,"};\n");
+    free(table);
+}
+
+int main(int argc, char **argv) {
+    secp256k1_gej gj;
+    secp256k1_gej g_128j;
+    int window_g;
+    int i;
+    FILE* fp;
+
+    if (argc != 2 || (window_g = atoi(argv[1])) < 2 || window_g > 24) {
+        fprintf(stderr, "Usage: %s <ecmult window size in [2..24]>\n", argv[0]);
+        return -1;
+    }
+
+    fp = fopen("src/ecmult_static_pre_g.h","w");
+    if (fp == NULL) {
+        fprintf(stderr, "Could not open src/ecmult_static_pre_g.h for writing!\n");
+        return -1;
+    }
+
+    fprintf(fp, "#ifndef _SECP256K1_ECMULT_STATIC_PRE_G_\n");
+    fprintf(fp, "#define _SECP256K1_ECMULT_STATIC_PRE_G_\n");
+    fprintf(fp, "#include \"src/group.h\"\n");
+    fprintf(fp, "#define SECP256K1_ECMULT_STATIC_PRE_G_WINDOW %d\n", window_g);
+    fprintf(fp, "#define SC SECP256K1_GE_STORAGE_CONST\n");
+
+    secp256k1_gej_set_ge(&gj, &secp256k1_ge_const_g);
+    print_table(fp, "secp256k1_ecmult_static_pre_g", window_g, &gj);
+
+    /* The table for 2^128*generator is only used with the endomorphism, which
+     * this generator does not know about, so it is emitted conditionally. */
+    g_128j = gj;
+    for (i = 0; i < 128; i++) {
+        secp256k1_gej_double_var(&g_128j, &g_128j, NULL);
+    }
+    fprintf(fp, "#ifdef USE_ENDOMORPHISM\n");
+    print_table(fp, "secp256k1_ecmult_static_pre_g_128", window_g, &g_128j);
+    fprintf(fp, "#endif\n");
+
+    fprintf(fp, "#undef SC\n");
+    fprintf(fp, "#endif\n");
+    fclose(fp);
+
+    return 0;
+}
@@ -0,0 +1,58 @@
+/**********************************************************************
+ * Copyright (c) 2020 the libsecp256k1 contributors                   *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef SECP256K1_GROUP_LANES_H
+#define SECP256K1_GROUP_LANES_H
+
+#include "field_lanes.h"
+#include "group.h"
+
+/** SECP256K1_FE_LANES independent group elements in affine coordinates. None of
+ *  them can be the point at infinity. */
+typedef struct {
+    secp256k1_fe_lanes x;
+    secp256k1_fe_lanes y;
+} secp256k1_ge_lanes;
+
+/** SECP256K1_FE_LANES independent group elements in jacobian coordinates. */
+typedef struct {
+    secp256k1_fe_lanes x; /* actual X: x/z^2 */
+    secp256k1_fe_lanes y; /* actual Y: y/z^3 */
+    secp256k1_fe_lanes z;
+    int infinity[SECP256K1_FE_LANES]; /* whether each lane represents the point at infinity */
+} secp256k1_gej_lanes;
+
+/** Set lane l of r to a, which must not be infinity. The other lanes are not modified. */
+static void secp256k1_ge_lanes_set_ge(secp256k1_ge_lanes *r, int l, const secp256k1_ge *a);
+
+/** Set lane l of r to table[idx[l]] for every l, with idx[l] < n. Every entry of the table
+ *  is accessed independently of idx, and the lanes share a single pass over it. */
+static void secp256k1_ge_lanes_table_lookup(secp256k1_ge_lanes *r, const secp256k1_ge_storage *table, int n, const uint32_t *idx);
+
+/** Set r to the affine points a (with Z = 1). */
+static void secp256k1_gej_lanes_set_ge(secp256k1_gej_lanes *r, const secp256k1_ge_lanes *a);
+
+/** Get lane l of a. */
+static void secp256k1_gej_lanes_get_gej(secp256k1_gej *r, const secp256k1_gej_lanes *a, int l);
+
+/** Set r = 2*a in every lane. Constant time, like secp256k1_gej_double. r may alias a. */
+static void secp256k1_gej_lanes_double(secp256k1_gej_lanes *r, const secp256k1_gej_lanes *a);
+
+/** Set r = a+b in every lane. Constant time, like secp256k1_gej_add_ge (including the
+ *  cases where a lane of a is infinity or equal to b or -b). r may alias a. */
+static void secp256k1_gej_lanes_add_ge(secp256k1_gej_lanes *r, const secp256k1_gej_lanes *a, const secp256k1_ge_lanes *b);
+
+/** Rescale the jacobian coordinates of every lane of r by the corresponding lane of s,
+ *  which must not be zero. Constant time. */
+static void secp256k1_gej_lanes_rescale(secp256k1_gej_lanes *r, const secp256k1_fe_lanes *s);
+
+/** Clear all lanes of r to prevent leaking sensitive information. */
+static void secp256k1_ge_lanes_clear(secp256k1_ge_lanes *r);
+
+/** Clear all lanes of r to prevent leaking sensitive information. */
+static void secp256k1_gej_lanes_clear(secp256k1_gej_lanes *r);
+
+#endif /* SECP256K1_GROUP_LANES_H */
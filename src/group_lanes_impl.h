@@ -0,0 +1,196 @@
+/**********************************************************************
+ * Copyright (c) 2020 the libsecp256k1 contributors                   *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef SECP256K1_GROUP_LANES_IMPL_H
+#define SECP256K1_GROUP_LANES_IMPL_H
+
+#include "field_lanes_impl.h"
+#include "group_lanes.h"
+
+static void secp256k1_ge_lanes_set_ge(secp256k1_ge_lanes *r, int l, const secp256k1_ge *a) {
+    VERIFY_CHECK(!a->infinity);
+    secp256k1_fe_lanes_set_fe(&r->x, l, &a->x);
+    secp256k1_fe_lanes_set_fe(&r->y, l, &a->y);
+}
+
+static void secp256k1_ge_lanes_table_lookup(secp256k1_ge_lanes *r, const secp256k1_ge_storage *table, int n, const uint32_t *idx) {
+    /* The entries are handled as arrays of words so that the loops over the lanes can be
+     * vectorized like the field operations. */
+    uint64_t acc[sizeof(secp256k1_ge_storage) / sizeof(uint64_t)][SECP256K1_FE_LANES];
+    uint64_t entry[sizeof(secp256k1_ge_storage) / sizeof(uint64_t)];
+    uint64_t mask0[SECP256K1_FE_LANES];
+    secp256k1_ge_storage s;
+    secp256k1_ge ge;
+    int i, w, l;
+
+    memset(acc, 0, sizeof(acc));
+    for (i = 0; i < n; i++) {
+        memcpy(entry, &table[i], sizeof(entry));
+        for (l = 0; l < SECP256K1_FE_LANES; l++) {
+            mask0[l] = (uint64_t)((uint32_t)i == idx[l]) + ~((uint64_t)0);
+        }
+        for (w = 0; w < (int)(sizeof(entry) / sizeof(entry[0])); w++) {
+            for (l = 0; l < SECP256K1_FE_LANES; l++) {
+                acc[w][l] = (acc[w][l] & mask0[l]) | (entry[w] & ~mask0[l]);
+            }
+        }
+    }
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        for (w = 0; w < (int)(sizeof(entry) / sizeof(entry[0])); w++) {
+            entry[w] = acc[w][l];
+        }
+        memcpy(&s, entry, sizeof(s));
+        secp256k1_ge_from_storage(&ge, &s);
+        secp256k1_ge_lanes_set_ge(r, l, &ge);
+    }
+
+    memset(acc, 0, sizeof(acc));
+    memset(entry, 0, sizeof(entry));
+    memset(&s, 0, sizeof(s));
+    secp256k1_ge_clear(&ge);
+}
+
+static void secp256k1_gej_lanes_set_ge(secp256k1_gej_lanes *r, const secp256k1_ge_lanes *a) {
+    static const secp256k1_fe fe_1 = SECP256K1_FE_CONST(0, 0, 0, 0, 0, 0, 0, 1);
+    int l;
+    r->x = a->x;
+    r->y = a->y;
+    secp256k1_fe_lanes_set_all(&r->z, &fe_1);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        r->infinity[l] = 0;
+    }
+}
+
+static void secp256k1_gej_lanes_get_gej(secp256k1_gej *r, const secp256k1_gej_lanes *a, int l) {
+    r->infinity = a->infinity[l];
+    secp256k1_fe_lanes_get_fe(&r->x, &a->x, l);
+    secp256k1_fe_lanes_get_fe(&r->y, &a->y, l);
+    secp256k1_fe_lanes_get_fe(&r->z, &a->z, l);
+}
+
+static void secp256k1_gej_lanes_double(secp256k1_gej_lanes *r, const secp256k1_gej_lanes *a) {
+    /* The operations (and magnitudes) of secp256k1_gej_double. */
+    secp256k1_fe_lanes t1, t2, t3, t4;
+    int l;
+
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        r->infinity[l] = a->infinity[l];
+    }
+
+    secp256k1_fe_lanes_mul(&r->z, &a->z, &a->y);
+    secp256k1_fe_lanes_mul_int(&r->z, 2);       /* Z' = 2*Y*Z (2) */
+    secp256k1_fe_lanes_sqr(&t1, &a->x);
+    secp256k1_fe_lanes_mul_int(&t1, 3);         /* T1 = 3*X^2 (3) */
+    secp256k1_fe_lanes_sqr(&t2, &t1);           /* T2 = 9*X^4 (1) */
+    secp256k1_fe_lanes_sqr(&t3, &a->y);
+    secp256k1_fe_lanes_mul_int(&t3, 2);         /* T3 = 2*Y^2 (2) */
+    secp256k1_fe_lanes_sqr(&t4, &t3);
+    secp256k1_fe_lanes_mul_int(&t4, 2);         /* T4 = 8*Y^4 (2) */
+    secp256k1_fe_lanes_mul(&t3, &t3, &a->x);    /* T3 = 2*X*Y^2 (1) */
+    r->x = t3;
+    secp256k1_fe_lanes_mul_int(&r->x, 4);       /* X' = 8*X*Y^2 (4) */
+    secp256k1_fe_lanes_negate(&r->x, &r->x, 4); /* X' = -8*X*Y^2 (5) */
+    secp256k1_fe_lanes_add(&r->x, &t2);         /* X' = 9*X^4 - 8*X*Y^2 (6) */
+    secp256k1_fe_lanes_negate(&t2, &t2, 1);     /* T2 = -9*X^4 (2) */
+    secp256k1_fe_lanes_mul_int(&t3, 6);         /* T3 = 12*X*Y^2 (6) */
+    secp256k1_fe_lanes_add(&t3, &t2);           /* T3 = 12*X*Y^2 - 9*X^4 (8) */
+    secp256k1_fe_lanes_mul(&r->y, &t1, &t3);    /* Y' = 36*X^3*Y^2 - 27*X^6 (1) */
+    secp256k1_fe_lanes_negate(&t2, &t4, 2);     /* T2 = -8*Y^4 (3) */
+    secp256k1_fe_lanes_add(&r->y, &t2);         /* Y' = 36*X^3*Y^2 - 27*X^6 - 8*Y^4 (4) */
+}
+
+static void secp256k1_gej_lanes_add_ge(secp256k1_gej_lanes *r, const secp256k1_gej_lanes *a, const secp256k1_ge_lanes *b) {
+    /* The operations (and magnitudes) of secp256k1_gej_add_ge, which describes the
+     * formula and how the special cases are handled. The flags are per lane. */
+    static const secp256k1_fe fe_1 = SECP256K1_FE_CONST(0, 0, 0, 0, 0, 0, 0, 1);
+    secp256k1_fe_lanes zz, u1, u2, s1, s2, t, tt, m, n, q, rr;
+    secp256k1_fe_lanes m_alt, rr_alt, one;
+    int a_infinity[SECP256K1_FE_LANES], infinity[SECP256K1_FE_LANES];
+    int degenerate[SECP256K1_FE_LANES], not_degenerate[SECP256K1_FE_LANES];
+    int zero_m[SECP256K1_FE_LANES], zero_rr[SECP256K1_FE_LANES];
+    int l;
+
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        VERIFY_CHECK(a->infinity[l] == 0 || a->infinity[l] == 1);
+        a_infinity[l] = a->infinity[l];
+    }
+
+    secp256k1_fe_lanes_sqr(&zz, &a->z);                       /* z = Z1^2 */
+    u1 = a->x; secp256k1_fe_lanes_normalize_weak(&u1);        /* u1 = U1 = X1*Z2^2 (1) */
+    secp256k1_fe_lanes_mul(&u2, &b->x, &zz);                  /* u2 = U2 = X2*Z1^2 (1) */
+    s1 = a->y; secp256k1_fe_lanes_normalize_weak(&s1);        /* s1 = S1 = Y1*Z2^3 (1) */
+    secp256k1_fe_lanes_mul(&s2, &b->y, &zz);                  /* s2 = Y2*Z1^2 (1) */
+    secp256k1_fe_lanes_mul(&s2, &s2, &a->z);                  /* s2 = S2 = Y2*Z1^3 (1) */
+    t = u1; secp256k1_fe_lanes_add(&t, &u2);                  /* t = T = U1+U2 (2) */
+    m = s1; secp256k1_fe_lanes_add(&m, &s2);                  /* m = M = S1+S2 (2) */
+    secp256k1_fe_lanes_sqr(&rr, &t);                          /* rr = T^2 (1) */
+    secp256k1_fe_lanes_negate(&m_alt, &u2, 1);                /* Malt = -X2*Z1^2 */
+    secp256k1_fe_lanes_mul(&tt, &u1, &m_alt);                 /* tt = -U1*U2 (2) */
+    secp256k1_fe_lanes_add(&rr, &tt);                         /* rr = R = T^2-U1*U2 (3) */
+    secp256k1_fe_lanes_normalizes_to_zero(zero_m, &m);
+    secp256k1_fe_lanes_normalizes_to_zero(zero_rr, &rr);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        degenerate[l] = zero_m[l] & zero_rr[l];
+        not_degenerate[l] = !degenerate[l];
+    }
+    rr_alt = s1;
+    secp256k1_fe_lanes_mul_int(&rr_alt, 2);                   /* rr = Y1*Z2^3 - Y2*Z1^3 (2) */
+    secp256k1_fe_lanes_add(&m_alt, &u1);                      /* Malt = X1*Z2^2 - X2*Z1^2 */
+    secp256k1_fe_lanes_cmov(&rr_alt, &rr, not_degenerate);
+    secp256k1_fe_lanes_cmov(&m_alt, &m, not_degenerate);
+    secp256k1_fe_lanes_sqr(&n, &m_alt);                       /* n = Malt^2 (1) */
+    secp256k1_fe_lanes_mul(&q, &n, &t);                       /* q = Q = T*Malt^2 (1) */
+    secp256k1_fe_lanes_sqr(&n, &n);
+    secp256k1_fe_lanes_cmov(&n, &m, degenerate);              /* n = M^3 * Malt (2) */
+    secp256k1_fe_lanes_sqr(&t, &rr_alt);                      /* t = Ralt^2 (1) */
+    secp256k1_fe_lanes_mul(&r->z, &a->z, &m_alt);             /* r->z = Malt*Z (1) */
+    secp256k1_fe_lanes_normalizes_to_zero(infinity, &r->z);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        infinity[l] *= 1 - a_infinity[l];
+    }
+    secp256k1_fe_lanes_mul_int(&r->z, 2);                     /* r->z = Z3 = 2*Malt*Z (2) */
+    secp256k1_fe_lanes_negate(&q, &q, 1);                     /* q = -Q (2) */
+    secp256k1_fe_lanes_add(&t, &q);                           /* t = Ralt^2-Q (3) */
+    secp256k1_fe_lanes_normalize_weak(&t);
+    r->x = t;                                                 /* r->x = Ralt^2-Q (1) */
+    secp256k1_fe_lanes_mul_int(&t, 2);                        /* t = 2*x3 (2) */
+    secp256k1_fe_lanes_add(&t, &q);                           /* t = 2*x3 - Q: (4) */
+    secp256k1_fe_lanes_mul(&t, &t, &rr_alt);                  /* t = Ralt*(2*x3 - Q) (1) */
+    secp256k1_fe_lanes_add(&t, &n);                           /* t = Ralt*(2*x3 - Q) + M^3*Malt (3) */
+    secp256k1_fe_lanes_negate(&r->y, &t, 3);                  /* r->y = Ralt*(Q - 2x3) - M^3*Malt (4) */
+    secp256k1_fe_lanes_normalize_weak(&r->y);
+    secp256k1_fe_lanes_mul_int(&r->x, 4);                     /* r->x = X3 = 4*(Ralt^2-Q) */
+    secp256k1_fe_lanes_mul_int(&r->y, 4);                     /* r->y = Y3 = 4*Ralt*(Q - 2x3) - 4*M^3*Malt (4) */
+
+    /** In lanes where a is infinity, replace r with (b->x, b->y, 1). */
+    secp256k1_fe_lanes_set_all(&one, &fe_1);
+    secp256k1_fe_lanes_cmov(&r->x, &b->x, a_infinity);
+    secp256k1_fe_lanes_cmov(&r->y, &b->y, a_infinity);
+    secp256k1_fe_lanes_cmov(&r->z, &one, a_infinity);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        r->infinity[l] = infinity[l];
+    }
+}
+
+static void secp256k1_gej_lanes_rescale(secp256k1_gej_lanes *r, const secp256k1_fe_lanes *s) {
+    /* Operations: 4 mul, 1 sqr */
+    secp256k1_fe_lanes zz;
+    secp256k1_fe_lanes_sqr(&zz, s);
+    secp256k1_fe_lanes_mul(&r->x, &r->x, &zz);                /* r->x *= s^2 */
+    secp256k1_fe_lanes_mul(&r->y, &r->y, &zz);
+    secp256k1_fe_lanes_mul(&r->y, &r->y, s);                  /* r->y *= s^3 */
+    secp256k1_fe_lanes_mul(&r->z, &r->z, s);                  /* r->z *= s   */
+}
+
+static void secp256k1_ge_lanes_clear(secp256k1_ge_lanes *r) {
+    memset(r, 0, sizeof(*r));
+}
+
+static void secp256k1_gej_lanes_clear(secp256k1_gej_lanes *r) {
+    memset(r, 0, sizeof(*r));
+}
+
+#endif /* SECP256K1_GROUP_LANES_IMPL_H */
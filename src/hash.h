@@ -20,6 +20,16 @@ static void secp256k1_sha256_initialize(secp256k1_sha256 *hash);
 static void secp256k1_sha256_write(secp256k1_sha256 *hash, const unsigned char *data, size_t size);
 static void secp256k1_sha256_finalize(secp256k1_sha256 *hash, unsigned char *out32);
 
+/** Number of messages hashed in lockstep by secp256k1_sha256_finalize_multi. */
+#define SECP256K1_SHA256_LANES 8
+
+/** Computes out32[i] = SHA256(prefix || msg[i]) for n messages of len bytes
+ *  each, where prefix is the data written to hash so far. The total length of
+ *  the prefix must be a multiple of 64 bytes, as after
+ *  secp256k1_sha256_initialize or a tagged hash initialization. hash is not
+ *  modified. */
+static void secp256k1_sha256_finalize_multi(const secp256k1_sha256 *hash, unsigned char *const *out32, const unsigned char *const *msg, size_t len, size_t n);
+
 typedef struct {
     secp256k1_sha256 inner, outer;
 } secp256k1_hmac_sha256;
@@ -35,6 +45,12 @@ typedef struct {
 } secp256k1_rfc6979_hmac_sha256;
 
 static void secp256k1_rfc6979_hmac_sha256_initialize(secp256k1_rfc6979_hmac_sha256 *rng, const unsigned char *key, size_t keylen);
+/** Sets hmac to the HMAC of RFC6979 step 3.2.d after it has absorbed V || 0x00 || prefix.
+ *  The result only depends on prefix, and can be reused for every key that starts with it. */
+static void secp256k1_rfc6979_hmac_sha256_precompute(secp256k1_hmac_sha256 *hmac, const unsigned char *prefix, size_t prefixlen);
+/** Equivalent to secp256k1_rfc6979_hmac_sha256_initialize with key prefix || rest, where hmac
+ *  was computed by secp256k1_rfc6979_hmac_sha256_precompute from the same prefix. */
+static void secp256k1_rfc6979_hmac_sha256_initialize_precomputed(secp256k1_rfc6979_hmac_sha256 *rng, const secp256k1_hmac_sha256 *hmac, const unsigned char *prefix, size_t prefixlen, const unsigned char *rest, size_t restlen);
 static void secp256k1_rfc6979_hmac_sha256_generate(secp256k1_rfc6979_hmac_sha256 *rng, unsigned char *out, size_t outlen);
 static void secp256k1_rfc6979_hmac_sha256_finalize(secp256k1_rfc6979_hmac_sha256 *rng);
 
@@ -33,6 +33,17 @@
 #define BE32(p) ((((p) & 0xFF) << 24) | (((p) & 0xFF00) << 8) | (((p) & 0xFF0000) >> 8) | (((p) & 0xFF000000) >> 24))
 #endif
 
+static const uint32_t secp256k1_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
 static void secp256k1_sha256_initialize(secp256k1_sha256 *hash) {
     hash->s[0] = 0x6a09e667ul;
     hash->s[1] = 0xbb67ae85ul;
@@ -46,7 +57,7 @@ static void secp256k1_sha256_initialize(secp256k1_sha256 *hash) {
 }
 
 /** Perform one SHA-256 transformation, processing 16 big endian 32-bit words. */
-static void secp256k1_sha256_transform(uint32_t* s, const uint32_t* chunk) {
+static void secp256k1_sha256_transform_portable(uint32_t* s, const uint32_t* chunk) {
     uint32_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
     uint32_t w0, w1, w2, w3, w4, w5, w6, w7, w8, w9, w10, w11, w12, w13, w14, w15;
 
@@ -128,6 +139,121 @@ static void secp256k1_sha256_transform(uint32_t* s, const uint32_t* chunk) {
     s[7] += h;
 }
 
+#if defined(USE_SHA256_HW_X86)
+#include <immintrin.h>
+
+/** SHA-NI transformation. The state is kept as ABEF/CDGH in two registers as
+ *  required by sha256rnds2, and four rounds are performed per iteration. The
+ *  message schedule for rounds 16..63 is computed 4 words at a time with
+ *  sha256msg1/sha256msg2. */
+__attribute__((target("sha,sse4.1")))
+static void secp256k1_sha256_transform_hw(uint32_t* s, const uint32_t* chunk) {
+    const __m128i mask = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m128i s0, s1, t0, t1, save0, save1, m[4];
+    int i;
+
+    t0 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&s[0]), 0xB1);
+    t1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&s[4]), 0x1B);
+    s0 = _mm_alignr_epi8(t0, t1, 8);
+    s1 = _mm_blend_epi16(t1, t0, 0xF0);
+    save0 = s0;
+    save1 = s1;
+    for (i = 0; i < 4; i++) {
+        m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&chunk[4 * i]), mask);
+    }
+    for (i = 0; i < 16; i++) {
+        t0 = _mm_add_epi32(m[i & 3], _mm_loadu_si128((const __m128i*)&secp256k1_sha256_k[4 * i]));
+        s1 = _mm_sha256rnds2_epu32(s1, s0, t0);
+        s0 = _mm_sha256rnds2_epu32(s0, s1, _mm_shuffle_epi32(t0, 0x0E));
+        if (i < 12) {
+            /* Replace words 4i..4i+3 by words 4i+16..4i+19. */
+            t0 = _mm_add_epi32(_mm_sha256msg1_epu32(m[i & 3], m[(i + 1) & 3]), _mm_alignr_epi8(m[(i + 3) & 3], m[(i + 2) & 3], 4));
+            m[i & 3] = _mm_sha256msg2_epu32(t0, m[(i + 3) & 3]);
+        }
+    }
+    s0 = _mm_add_epi32(s0, save0);
+    s1 = _mm_add_epi32(s1, save1);
+    t0 = _mm_shuffle_epi32(s0, 0x1B);
+    t1 = _mm_shuffle_epi32(s1, 0xB1);
+    _mm_storeu_si128((__m128i*)&s[0], _mm_blend_epi16(t0, t1, 0xF0));
+    _mm_storeu_si128((__m128i*)&s[4], _mm_alignr_epi8(t1, t0, 8));
+}
+
+/** Returns whether the CPU supports SHA-NI along with the SSSE3 and SSE4.1
+ *  instructions used around it. The compiler runtime determines the CPU
+ *  features once at program start, so this is cheap and safe to call from
+ *  any thread. */
+static int secp256k1_sha256_hw_supported(void) {
+    return __builtin_cpu_supports("sha") && __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("sse4.1");
+}
+
+#elif defined(USE_SHA256_HW_ARM)
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#endif
+
+/** ARMv8 crypto extension transformation. vsha256hq/vsha256h2q perform four
+ *  rounds on the ABCD/EFGH halves of the state, and vsha256su0q/vsha256su1q
+ *  compute the message schedule 4 words at a time. */
+#if defined(__clang__)
+__attribute__((target("crypto")))
+#else
+__attribute__((target("+crypto")))
+#endif
+static void secp256k1_sha256_transform_hw(uint32_t* s, const uint32_t* chunk) {
+    uint32x4_t s0, s1, t0, abcd, m[4];
+    int i;
+
+    s0 = vld1q_u32(&s[0]);
+    s1 = vld1q_u32(&s[4]);
+    for (i = 0; i < 4; i++) {
+        m[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8((const uint8_t*)&chunk[4 * i])));
+    }
+    for (i = 0; i < 16; i++) {
+        t0 = vaddq_u32(m[i & 3], vld1q_u32(&secp256k1_sha256_k[4 * i]));
+        abcd = s0;
+        s0 = vsha256hq_u32(s0, s1, t0);
+        s1 = vsha256h2q_u32(s1, abcd, t0);
+        if (i < 12) {
+            /* Replace words 4i..4i+3 by words 4i+16..4i+19. */
+            m[i & 3] = vsha256su1q_u32(vsha256su0q_u32(m[i & 3], m[(i + 1) & 3]), m[(i + 2) & 3], m[(i + 3) & 3]);
+        }
+    }
+    vst1q_u32(&s[0], vaddq_u32(s0, vld1q_u32(&s[0])));
+    vst1q_u32(&s[4], vaddq_u32(s1, vld1q_u32(&s[4])));
+}
+
+/** Returns whether the CPU implements the SHA256 instructions. The hardware
+ *  capabilities are fixed by the kernel when the process starts. */
+static int secp256k1_sha256_hw_supported(void) {
+#if defined(__APPLE__)
+    return 1;
+#elif defined(__linux__) && defined(HWCAP_SHA2)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+    return 0;
+#endif
+}
+
+#else
+static int secp256k1_sha256_hw_supported(void) {
+    return 0;
+}
+#endif
+
+/** Perform one SHA-256 transformation, using the hardware implementation if the
+ *  CPU supports it. */
+static void secp256k1_sha256_transform(uint32_t* s, const uint32_t* chunk) {
+#if defined(USE_SHA256_HW_X86) || defined(USE_SHA256_HW_ARM)
+    if (secp256k1_sha256_hw_supported()) {
+        secp256k1_sha256_transform_hw(s, chunk);
+        return;
+    }
+#endif
+    secp256k1_sha256_transform_portable(s, chunk);
+}
+
 static void secp256k1_sha256_write(secp256k1_sha256 *hash, const unsigned char *data, size_t len) {
     size_t bufsize = hash->bytes & 0x3F;
     hash->bytes += len;
@@ -176,6 +302,203 @@ static void secp256k1_sha256_initialize_tagged(secp256k1_sha256 *hash, const uns
     secp256k1_sha256_write(hash, buf, 32);
 }
 
+/* Multi-lane SHA-256 transformation: performs one transformation on each of
+ * SECP256K1_SHA256_LANES independent states. Word i of lane l is stored in
+ * s[i][l] and w[i][l], so every step operates on all lanes at once. With SSE2
+ * or AVX2 available at compile time the lanes are processed in vector
+ * registers; otherwise the loops over the lanes are left to the compiler. */
+#if defined(__AVX2__) || defined(__SSE2__)
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SHA256_VEC_LANES 8
+typedef __m256i secp256k1_sha256_vec;
+#define VLOAD(p) _mm256_loadu_si256((const __m256i*)(p))
+#define VSTORE(p, x) _mm256_storeu_si256((__m256i*)(p), (x))
+#define VSET1(x) _mm256_set1_epi32((int)(x))
+#define VADD(x, y) _mm256_add_epi32((x), (y))
+#define VXOR(x, y) _mm256_xor_si256((x), (y))
+#define VAND(x, y) _mm256_and_si256((x), (y))
+#define VOR(x, y) _mm256_or_si256((x), (y))
+#define VSHR(x, n) _mm256_srli_epi32((x), (n))
+#define VSHL(x, n) _mm256_slli_epi32((x), (n))
+#else
+#include <emmintrin.h>
+#define SHA256_VEC_LANES 4
+typedef __m128i secp256k1_sha256_vec;
+#define VLOAD(p) _mm_loadu_si128((const __m128i*)(p))
+#define VSTORE(p, x) _mm_storeu_si128((__m128i*)(p), (x))
+#define VSET1(x) _mm_set1_epi32((int)(x))
+#define VADD(x, y) _mm_add_epi32((x), (y))
+#define VXOR(x, y) _mm_xor_si128((x), (y))
+#define VAND(x, y) _mm_and_si128((x), (y))
+#define VOR(x, y) _mm_or_si128((x), (y))
+#define VSHR(x, n) _mm_srli_epi32((x), (n))
+#define VSHL(x, n) _mm_slli_epi32((x), (n))
+#endif
+
+#define VROTR(x, n) VOR(VSHR((x), (n)), VSHL((x), 32 - (n)))
+#define VCh(x,y,z) VXOR((z), VAND((x), VXOR((y), (z))))
+#define VMaj(x,y,z) VOR(VAND((x), (y)), VAND((z), VOR((x), (y))))
+#define VSigma0(x) VXOR(VXOR(VROTR((x), 2), VROTR((x), 13)), VROTR((x), 22))
+#define VSigma1(x) VXOR(VXOR(VROTR((x), 6), VROTR((x), 11)), VROTR((x), 25))
+#define Vsigma0(x) VXOR(VXOR(VROTR((x), 7), VROTR((x), 18)), VSHR((x), 3))
+#define Vsigma1(x) VXOR(VXOR(VROTR((x), 17), VROTR((x), 19)), VSHR((x), 10))
+
+static void secp256k1_sha256_transform_multi(uint32_t s[8][SECP256K1_SHA256_LANES], const uint32_t w[16][SECP256K1_SHA256_LANES]) {
+    int v;
+    for (v = 0; v < SECP256K1_SHA256_LANES; v += SHA256_VEC_LANES) {
+        secp256k1_sha256_vec st[8];
+        secp256k1_sha256_vec wv[16];
+        int i;
+        for (i = 0; i < 8; i++) {
+            st[i] = VLOAD(&s[i][v]);
+        }
+        for (i = 0; i < 16; i++) {
+            wv[i] = VLOAD(&w[i][v]);
+        }
+        for (i = 0; i < 64; i++) {
+            secp256k1_sha256_vec t1, t2;
+            /* The roles of the state words rotate by one every round */
+            secp256k1_sha256_vec *a = &st[(0 - i) & 7], *b = &st[(1 - i) & 7], *c = &st[(2 - i) & 7], *d = &st[(3 - i) & 7];
+            secp256k1_sha256_vec *e = &st[(4 - i) & 7], *f = &st[(5 - i) & 7], *g = &st[(6 - i) & 7], *h = &st[(7 - i) & 7];
+            if (i >= 16) {
+                wv[i & 15] = VADD(VADD(wv[i & 15], Vsigma1(wv[(i - 2) & 15])), VADD(wv[(i - 7) & 15], Vsigma0(wv[(i - 15) & 15])));
+            }
+            t1 = VADD(VADD(VADD(*h, VSigma1(*e)), VADD(VCh(*e, *f, *g), VSET1(secp256k1_sha256_k[i]))), wv[i & 15]);
+            t2 = VADD(VSigma0(*a), VMaj(*a, *b, *c));
+            *d = VADD(*d, t1);
+            *h = VADD(t1, t2);
+        }
+        for (i = 0; i < 8; i++) {
+            VSTORE(&s[i][v], VADD(VLOAD(&s[i][v]), st[i]));
+        }
+    }
+}
+
+#undef Vsigma1
+#undef Vsigma0
+#undef VSigma1
+#undef VSigma0
+#undef VMaj
+#undef VCh
+#undef VROTR
+#undef VSHL
+#undef VSHR
+#undef VOR
+#undef VAND
+#undef VXOR
+#undef VADD
+#undef VSET1
+#undef VSTORE
+#undef VLOAD
+#undef SHA256_VEC_LANES
+
+#else
+
+static void secp256k1_sha256_transform_multi(uint32_t s[8][SECP256K1_SHA256_LANES], const uint32_t w[16][SECP256K1_SHA256_LANES]) {
+    uint32_t st[8][SECP256K1_SHA256_LANES];
+    uint32_t wl[16][SECP256K1_SHA256_LANES];
+    int i, l;
+    memcpy(st, s, sizeof(st));
+    memcpy(wl, w, sizeof(wl));
+    for (i = 0; i < 64; i++) {
+        /* The roles of the state words rotate by one every round */
+        uint32_t *a = st[(0 - i) & 7], *b = st[(1 - i) & 7], *c = st[(2 - i) & 7], *d = st[(3 - i) & 7];
+        uint32_t *e = st[(4 - i) & 7], *f = st[(5 - i) & 7], *g = st[(6 - i) & 7], *h = st[(7 - i) & 7];
+        uint32_t *wi = wl[i & 15];
+        if (i >= 16) {
+            const uint32_t *w2 = wl[(i - 2) & 15], *w7 = wl[(i - 7) & 15], *w15 = wl[(i - 15) & 15];
+            for (l = 0; l < SECP256K1_SHA256_LANES; l++) {
+                wi[l] += sigma1(w2[l]) + w7[l] + sigma0(w15[l]);
+            }
+        }
+        for (l = 0; l < SECP256K1_SHA256_LANES; l++) {
+            uint32_t t1 = h[l] + Sigma1(e[l]) + Ch(e[l], f[l], g[l]) + secp256k1_sha256_k[i] + wi[l];
+            uint32_t t2 = Sigma0(a[l]) + Maj(a[l], b[l], c[l]);
+            d[l] += t1;
+            h[l] = t1 + t2;
+        }
+    }
+    for (i = 0; i < 8; i++) {
+        for (l = 0; l < SECP256K1_SHA256_LANES; l++) {
+            s[i][l] += st[i][l];
+        }
+    }
+}
+
+#endif
+
+/** secp256k1_sha256_finalize_multi using the lane-parallel transformation. */
+static void secp256k1_sha256_finalize_multi_lanes(const secp256k1_sha256 *hash, unsigned char *const *out32, const unsigned char *const *msg, size_t len, size_t n) {
+    uint32_t s[8][SECP256K1_SHA256_LANES];
+    uint32_t w[16][SECP256K1_SHA256_LANES];
+    unsigned char block[64];
+    uint64_t bits;
+    size_t nblocks;
+    size_t i;
+    VERIFY_CHECK((hash->bytes & 0x3F) == 0);
+    bits = ((uint64_t)hash->bytes + len) << 3;
+    /* The message, one padding byte and the 8 byte length */
+    nblocks = (len + 9 + 63) / 64;
+    for (i = 0; i < n; i += SECP256K1_SHA256_LANES) {
+        size_t nl = n - i < SECP256K1_SHA256_LANES ? n - i : SECP256K1_SHA256_LANES;
+        size_t b, j, l;
+        for (j = 0; j < 8; j++) {
+            for (l = 0; l < SECP256K1_SHA256_LANES; l++) {
+                s[j][l] = hash->s[j];
+            }
+        }
+        for (b = 0; b < nblocks; b++) {
+            for (l = 0; l < SECP256K1_SHA256_LANES; l++) {
+                /* Unused lanes hash a copy of the first message */
+                const unsigned char *m = msg[i + (l < nl ? l : 0)];
+                size_t off = b * 64;
+                size_t cnt = len > off ? (len - off < 64 ? len - off : 64) : 0;
+                if (cnt > 0) {
+                    memcpy(block, m + off, cnt);
+                }
+                memset(block + cnt, 0, 64 - cnt);
+                if (len >= off && len < off + 64) {
+                    block[len - off] = 0x80;
+                }
+                if (b == nblocks - 1) {
+                    for (j = 0; j < 8; j++) {
+                        block[56 + j] = (bits >> (56 - 8 * j)) & 0xFF;
+                    }
+                }
+                for (j = 0; j < 16; j++) {
+                    w[j][l] = (uint32_t)block[4 * j] << 24 | (uint32_t)block[4 * j + 1] << 16 | (uint32_t)block[4 * j + 2] << 8 | block[4 * j + 3];
+                }
+            }
+            secp256k1_sha256_transform_multi(s, (const uint32_t (*)[SECP256K1_SHA256_LANES])w);
+        }
+        for (l = 0; l < nl; l++) {
+            for (j = 0; j < 8; j++) {
+                out32[i + l][4 * j] = s[j][l] >> 24;
+                out32[i + l][4 * j + 1] = s[j][l] >> 16;
+                out32[i + l][4 * j + 2] = s[j][l] >> 8;
+                out32[i + l][4 * j + 3] = s[j][l];
+            }
+        }
+    }
+}
+
+static void secp256k1_sha256_finalize_multi(const secp256k1_sha256 *hash, unsigned char *const *out32, const unsigned char *const *msg, size_t len, size_t n) {
+    size_t i;
+    VERIFY_CHECK((hash->bytes & 0x3F) == 0);
+    if (secp256k1_sha256_hw_supported()) {
+        /* A single hardware stream is faster than the vectorized lanes. */
+        for (i = 0; i < n; i++) {
+            secp256k1_sha256 sha = *hash;
+            secp256k1_sha256_write(&sha, msg[i], len);
+            secp256k1_sha256_finalize(&sha, out32[i]);
+        }
+        return;
+    }
+    secp256k1_sha256_finalize_multi_lanes(hash, out32, msg, len, n);
+}
+
 static void secp256k1_hmac_sha256_initialize(secp256k1_hmac_sha256 *hash, const unsigned char *key, size_t keylen) {
     size_t n;
     unsigned char rkey[64];
@@ -217,36 +540,53 @@ static void secp256k1_hmac_sha256_finalize(secp256k1_hmac_sha256 *hash, unsigned
 }
 
 
-static void secp256k1_rfc6979_hmac_sha256_initialize(secp256k1_rfc6979_hmac_sha256 *rng, const unsigned char *key, size_t keylen) {
-    secp256k1_hmac_sha256 hmac;
+static void secp256k1_rfc6979_hmac_sha256_precompute(secp256k1_hmac_sha256 *hmac, const unsigned char *prefix, size_t prefixlen) {
     static const unsigned char zero[1] = {0x00};
+    unsigned char v[32];
+    unsigned char k[32];
+
+    memset(v, 0x01, 32); /* RFC6979 3.2.b. */
+    memset(k, 0x00, 32); /* RFC6979 3.2.c. */
+
+    /* RFC6979 3.2.d, up to the end of the prefix. */
+    secp256k1_hmac_sha256_initialize(hmac, k, 32);
+    secp256k1_hmac_sha256_write(hmac, v, 32);
+    secp256k1_hmac_sha256_write(hmac, zero, 1);
+    secp256k1_hmac_sha256_write(hmac, prefix, prefixlen);
+}
+
+static void secp256k1_rfc6979_hmac_sha256_initialize_precomputed(secp256k1_rfc6979_hmac_sha256 *rng, const secp256k1_hmac_sha256 *hmac, const unsigned char *prefix, size_t prefixlen, const unsigned char *rest, size_t restlen) {
+    secp256k1_hmac_sha256 hmac2 = *hmac;
     static const unsigned char one[1] = {0x01};
 
     memset(rng->v, 0x01, 32); /* RFC6979 3.2.b. */
-    memset(rng->k, 0x00, 32); /* RFC6979 3.2.c. */
-
-    /* RFC6979 3.2.d. */
-    secp256k1_hmac_sha256_initialize(&hmac, rng->k, 32);
-    secp256k1_hmac_sha256_write(&hmac, rng->v, 32);
-    secp256k1_hmac_sha256_write(&hmac, zero, 1);
-    secp256k1_hmac_sha256_write(&hmac, key, keylen);
-    secp256k1_hmac_sha256_finalize(&hmac, rng->k);
-    secp256k1_hmac_sha256_initialize(&hmac, rng->k, 32);
-    secp256k1_hmac_sha256_write(&hmac, rng->v, 32);
-    secp256k1_hmac_sha256_finalize(&hmac, rng->v);
+
+    /* RFC6979 3.2.d, remainder of the key. */
+    secp256k1_hmac_sha256_write(&hmac2, rest, restlen);
+    secp256k1_hmac_sha256_finalize(&hmac2, rng->k);
+    secp256k1_hmac_sha256_initialize(&hmac2, rng->k, 32);
+    secp256k1_hmac_sha256_write(&hmac2, rng->v, 32);
+    secp256k1_hmac_sha256_finalize(&hmac2, rng->v);
 
     /* RFC6979 3.2.f. */
-    secp256k1_hmac_sha256_initialize(&hmac, rng->k, 32);
-    secp256k1_hmac_sha256_write(&hmac, rng->v, 32);
-    secp256k1_hmac_sha256_write(&hmac, one, 1);
-    secp256k1_hmac_sha256_write(&hmac, key, keylen);
-    secp256k1_hmac_sha256_finalize(&hmac, rng->k);
-    secp256k1_hmac_sha256_initialize(&hmac, rng->k, 32);
-    secp256k1_hmac_sha256_write(&hmac, rng->v, 32);
-    secp256k1_hmac_sha256_finalize(&hmac, rng->v);
+    secp256k1_hmac_sha256_initialize(&hmac2, rng->k, 32);
+    secp256k1_hmac_sha256_write(&hmac2, rng->v, 32);
+    secp256k1_hmac_sha256_write(&hmac2, one, 1);
+    secp256k1_hmac_sha256_write(&hmac2, prefix, prefixlen);
+    secp256k1_hmac_sha256_write(&hmac2, rest, restlen);
+    secp256k1_hmac_sha256_finalize(&hmac2, rng->k);
+    secp256k1_hmac_sha256_initialize(&hmac2, rng->k, 32);
+    secp256k1_hmac_sha256_write(&hmac2, rng->v, 32);
+    secp256k1_hmac_sha256_finalize(&hmac2, rng->v);
     rng->retry = 0;
 }
 
+static void secp256k1_rfc6979_hmac_sha256_initialize(secp256k1_rfc6979_hmac_sha256 *rng, const unsigned char *key, size_t keylen) {
+    secp256k1_hmac_sha256 hmac;
+    secp256k1_rfc6979_hmac_sha256_precompute(&hmac, key, keylen);
+    secp256k1_rfc6979_hmac_sha256_initialize_precomputed(rng, &hmac, key, keylen, key + keylen, 0);
+}
+
 static void secp256k1_rfc6979_hmac_sha256_generate(secp256k1_rfc6979_hmac_sha256 *rng, unsigned char *out, size_t outlen) {
     /* RFC6979 3.2.h. */
     static const unsigned char zero[1] = {0x00};
@@ -74,19 +74,87 @@ static void secp256k1_musig_coefficient(secp256k1_scalar *r, const unsigned char
     secp256k1_scalar_set_b32(r, buf, NULL);
 }
 
+/* Coefficients of up to SECP256K1_SHA256_LANES consecutive signers starting at
+ * index start, which are hashed together. */
+typedef struct {
+    secp256k1_scalar coef[SECP256K1_SHA256_LANES];
+    size_t start;
+} secp256k1_musig_coefficient_cache;
+
+/* Sets r to the coefficient of signer idx out of n_signers. Consecutive calls with
+ * increasing idx compute the coefficients SECP256K1_SHA256_LANES at a time, using
+ * the same serialization as secp256k1_musig_coefficient. */
+static void secp256k1_musig_coefficient_cached(secp256k1_scalar *r, secp256k1_musig_coefficient_cache *cache, const unsigned char *ell, size_t idx, size_t n_signers) {
+    if (cache->start > idx || idx - cache->start >= SECP256K1_SHA256_LANES) {
+        unsigned char buf[SECP256K1_SHA256_LANES][36];
+        unsigned char hash[SECP256K1_SHA256_LANES][32];
+        const unsigned char *msg[SECP256K1_SHA256_LANES];
+        unsigned char *out[SECP256K1_SHA256_LANES];
+        secp256k1_sha256 sha;
+        size_t start = idx - idx % SECP256K1_SHA256_LANES;
+        size_t n = n_signers - start < SECP256K1_SHA256_LANES ? n_signers - start : SECP256K1_SHA256_LANES;
+        size_t i, j;
+
+        for (i = 0; i < n; i++) {
+            uint32_t signer = start + i;
+            memcpy(buf[i], ell, 32);
+            for (j = 0; j < sizeof(uint32_t); j++) {
+                buf[i][32 + j] = signer;
+                signer >>= 8;
+            }
+        }
+        for (i = 0; i < SECP256K1_SHA256_LANES; i++) {
+            msg[i] = buf[i];
+            out[i] = hash[i];
+        }
+        secp256k1_musig_sha256_init_tagged(&sha);
+        secp256k1_sha256_finalize_multi(&sha, out, msg, 36, n);
+        for (i = 0; i < n; i++) {
+            secp256k1_scalar_set_b32(&cache->coef[i], hash[i], NULL);
+        }
+        cache->start = start;
+    }
+    *r = cache->coef[idx - cache->start];
+}
+
 typedef struct {
     const secp256k1_context *ctx;
     unsigned char ell[32];
     const secp256k1_xonly_pubkey *pks;
+    size_t n_pks;
+    secp256k1_musig_coefficient_cache coef_cache;
 } secp256k1_musig_pubkey_combine_ecmult_data;
 
 /* Callback for batch EC multiplication to compute ell_0*P0 + ell_1*P1 + ...  */
 static int secp256k1_musig_pubkey_combine_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data) {
     secp256k1_musig_pubkey_combine_ecmult_data *ctx = (secp256k1_musig_pubkey_combine_ecmult_data *) data;
-    secp256k1_musig_coefficient(sc, ctx->ell, idx);
+    secp256k1_musig_coefficient_cached(sc, &ctx->coef_cache, ctx->ell, idx, ctx->n_pks);
     return secp256k1_xonly_pubkey_load(ctx->ctx, pt, &ctx->pks[idx]);
 }
 
+typedef struct {
+    const secp256k1_context *ctx;
+    unsigned char ell[32];
+    const secp256k1_xonly_pubkey *pks;
+    const secp256k1_pubkey_table *tables;
+    size_t n_pks;
+    secp256k1_musig_coefficient_cache coef_cache;
+} secp256k1_musig_pubkey_combine_table_ecmult_data;
+
+/* Same as musig_pubkey_combine_callback, but provides the precomputed table
+ * of each public key instead of the point. */
+static int secp256k1_musig_pubkey_combine_table_callback(secp256k1_scalar *sc, const unsigned char **table, size_t idx, void *data) {
+    secp256k1_musig_pubkey_combine_table_ecmult_data *ctx = (secp256k1_musig_pubkey_combine_table_ecmult_data *) data;
+    secp256k1_ge pt;
+    if (!secp256k1_xonly_pubkey_load(ctx->ctx, &pt, &ctx->pks[idx])
+        || !secp256k1_pubkey_table_matches(&ctx->tables[idx], &pt)) {
+        return 0;
+    }
+    secp256k1_musig_coefficient_cached(sc, &ctx->coef_cache, ctx->ell, idx, ctx->n_pks);
+    *table = ctx->tables[idx].data;
+    return 1;
+}
+
 static void secp256k1_musig_signers_init(secp256k1_musig_session_signer_data *signers, uint32_t n_signers) {
     uint32_t i;
     for (i = 0; i < n_signers; i++) {
@@ -112,6 +180,8 @@ int secp256k1_musig_pubkey_combine(const secp256k1_context* ctx, secp256k1_scrat
 
     ecmult_data.ctx = ctx;
     ecmult_data.pks = pubkeys;
+    ecmult_data.n_pks = n_pubkeys;
+    ecmult_data.coef_cache.start = SIZE_MAX;
     if (!secp256k1_musig_compute_ell(ctx, ecmult_data.ell, pubkeys, n_pubkeys)) {
         return 0;
     }
@@ -131,6 +201,43 @@ int secp256k1_musig_pubkey_combine(const secp256k1_context* ctx, secp256k1_scrat
     return 1;
 }
 
+int secp256k1_musig_pubkey_combine_tables(const secp256k1_context* ctx, secp256k1_xonly_pubkey *combined_pk, secp256k1_musig_pre_session *pre_session, const secp256k1_xonly_pubkey *pubkeys, const secp256k1_pubkey_table *tables, size_t n_pubkeys) {
+    secp256k1_musig_pubkey_combine_table_ecmult_data ecmult_data;
+    secp256k1_gej pkj;
+    secp256k1_ge pkp;
+    int is_pk_negated;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(combined_pk != NULL);
+    ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    ARG_CHECK(pubkeys != NULL);
+    ARG_CHECK(tables != NULL);
+    ARG_CHECK(n_pubkeys > 0);
+
+    ecmult_data.ctx = ctx;
+    ecmult_data.pks = pubkeys;
+    ecmult_data.n_pks = n_pubkeys;
+    ecmult_data.coef_cache.start = SIZE_MAX;
+    ecmult_data.tables = tables;
+    if (!secp256k1_musig_compute_ell(ctx, ecmult_data.ell, pubkeys, n_pubkeys)) {
+        return 0;
+    }
+    if (!secp256k1_ecmult_multi_table_var(&ctx->ecmult_ctx, &pkj, NULL, secp256k1_musig_pubkey_combine_table_callback, (void *) &ecmult_data, n_pubkeys)) {
+        return 0;
+    }
+    secp256k1_ge_set_gej(&pkp, &pkj);
+    secp256k1_ge_absolute(&pkp, &is_pk_negated);
+    secp256k1_xonly_pubkey_save(combined_pk, &pkp);
+
+    if (pre_session != NULL) {
+        pre_session->magic = pre_session_magic;
+        memcpy(pre_session->pk_hash, ecmult_data.ell, 32);
+        pre_session->is_pk_negated = is_pk_negated;
+        pre_session->is_tweaked = 0;
+    }
+    return 1;
+}
+
 int secp256k1_musig_pubkey_tweak_add(const secp256k1_context* ctx, secp256k1_musig_pre_session *pre_session, secp256k1_xonly_pubkey *output_pubkey, int *is_negated, const secp256k1_xonly_pubkey *internal_pubkey, const unsigned char *tweak32) {
     const size_t pk_siz = sizeof(*output_pubkey);
     VERIFY_CHECK(pk_siz == 64);
@@ -935,12 +935,60 @@ void musig_tweak_test(secp256k1_scratch_space *scratch) {
     musig_tweak_test_helper(&Q, sk[0], sk[1], &pre_session_Q);
 }
 
+/* Checks that musig_pubkey_combine_tables computes the same combined key and
+ * pre_session as musig_pubkey_combine. */
+void musig_pubkey_combine_tables_test(secp256k1_scratch_space *scratch) {
+    unsigned char sk[20][32];
+    secp256k1_xonly_pubkey pk[20];
+    secp256k1_pubkey_table *tables;
+    secp256k1_xonly_pubkey combined_pk[2];
+    secp256k1_musig_pre_session pre_session[2];
+    size_t n_pubkeys = 1 + secp256k1_rand_int(20);
+    size_t i;
+    int ecount = 0;
+
+    tables = (secp256k1_pubkey_table *)checked_malloc(&ctx->error_callback, 20 * sizeof(*tables));
+    for (i = 0; i < n_pubkeys; i++) {
+        secp256k1_rand256(sk[i]);
+        CHECK(secp256k1_xonly_pubkey_create(ctx, &pk[i], sk[i]) == 1);
+        CHECK(secp256k1_xonly_pubkey_table_create(ctx, &tables[i], &pk[i]) == 1);
+    }
+    CHECK(secp256k1_musig_pubkey_combine(ctx, scratch, &combined_pk[0], &pre_session[0], pk, n_pubkeys) == 1);
+    CHECK(secp256k1_musig_pubkey_combine_tables(ctx, &combined_pk[1], &pre_session[1], pk, tables, n_pubkeys) == 1);
+    CHECK(memcmp(&combined_pk[0], &combined_pk[1], sizeof(combined_pk[0])) == 0);
+    CHECK(pre_session[0].magic == pre_session[1].magic);
+    CHECK(memcmp(pre_session[0].pk_hash, pre_session[1].pk_hash, 32) == 0);
+    CHECK(pre_session[0].is_pk_negated == pre_session[1].is_pk_negated);
+    CHECK(pre_session[0].is_tweaked == pre_session[1].is_tweaked);
+    CHECK(secp256k1_musig_pubkey_combine_tables(ctx, &combined_pk[1], NULL, pk, tables, n_pubkeys) == 1);
+    CHECK(memcmp(&combined_pk[0], &combined_pk[1], sizeof(combined_pk[0])) == 0);
+
+    /* A table that does not belong to its public key is rejected */
+    if (n_pubkeys > 1) {
+        memcpy(&tables[0], &tables[1], sizeof(tables[0]));
+        CHECK(secp256k1_musig_pubkey_combine_tables(ctx, &combined_pk[1], &pre_session[1], pk, tables, n_pubkeys) == 0);
+    }
+
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+    CHECK(secp256k1_musig_pubkey_combine_tables(ctx, NULL, &pre_session[1], pk, tables, n_pubkeys) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_musig_pubkey_combine_tables(ctx, &combined_pk[1], &pre_session[1], NULL, tables, n_pubkeys) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_musig_pubkey_combine_tables(ctx, &combined_pk[1], &pre_session[1], pk, NULL, n_pubkeys) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_musig_pubkey_combine_tables(ctx, &combined_pk[1], &pre_session[1], pk, tables, 0) == 0);
+    CHECK(ecount == 4);
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+    free(tables);
+}
+
 void run_musig_tests(void) {
     int i;
     secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(ctx, 1024 * 1024);
 
     for (i = 0; i < count; i++) {
         musig_simple_test(scratch);
+        musig_pubkey_combine_tables_test(scratch);
     }
     musig_api_tests(scratch);
     musig_state_machine_tests(scratch);
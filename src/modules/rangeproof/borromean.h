@@ -17,6 +17,33 @@
 int secp256k1_borromean_verify(const secp256k1_ecmult_context* ecmult_ctx, secp256k1_scalar *evalues, const unsigned char *e0, const secp256k1_scalar *s,
  const secp256k1_gej *pubs, const size_t *rsizes, size_t nrings, const unsigned char *m, size_t mlen);
 
+/** A Borromean ring signature, as passed to secp256k1_borromean_verify. */
+typedef struct {
+    secp256k1_scalar *evalues;
+    const unsigned char *e0;
+    const secp256k1_scalar *s;
+    const secp256k1_gej *pubs;
+    const size_t *rsizes;
+    size_t nrings;
+    const unsigned char *m;
+    size_t mlen;
+} secp256k1_borromean_sig;
+
+/** Per-ring state of secp256k1_borromean_verify_batch. */
+typedef struct {
+    secp256k1_scalar ens;
+    size_t sig;
+    size_t ring;
+    size_t offset;
+    unsigned char r[33];
+} secp256k1_borromean_ring_state;
+
+/** Verifies n_sigs signatures at once, setting results[i] to whether sigs[i] is
+ *  valid. The caller provides space for the state of every ring of every
+ *  signature in state, rgej, rge and active. */
+static int secp256k1_borromean_verify_batch(const secp256k1_ecmult_context* ecmult_ctx, int *results, const secp256k1_borromean_sig *sigs, size_t n_sigs,
+ secp256k1_borromean_ring_state *state, secp256k1_gej *rgej, secp256k1_ge *rge, size_t *active);
+
 int secp256k1_borromean_sign(const secp256k1_ecmult_context* ecmult_ctx, const secp256k1_ecmult_gen_context *ecmult_gen_ctx,
  unsigned char *e0, secp256k1_scalar *s, const secp256k1_gej *pubs, const secp256k1_scalar *k, const secp256k1_scalar *sec,
  const size_t *rsizes, const size_t *secidx, size_t nrings, const unsigned char *m, size_t mlen);
@@ -41,6 +41,138 @@ SECP256K1_INLINE static void secp256k1_borromean_hash(unsigned char *hash, const
     secp256k1_sha256_finalize(&sha256_en, hash);
 }
 
+/* Number of rings of a single signature that secp256k1_borromean_verify
+ * processes in lockstep. */
+#define BORROMEAN_VERIFY_LOCKSTEP_RINGS 32
+
+/* Sets up st to verify ring ring of the sigidx-th signature, whose first member is at offset in s and pubs. */
+static void secp256k1_borromean_ring_init(secp256k1_borromean_ring_state *st, size_t sigidx, size_t ring, size_t offset) {
+    st->sig = sigidx;
+    st->ring = ring;
+    st->offset = offset;
+}
+
+/* Sets the challenge of each ring state[ring_idx[k]] to H(e||m||ring||j) like
+ * secp256k1_borromean_hash, where e is the last r of the ring, or the e0 of its
+ * signature if j is 0. The hashes are computed SECP256K1_SHA256_LANES at a time
+ * when the messages have the usual length of 32 bytes. Clears the result of
+ * signatures whose challenge overflows. */
+static void secp256k1_borromean_hash_rings(int *results, const secp256k1_borromean_sig *sigs, secp256k1_borromean_ring_state *state,
+ const size_t *ring_idx, size_t n, size_t j) {
+    unsigned char buf[SECP256K1_SHA256_LANES][33 + 32 + 8];
+    unsigned char hash[SECP256K1_SHA256_LANES][32];
+    const unsigned char *msg[SECP256K1_SHA256_LANES];
+    unsigned char *out[SECP256K1_SHA256_LANES];
+    secp256k1_sha256 sha256_en;
+    size_t elen = j == 0 ? 32 : 33;
+    size_t i;
+    size_t l;
+    int overflow;
+    secp256k1_sha256_initialize(&sha256_en);
+    for (l = 0; l < SECP256K1_SHA256_LANES; l++) {
+        msg[l] = buf[l];
+        out[l] = hash[l];
+    }
+    for (i = 0; i < n; i += SECP256K1_SHA256_LANES) {
+        size_t nl = n - i < SECP256K1_SHA256_LANES ? n - i : SECP256K1_SHA256_LANES;
+        int multi = 1;
+        for (l = 0; l < nl; l++) {
+            multi &= sigs[state[ring_idx[i + l]].sig].mlen == 32;
+        }
+        for (l = 0; l < nl; l++) {
+            const secp256k1_borromean_ring_state *st = &state[ring_idx[i + l]];
+            const secp256k1_borromean_sig *sig = &sigs[st->sig];
+            const unsigned char *e = j == 0 ? sig->e0 : st->r;
+            if (!multi) {
+                secp256k1_borromean_hash(hash[l], sig->m, sig->mlen, e, elen, st->ring, j);
+                continue;
+            }
+            memcpy(buf[l], e, elen);
+            memcpy(buf[l] + elen, sig->m, 32);
+            buf[l][elen + 32] = st->ring >> 24;
+            buf[l][elen + 33] = st->ring >> 16;
+            buf[l][elen + 34] = st->ring >> 8;
+            buf[l][elen + 35] = st->ring;
+            buf[l][elen + 36] = j >> 24;
+            buf[l][elen + 37] = j >> 16;
+            buf[l][elen + 38] = j >> 8;
+            buf[l][elen + 39] = j;
+        }
+        if (multi) {
+            secp256k1_sha256_finalize_multi(&sha256_en, out, msg, elen + 40, nl);
+        }
+        for (l = 0; l < nl; l++) {
+            secp256k1_borromean_ring_state *st = &state[ring_idx[i + l]];
+            secp256k1_scalar_set_b32(&st->ens, hash[l], &overflow);
+            if (overflow) {
+                results[st->sig] = 0;
+            }
+        }
+    }
+}
+
+/* Runs the challenge chains of nrings rings in lockstep: the j-th member of
+ * every ring is handled in the same step, so the conversion of all their r
+ * values to affine coordinates shares a single field inversion, and their
+ * challenges are hashed together. Afterwards state[i].r holds the
+ * serialization of the last r of ring i, unless results[state[i].sig] was
+ * cleared. */
+static void secp256k1_borromean_verify_lockstep(const secp256k1_ecmult_context* ecmult_ctx, int *results, const secp256k1_borromean_sig *sigs,
+ secp256k1_borromean_ring_state *state, size_t nrings, secp256k1_gej *rgej, secp256k1_ge *rge, size_t *active) {
+    size_t i;
+    size_t j;
+    size_t nactive;
+    size_t npending;
+    size_t max_rsize;
+    size_t size;
+    max_rsize = 0;
+    for (i = 0; i < nrings; i++) {
+        size_t rsize = sigs[state[i].sig].rsizes[state[i].ring];
+        if (rsize > max_rsize) {
+            max_rsize = rsize;
+        }
+        active[i] = i;
+    }
+    secp256k1_borromean_hash_rings(results, sigs, state, active, nrings, 0);
+    for (j = 0; j < max_rsize; j++) {
+        nactive = 0;
+        for (i = 0; i < nrings; i++) {
+            secp256k1_borromean_ring_state *st = &state[i];
+            const secp256k1_borromean_sig *sig = &sigs[st->sig];
+            size_t idx = st->offset + j;
+            if (!results[st->sig] || j >= sig->rsizes[st->ring]) {
+                continue;
+            }
+            if (secp256k1_scalar_is_zero(&sig->s[idx]) || secp256k1_scalar_is_zero(&st->ens) || secp256k1_gej_is_infinity(&sig->pubs[idx])) {
+                results[st->sig] = 0;
+                continue;
+            }
+            if (sig->evalues) {
+                /*If requested, save the challenges for proof rewind.*/
+                sig->evalues[idx] = st->ens;
+            }
+            secp256k1_ecmult(ecmult_ctx, &rgej[nactive], &sig->pubs[idx], &st->ens, &sig->s[idx]);
+            if (secp256k1_gej_is_infinity(&rgej[nactive])) {
+                results[st->sig] = 0;
+                continue;
+            }
+            active[nactive] = i;
+            nactive++;
+        }
+        secp256k1_ge_set_all_gej_var(rge, rgej, nactive);
+        npending = 0;
+        for (i = 0; i < nactive; i++) {
+            secp256k1_borromean_ring_state *st = &state[active[i]];
+            secp256k1_eckey_pubkey_serialize(&rge[i], st->r, &size, 1);
+            if (j != sigs[st->sig].rsizes[st->ring] - 1) {
+                active[npending] = active[i];
+                npending++;
+            }
+        }
+        secp256k1_borromean_hash_rings(results, sigs, state, active, npending, j + 1);
+    }
+}
+
 /**  "Borromean" ring signature.
  *   Verifies nrings concurrent ring signatures all sharing a challenge value.
  *   Signature is one s value per pubkey and a hash.
@@ -54,19 +186,23 @@ SECP256K1_INLINE static void secp256k1_borromean_hash(unsigned char *hash, const
  *   | | | en = to_scalar(e)
  *   | | r_i = r
  *   | return e_0 ==== H(r_{0..i}||m)
+ *   The rings are independent until the final hash, so up to
+ *   BORROMEAN_VERIFY_LOCKSTEP_RINGS of them are processed in lockstep.
  */
 int secp256k1_borromean_verify(const secp256k1_ecmult_context* ecmult_ctx, secp256k1_scalar *evalues, const unsigned char *e0,
  const secp256k1_scalar *s, const secp256k1_gej *pubs, const size_t *rsizes, size_t nrings, const unsigned char *m, size_t mlen) {
-    secp256k1_gej rgej;
-    secp256k1_ge rge;
-    secp256k1_scalar ens;
+    secp256k1_borromean_sig sig;
+    secp256k1_borromean_ring_state state[BORROMEAN_VERIFY_LOCKSTEP_RINGS];
+    secp256k1_gej rgej[BORROMEAN_VERIFY_LOCKSTEP_RINGS];
+    secp256k1_ge rge[BORROMEAN_VERIFY_LOCKSTEP_RINGS];
+    size_t active[BORROMEAN_VERIFY_LOCKSTEP_RINGS];
     secp256k1_sha256 sha256_e0;
-    unsigned char tmp[33];
+    unsigned char tmp[32];
     size_t i;
     size_t j;
+    size_t n;
     size_t count;
-    size_t size;
-    int overflow;
+    int result;
     VERIFY_CHECK(ecmult_ctx != NULL);
     VERIFY_CHECK(e0 != NULL);
     VERIFY_CHECK(s != NULL);
@@ -74,34 +210,32 @@ int secp256k1_borromean_verify(const secp256k1_ecmult_context* ecmult_ctx, secp2
     VERIFY_CHECK(rsizes != NULL);
     VERIFY_CHECK(nrings > 0);
     VERIFY_CHECK(m != NULL);
+    sig.evalues = evalues;
+    sig.e0 = e0;
+    sig.s = s;
+    sig.pubs = pubs;
+    sig.rsizes = rsizes;
+    sig.nrings = nrings;
+    sig.m = m;
+    sig.mlen = mlen;
+    result = 1;
     count = 0;
     secp256k1_sha256_initialize(&sha256_e0);
-    for (i = 0; i < nrings; i++) {
-        VERIFY_CHECK(INT_MAX - count > rsizes[i]);
-        secp256k1_borromean_hash(tmp, m, mlen, e0, 32, i, 0);
-        secp256k1_scalar_set_b32(&ens, tmp, &overflow);
-        for (j = 0; j < rsizes[i]; j++) {
-            if (overflow || secp256k1_scalar_is_zero(&s[count]) || secp256k1_scalar_is_zero(&ens) || secp256k1_gej_is_infinity(&pubs[count])) {
-                return 0;
-            }
-            if (evalues) {
-                /*If requested, save the challenges for proof rewind.*/
-                evalues[count] = ens;
-            }
-            secp256k1_ecmult(ecmult_ctx, &rgej, &pubs[count], &ens, &s[count]);
-            if (secp256k1_gej_is_infinity(&rgej)) {
-                return 0;
-            }
-            /* OPT: loop can be hoisted and split to use batch inversion across all the rings; this would make it much faster. */
-            secp256k1_ge_set_gej_var(&rge, &rgej);
-            secp256k1_eckey_pubkey_serialize(&rge, tmp, &size, 1);
-            if (j != rsizes[i] - 1) {
-                secp256k1_borromean_hash(tmp, m, mlen, tmp, 33, i, j + 1);
-                secp256k1_scalar_set_b32(&ens, tmp, &overflow);
-            } else {
-                secp256k1_sha256_write(&sha256_e0, tmp, size);
-            }
-            count++;
+    for (i = 0; i < nrings; i += n) {
+        n = nrings - i < BORROMEAN_VERIFY_LOCKSTEP_RINGS ? nrings - i : BORROMEAN_VERIFY_LOCKSTEP_RINGS;
+        for (j = 0; j < n; j++) {
+            VERIFY_CHECK(INT_MAX - count > rsizes[i + j]);
+            secp256k1_borromean_ring_init(&state[j], 0, i + j, count);
+            count += rsizes[i + j];
+        }
+        secp256k1_borromean_verify_lockstep(ecmult_ctx, &result, &sig, state, n, rgej, rge, active);
+        if (!result) {
+            return 0;
+        }
+        /* The groups of rings are consecutive, so the final r values are
+         * hashed in ring order. */
+        for (j = 0; j < n; j++) {
+            secp256k1_sha256_write(&sha256_e0, state[j].r, 33);
         }
     }
     secp256k1_sha256_write(&sha256_e0, m, mlen);
@@ -109,10 +243,64 @@ int secp256k1_borromean_verify(const secp256k1_ecmult_context* ecmult_ctx, secp2
     return memcmp(e0, tmp, 32) == 0;
 }
 
+/** Same as secp256k1_borromean_verify for a batch of signatures, with the
+ *  rings of all signatures processed in lockstep.
+ */
+static int secp256k1_borromean_verify_batch(const secp256k1_ecmult_context* ecmult_ctx, int *results, const secp256k1_borromean_sig *sigs, size_t n_sigs,
+ secp256k1_borromean_ring_state *state, secp256k1_gej *rgej, secp256k1_ge *rge, size_t *active) {
+    unsigned char tmp[32];
+    size_t i;
+    size_t j;
+    size_t k;
+    size_t nrings;
+    int ret;
+    VERIFY_CHECK(ecmult_ctx != NULL);
+    VERIFY_CHECK(results != NULL);
+    VERIFY_CHECK(sigs != NULL);
+    VERIFY_CHECK(state != NULL);
+    VERIFY_CHECK(rgej != NULL);
+    VERIFY_CHECK(rge != NULL);
+    VERIFY_CHECK(active != NULL);
+    nrings = 0;
+    for (k = 0; k < n_sigs; k++) {
+        size_t count = 0;
+        VERIFY_CHECK(sigs[k].nrings > 0);
+        results[k] = 1;
+        for (i = 0; i < sigs[k].nrings; i++) {
+            VERIFY_CHECK(INT_MAX - count > sigs[k].rsizes[i]);
+            secp256k1_borromean_ring_init(&state[nrings], k, i, count);
+            count += sigs[k].rsizes[i];
+            nrings++;
+        }
+    }
+    secp256k1_borromean_verify_lockstep(ecmult_ctx, results, sigs, state, nrings, rgej, rge, active);
+    ret = 1;
+    i = 0;
+    for (k = 0; k < n_sigs; k++) {
+        secp256k1_sha256 sha256_e0;
+        if (!results[k]) {
+            i += sigs[k].nrings;
+            ret = 0;
+            continue;
+        }
+        secp256k1_sha256_initialize(&sha256_e0);
+        for (j = 0; j < sigs[k].nrings; j++) {
+            secp256k1_sha256_write(&sha256_e0, state[i].r, 33);
+            i++;
+        }
+        secp256k1_sha256_write(&sha256_e0, sigs[k].m, sigs[k].mlen);
+        secp256k1_sha256_finalize(&sha256_e0, tmp);
+        results[k] &= memcmp(sigs[k].e0, tmp, 32) == 0;
+        ret &= results[k];
+    }
+    return ret;
+}
+
 int secp256k1_borromean_sign(const secp256k1_ecmult_context* ecmult_ctx, const secp256k1_ecmult_gen_context *ecmult_gen_ctx,
  unsigned char *e0, secp256k1_scalar *s, const secp256k1_gej *pubs, const secp256k1_scalar *k, const secp256k1_scalar *sec,
  const size_t *rsizes, const size_t *secidx, size_t nrings, const unsigned char *m, size_t mlen) {
     secp256k1_gej rgej;
+    secp256k1_gej kgej[SECP256K1_FE_LANES];
     secp256k1_ge rge;
     secp256k1_scalar ens;
     secp256k1_sha256 sha256_e0;
@@ -137,7 +325,11 @@ int secp256k1_borromean_sign(const secp256k1_ecmult_context* ecmult_ctx, const s
     count = 0;
     for (i = 0; i < nrings; i++) {
         VERIFY_CHECK(INT_MAX - count > rsizes[i]);
-        secp256k1_ecmult_gen(ecmult_gen_ctx, &rgej, &k[i]);
+        if (i % SECP256K1_FE_LANES == 0) {
+            /* Compute the nonce commitments of the next few rings at once. */
+            secp256k1_ecmult_gen_multi(ecmult_gen_ctx, kgej, &k[i], nrings - i < SECP256K1_FE_LANES ? nrings - i : SECP256K1_FE_LANES);
+        }
+        rgej = kgej[i % SECP256K1_FE_LANES];
         secp256k1_ge_set_gej(&rge, &rgej);
         if (secp256k1_gej_is_infinity(&rgej)) {
             return 0;
@@ -275,6 +275,147 @@ int secp256k1_rangeproof_verify(const secp256k1_context* ctx, uint64_t *min_valu
      NULL, NULL, NULL, NULL, NULL, min_value, max_value, &commitp, proof, plen, extra_commit, extra_commit_len, &genp);
 }
 
+/* Space needed by secp256k1_rangeproof_verify_batch for each proof verified at once. */
+typedef struct {
+    secp256k1_gej pubs[128];
+    secp256k1_scalar s[128];
+    size_t rsizes[32];
+    unsigned char m[33];
+} secp256k1_rangeproof_batch_proof;
+
+#define RANGEPROOF_VERIFY_BATCH_SCRATCH_OBJECTS 8
+
+static size_t secp256k1_rangeproof_verify_batch_scratch_size(size_t n_proofs) {
+    static const size_t proof_size = sizeof(secp256k1_rangeproof_batch_proof) + sizeof(secp256k1_borromean_sig) + sizeof(int) + sizeof(size_t)
+        + 32 * (sizeof(secp256k1_borromean_ring_state) + sizeof(secp256k1_gej) + sizeof(secp256k1_ge) + sizeof(size_t));
+    return n_proofs * proof_size;
+}
+
+int secp256k1_rangeproof_verify_batch(const secp256k1_context* ctx, secp256k1_scratch_space *scratch, int *results, uint64_t *min_value, uint64_t *max_value,
+ const secp256k1_pedersen_commitment * const *commit, const unsigned char * const *proof, const size_t *plen, const unsigned char * const *extra_commit, const size_t *extra_commit_len,
+ const secp256k1_generator * const *gen, size_t n_proofs) {
+    secp256k1_rangeproof_batch_proof *proofs;
+    secp256k1_borromean_sig *sigs;
+    secp256k1_borromean_ring_state *state;
+    secp256k1_gej *rgej;
+    secp256k1_ge *rge;
+    size_t *active;
+    size_t *index;
+    int *valid;
+    size_t scratch_checkpoint;
+    size_t chunk;
+    size_t i;
+    int ret = 1;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    if (n_proofs > 0) {
+        ARG_CHECK(commit != NULL);
+        ARG_CHECK(proof != NULL);
+        ARG_CHECK(plen != NULL);
+        ARG_CHECK(extra_commit == NULL || extra_commit_len != NULL);
+        ARG_CHECK(gen != NULL);
+    }
+    for (i = 0; i < n_proofs; i++) {
+        ARG_CHECK(extra_commit == NULL || extra_commit[i] != NULL || extra_commit_len[i] == 0);
+    }
+
+    chunk = 0;
+    if (scratch != NULL) {
+        chunk = secp256k1_scratch_max_allocation(&ctx->error_callback, scratch, RANGEPROOF_VERIFY_BATCH_SCRATCH_OBJECTS) / secp256k1_rangeproof_verify_batch_scratch_size(1);
+        if (chunk > n_proofs) {
+            chunk = n_proofs;
+        }
+    }
+    if (chunk > 0) {
+        scratch_checkpoint = secp256k1_scratch_checkpoint(&ctx->error_callback, scratch);
+        proofs = (secp256k1_rangeproof_batch_proof*)secp256k1_scratch_alloc(&ctx->error_callback, scratch, chunk * sizeof(secp256k1_rangeproof_batch_proof));
+        sigs = (secp256k1_borromean_sig*)secp256k1_scratch_alloc(&ctx->error_callback, scratch, chunk * sizeof(secp256k1_borromean_sig));
+        valid = (int*)secp256k1_scratch_alloc(&ctx->error_callback, scratch, chunk * sizeof(int));
+        index = (size_t*)secp256k1_scratch_alloc(&ctx->error_callback, scratch, chunk * sizeof(size_t));
+        state = (secp256k1_borromean_ring_state*)secp256k1_scratch_alloc(&ctx->error_callback, scratch, 32 * chunk * sizeof(secp256k1_borromean_ring_state));
+        rgej = (secp256k1_gej*)secp256k1_scratch_alloc(&ctx->error_callback, scratch, 32 * chunk * sizeof(secp256k1_gej));
+        rge = (secp256k1_ge*)secp256k1_scratch_alloc(&ctx->error_callback, scratch, 32 * chunk * sizeof(secp256k1_ge));
+        active = (size_t*)secp256k1_scratch_alloc(&ctx->error_callback, scratch, 32 * chunk * sizeof(size_t));
+        if (proofs == NULL || sigs == NULL || valid == NULL || index == NULL || state == NULL || rgej == NULL || rge == NULL || active == NULL) {
+            secp256k1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+            chunk = 0;
+        }
+    }
+    if (chunk == 0) {
+        /* No scratch space for a batch of even a single proof */
+        for (i = 0; i < n_proofs; i++) {
+            secp256k1_ge commitp;
+            secp256k1_ge genp;
+            uint64_t minv = 0, maxv = 0;
+            int valid_i;
+            secp256k1_pedersen_commitment_load(&commitp, commit[i]);
+            secp256k1_generator_load(&genp, gen[i]);
+            valid_i = secp256k1_rangeproof_verify_impl(&ctx->ecmult_ctx, NULL, NULL, NULL, NULL, NULL, NULL, &minv, &maxv, &commitp, proof[i], plen[i],
+             extra_commit != NULL ? extra_commit[i] : NULL, extra_commit != NULL ? extra_commit_len[i] : 0, &genp);
+            if (results != NULL) {
+                results[i] = valid_i;
+            }
+            if (min_value != NULL) {
+                min_value[i] = minv;
+            }
+            if (max_value != NULL) {
+                max_value[i] = maxv;
+            }
+            ret &= valid_i;
+        }
+        return ret;
+    }
+
+    i = 0;
+    while (i < n_proofs) {
+        size_t n_sigs = 0;
+        size_t k;
+        for (; i < n_proofs && n_sigs < chunk; i++) {
+            secp256k1_rangeproof_batch_proof *p = &proofs[n_sigs];
+            secp256k1_borromean_sig *sig = &sigs[n_sigs];
+            secp256k1_ge commitp;
+            secp256k1_ge genp;
+            size_t offset_post_header;
+            uint64_t scale;
+            uint64_t minv = 0, maxv = 0;
+            int valid_i;
+            secp256k1_pedersen_commitment_load(&commitp, commit[i]);
+            secp256k1_generator_load(&genp, gen[i]);
+            valid_i = secp256k1_rangeproof_verify_prepare(p->pubs, p->s, p->rsizes, &sig->nrings, p->m, &sig->e0, &offset_post_header, &scale,
+             &minv, &maxv, &commitp, proof[i], plen[i], extra_commit != NULL ? extra_commit[i] : NULL, extra_commit != NULL ? extra_commit_len[i] : 0, &genp);
+            if (min_value != NULL) {
+                min_value[i] = minv;
+            }
+            if (max_value != NULL) {
+                max_value[i] = maxv;
+            }
+            if (!valid_i) {
+                if (results != NULL) {
+                    results[i] = 0;
+                }
+                ret = 0;
+                continue;
+            }
+            sig->evalues = NULL;
+            sig->s = p->s;
+            sig->pubs = p->pubs;
+            sig->rsizes = p->rsizes;
+            sig->m = p->m;
+            sig->mlen = 32;
+            index[n_sigs] = i;
+            n_sigs++;
+        }
+        ret &= secp256k1_borromean_verify_batch(&ctx->ecmult_ctx, valid, sigs, n_sigs, state, rgej, rge, active);
+        if (results != NULL) {
+            for (k = 0; k < n_sigs; k++) {
+                results[index[k]] = valid[k];
+            }
+        }
+    }
+    secp256k1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+    return ret;
+}
+
 int secp256k1_rangeproof_sign(const secp256k1_context* ctx, unsigned char *proof, size_t *plen, uint64_t min_value,
  const secp256k1_pedersen_commitment *commit, const unsigned char *blind, const unsigned char *nonce, int exp, int min_bits, uint64_t value,
  const unsigned char *message, size_t msg_len, const unsigned char *extra_commit, size_t extra_commit_len, const secp256k1_generator* gen){
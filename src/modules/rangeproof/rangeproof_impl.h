@@ -537,19 +537,14 @@ SECP256K1_INLINE static int secp256k1_rangeproof_getheader_impl(size_t *offset,
     return 1;
 }
 
-/* Verifies range proof (len plen) for commit, the min/max values proven are put in the min/max arguments; returns 0 on failure 1 on success.*/
-SECP256K1_INLINE static int secp256k1_rangeproof_verify_impl(const secp256k1_ecmult_context* ecmult_ctx,
- const secp256k1_ecmult_gen_context* ecmult_gen_ctx,
- unsigned char *blindout, uint64_t *value_out, unsigned char *message_out, size_t *outlen, const unsigned char *nonce,
+/* Parses the range proof (len plen) for commit and computes the inputs to its Borromean signature verification:
+ * the ring public keys, s values, ring sizes and the message hash m. Returns 0 if the proof is malformed. */
+SECP256K1_INLINE static int secp256k1_rangeproof_verify_prepare(secp256k1_gej *pubs, secp256k1_scalar *s, size_t *rsizes, size_t *rings_out,
+ unsigned char *m, const unsigned char **e0, size_t *offset_post_header, uint64_t *scale,
  uint64_t *min_value, uint64_t *max_value, const secp256k1_ge *commit, const unsigned char *proof, size_t plen, const unsigned char *extra_commit, size_t extra_commit_len, const secp256k1_ge* genp) {
     secp256k1_gej accj;
-    secp256k1_gej pubs[128];
     secp256k1_ge c;
-    secp256k1_scalar s[128];
-    secp256k1_scalar evalues[128]; /* Challenges, only used during proof rewind. */
     secp256k1_sha256 sha256_m;
-    size_t rsizes[32];
-    int ret;
     size_t i;
     int exp;
     int mantissa;
@@ -557,16 +552,12 @@ SECP256K1_INLINE static int secp256k1_rangeproof_verify_impl(const secp256k1_ecm
     size_t rings;
     int overflow;
     size_t npub;
-    int offset_post_header;
-    uint64_t scale;
     unsigned char signs[31];
-    unsigned char m[33];
-    const unsigned char *e0;
     offset = 0;
-    if (!secp256k1_rangeproof_getheader_impl(&offset, &exp, &mantissa, &scale, min_value, max_value, proof, plen)) {
+    if (!secp256k1_rangeproof_getheader_impl(&offset, &exp, &mantissa, scale, min_value, max_value, proof, plen)) {
         return 0;
     }
-    offset_post_header = offset;
+    *offset_post_header = offset;
     rings = 1;
     rsizes[0] = 1;
     npub = 1;
@@ -632,7 +623,7 @@ SECP256K1_INLINE static int secp256k1_rangeproof_verify_impl(const secp256k1_ecm
     }
     secp256k1_rangeproof_pub_expand(pubs, exp, rsizes, rings, genp);
     npub += rsizes[rings - 1];
-    e0 = &proof[offset];
+    *e0 = &proof[offset];
     offset += 32;
     for (i = 0; i < npub; i++) {
         secp256k1_scalar_set_b32(&s[i], &proof[offset], &overflow);
@@ -649,6 +640,30 @@ SECP256K1_INLINE static int secp256k1_rangeproof_verify_impl(const secp256k1_ecm
         secp256k1_sha256_write(&sha256_m, extra_commit, extra_commit_len);
     }
     secp256k1_sha256_finalize(&sha256_m, m);
+    *rings_out = rings;
+    return 1;
+}
+
+/* Verifies range proof (len plen) for commit, the min/max values proven are put in the min/max arguments; returns 0 on failure 1 on success.*/
+SECP256K1_INLINE static int secp256k1_rangeproof_verify_impl(const secp256k1_ecmult_context* ecmult_ctx,
+ const secp256k1_ecmult_gen_context* ecmult_gen_ctx,
+ unsigned char *blindout, uint64_t *value_out, unsigned char *message_out, size_t *outlen, const unsigned char *nonce,
+ uint64_t *min_value, uint64_t *max_value, const secp256k1_ge *commit, const unsigned char *proof, size_t plen, const unsigned char *extra_commit, size_t extra_commit_len, const secp256k1_ge* genp) {
+    secp256k1_gej accj;
+    secp256k1_gej pubs[128];
+    secp256k1_scalar s[128];
+    secp256k1_scalar evalues[128]; /* Challenges, only used during proof rewind. */
+    size_t rsizes[32];
+    int ret;
+    size_t rings;
+    size_t offset_post_header;
+    uint64_t scale;
+    unsigned char m[33];
+    const unsigned char *e0;
+    if (!secp256k1_rangeproof_verify_prepare(pubs, s, rsizes, &rings, m, &e0, &offset_post_header, &scale,
+     min_value, max_value, commit, proof, plen, extra_commit, extra_commit_len, genp)) {
+        return 0;
+    }
     ret = secp256k1_borromean_verify(ecmult_ctx, nonce ? evalues : NULL, e0, s, pubs, rsizes, rings, m, 32);
     if (ret && nonce) {
         /* Given the nonce, try rewinding the witness to recover its initial state. */
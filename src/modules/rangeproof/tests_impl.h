@@ -227,6 +227,42 @@ static void test_rangeproof_api(const secp256k1_context *none, const secp256k1_c
         CHECK(secp256k1_rangeproof_rewind(both, blind_out, &value_out, NULL, 0, commit.data, &min_value, &max_value, &commit, proof, len, NULL, 0, NULL) == 0);
         CHECK(*ecount == 35);
     }
+    {
+        const secp256k1_pedersen_commitment *commit_ptr = &commit;
+        const unsigned char *proof_ptr = proof;
+        const unsigned char *ext_commit_ptr = ext_commit;
+        const unsigned char *null_ext_commit_ptr = NULL;
+        const secp256k1_generator *gen_ptr = secp256k1_generator_h;
+        int result;
+        uint64_t min_value;
+        uint64_t max_value;
+
+        CHECK(secp256k1_rangeproof_verify_batch(none, NULL, &result, &min_value, &max_value, &commit_ptr, &proof_ptr, &len, &ext_commit_ptr, &ext_commit_len, &gen_ptr, 1) == 0);
+        CHECK(*ecount == 36);
+        CHECK(secp256k1_rangeproof_verify_batch(vrfy, NULL, &result, &min_value, &max_value, &commit_ptr, &proof_ptr, &len, &ext_commit_ptr, &ext_commit_len, &gen_ptr, 1) == 1);
+        CHECK(result == 1);
+        CHECK(min_value == vmin);
+        CHECK(max_value >= val);
+        CHECK(*ecount == 36);
+        CHECK(secp256k1_rangeproof_verify_batch(vrfy, NULL, NULL, NULL, NULL, &commit_ptr, &proof_ptr, &len, &ext_commit_ptr, &ext_commit_len, &gen_ptr, 1) == 1);
+        CHECK(*ecount == 36);
+        CHECK(secp256k1_rangeproof_verify_batch(vrfy, NULL, NULL, NULL, NULL, NULL, &proof_ptr, &len, &ext_commit_ptr, &ext_commit_len, &gen_ptr, 1) == 0);
+        CHECK(*ecount == 37);
+        CHECK(secp256k1_rangeproof_verify_batch(vrfy, NULL, NULL, NULL, NULL, &commit_ptr, NULL, &len, &ext_commit_ptr, &ext_commit_len, &gen_ptr, 1) == 0);
+        CHECK(*ecount == 38);
+        CHECK(secp256k1_rangeproof_verify_batch(vrfy, NULL, NULL, NULL, NULL, &commit_ptr, &proof_ptr, NULL, &ext_commit_ptr, &ext_commit_len, &gen_ptr, 1) == 0);
+        CHECK(*ecount == 39);
+        CHECK(secp256k1_rangeproof_verify_batch(vrfy, NULL, NULL, NULL, NULL, &commit_ptr, &proof_ptr, &len, &ext_commit_ptr, NULL, &gen_ptr, 1) == 0);
+        CHECK(*ecount == 40);
+        CHECK(secp256k1_rangeproof_verify_batch(vrfy, NULL, NULL, NULL, NULL, &commit_ptr, &proof_ptr, &len, &null_ext_commit_ptr, &ext_commit_len, &gen_ptr, 1) == 0);
+        CHECK(*ecount == 41);
+        CHECK(secp256k1_rangeproof_verify_batch(vrfy, NULL, NULL, NULL, NULL, &commit_ptr, &proof_ptr, &len, NULL, NULL, &gen_ptr, 1) == 0);
+        CHECK(*ecount == 41);
+        CHECK(secp256k1_rangeproof_verify_batch(vrfy, NULL, NULL, NULL, NULL, &commit_ptr, &proof_ptr, &len, &ext_commit_ptr, &ext_commit_len, NULL, 1) == 0);
+        CHECK(*ecount == 42);
+        CHECK(secp256k1_rangeproof_verify_batch(vrfy, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0) == 1);
+        CHECK(*ecount == 42);
+    }
 }
 
 static void test_api(void) {
@@ -318,21 +354,25 @@ static void test_pedersen(void) {
 
 static void test_borromean(void) {
     unsigned char e0[32];
-    secp256k1_scalar s[64];
-    secp256k1_gej pubs[64];
-    secp256k1_scalar k[8];
-    secp256k1_scalar sec[8];
+    secp256k1_scalar s[(BORROMEAN_VERIFY_LOCKSTEP_RINGS + 8) * 8];
+    secp256k1_gej pubs[(BORROMEAN_VERIFY_LOCKSTEP_RINGS + 8) * 8];
+    secp256k1_scalar k[BORROMEAN_VERIFY_LOCKSTEP_RINGS + 8];
+    secp256k1_scalar sec[BORROMEAN_VERIFY_LOCKSTEP_RINGS + 8];
     secp256k1_ge ge;
     secp256k1_scalar one;
     unsigned char m[32];
-    size_t rsizes[8];
-    size_t secidx[8];
+    size_t rsizes[BORROMEAN_VERIFY_LOCKSTEP_RINGS + 8];
+    size_t secidx[BORROMEAN_VERIFY_LOCKSTEP_RINGS + 8];
     size_t nrings;
     size_t i;
     size_t j;
     int c;
     secp256k1_rand256_test(m);
     nrings = 1 + (secp256k1_rand32()&7);
+    if ((secp256k1_rand32()&7) == 0) {
+        /* More rings than are verified in lockstep at once */
+        nrings += BORROMEAN_VERIFY_LOCKSTEP_RINGS;
+    }
     c = 0;
     secp256k1_scalar_set_int(&one, 1);
     if (secp256k1_rand32()&1) {
@@ -607,6 +647,87 @@ void test_multiple_generators(void) {
     }
 }
 
+#define N_BATCH_PROOFS 8
+
+void test_rangeproof_verify_batch(void) {
+    unsigned char proof[N_BATCH_PROOFS][5134];
+    size_t plen[N_BATCH_PROOFS];
+    secp256k1_pedersen_commitment commit[N_BATCH_PROOFS];
+    secp256k1_generator gen[N_BATCH_PROOFS];
+    const unsigned char *proof_ptr[N_BATCH_PROOFS];
+    const secp256k1_pedersen_commitment *commit_ptr[N_BATCH_PROOFS];
+    const secp256k1_generator *gen_ptr[N_BATCH_PROOFS];
+    const unsigned char *extra_commit[N_BATCH_PROOFS];
+    size_t extra_commit_len[N_BATCH_PROOFS];
+    int expected[N_BATCH_PROOFS];
+    uint64_t expected_min[N_BATCH_PROOFS];
+    uint64_t expected_max[N_BATCH_PROOFS];
+    int results[N_BATCH_PROOFS];
+    uint64_t min_value[N_BATCH_PROOFS];
+    uint64_t max_value[N_BATCH_PROOFS];
+    secp256k1_scratch_space *scratch[3];
+    const unsigned char ext_commit[13] = "extra commit";
+    unsigned char blind[32];
+    unsigned char seed[32];
+    size_t i;
+    int k, t;
+
+    for (i = 0; i < N_BATCH_PROOFS; i++) {
+        uint64_t v = secp256k1_rands64(0, INT64_MAX - 1);
+        uint64_t vmin = i & 1 ? secp256k1_rands64(0, v) : 0;
+        int exp = (int)(i % 3) - 1;
+        int min_bits = secp256k1_rand_int(65);
+        secp256k1_rand256(blind);
+        secp256k1_rand256(seed);
+        CHECK(secp256k1_generator_generate(ctx, &gen[i], seed));
+        CHECK(secp256k1_pedersen_commit(ctx, &commit[i], blind, v, &gen[i]));
+        extra_commit[i] = i & 2 ? ext_commit : NULL;
+        extra_commit_len[i] = i & 2 ? sizeof(ext_commit) : 0;
+        plen[i] = sizeof(proof[i]);
+        CHECK(secp256k1_rangeproof_sign(ctx, proof[i], &plen[i], vmin, &commit[i], blind, commit[i].data, exp, min_bits, v, NULL, 0, extra_commit[i], extra_commit_len[i], &gen[i]));
+        proof_ptr[i] = proof[i];
+        commit_ptr[i] = &commit[i];
+        gen_ptr[i] = &gen[i];
+    }
+    /* Invalidate some of the proofs in different ways */
+    proof[1][plen[1] - 1] ^= 1;
+    commit_ptr[4] = &commit[5];
+    plen[6]--;
+    for (i = 0; i < N_BATCH_PROOFS; i++) {
+        expected[i] = secp256k1_rangeproof_verify(ctx, &expected_min[i], &expected_max[i], commit_ptr[i], proof[i], plen[i], extra_commit[i], extra_commit_len[i], gen_ptr[i]);
+        CHECK(expected[i] == (i != 1 && i != 4 && i != 6));
+    }
+
+    /* Large enough for all proofs, for a single proof and for none */
+    scratch[0] = secp256k1_scratch_space_create(ctx, secp256k1_rangeproof_verify_batch_scratch_size(N_BATCH_PROOFS) + RANGEPROOF_VERIFY_BATCH_SCRATCH_OBJECTS*ALIGNMENT);
+    scratch[1] = secp256k1_scratch_space_create(ctx, secp256k1_rangeproof_verify_batch_scratch_size(1) + RANGEPROOF_VERIFY_BATCH_SCRATCH_OBJECTS*ALIGNMENT);
+    scratch[2] = NULL;
+    for (k = 0; k < 3; k++) {
+        CHECK(secp256k1_rangeproof_verify_batch(ctx, scratch[k], results, min_value, max_value, commit_ptr, proof_ptr, plen, extra_commit, extra_commit_len, gen_ptr, N_BATCH_PROOFS) == 0);
+        for (i = 0; i < N_BATCH_PROOFS; i++) {
+            CHECK(results[i] == expected[i]);
+            if (expected[i]) {
+                CHECK(min_value[i] == expected_min[i]);
+                CHECK(max_value[i] == expected_max[i]);
+            }
+        }
+        /* A single valid or invalid proof */
+        for (t = 0; t < 2; t++) {
+            size_t n = t;
+            CHECK(secp256k1_rangeproof_verify_batch(ctx, scratch[k], results, NULL, NULL, &commit_ptr[n], &proof_ptr[n], &plen[n], &extra_commit[n], &extra_commit_len[n], &gen_ptr[n], 1) == (t == 0));
+            CHECK(results[0] == (t == 0));
+        }
+        CHECK(secp256k1_rangeproof_verify_batch(ctx, scratch[k], NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0) == 1);
+        if (scratch[k] != NULL) {
+            CHECK(secp256k1_scratch_checkpoint(&ctx->error_callback, scratch[k]) == 0);
+        }
+    }
+    secp256k1_scratch_space_destroy(ctx, scratch[0]);
+    secp256k1_scratch_space_destroy(ctx, scratch[1]);
+}
+
+#undef N_BATCH_PROOFS
+
 void test_rangeproof_fixed_vectors(void) {
     const unsigned char vector_1[] = {
         0x62, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x56, 0x02, 0x2a, 0x5c, 0x42, 0x0e, 0x1d,
@@ -703,6 +824,7 @@ void run_rangeproof_tests(void) {
         test_borromean();
     }
     test_rangeproof();
+    test_rangeproof_verify_batch();
     test_multiple_generators();
 }
 
@@ -44,18 +44,85 @@ static void secp256k1_schnorrsig_sha256_tagged(secp256k1_sha256 *sha) {
     sha->bytes = 64;
 }
 
-int secp256k1_schnorrsig_sign(const secp256k1_context* ctx, secp256k1_schnorrsig *sig, const unsigned char *msg32, const unsigned char *seckey, secp256k1_nonce_function noncefp, void *ndata) {
-    secp256k1_scalar x;
+/* Derives the nonce k for signing msg32 with the secret key x. Returns 0 if the
+ * nonce function fails or returns zero. */
+static int secp256k1_schnorrsig_nonce(secp256k1_scalar *k, const unsigned char *msg32, const secp256k1_scalar *x, secp256k1_nonce_function noncefp, void *ndata) {
+    unsigned char buf[32];
+    unsigned char seckey_tmp[32];
+    int ret;
+
+    if (noncefp == NULL) {
+        noncefp = secp256k1_nonce_function_bipschnorr;
+    }
+
+    secp256k1_scalar_get_b32(seckey_tmp, x);
+    ret = noncefp(buf, msg32, seckey_tmp, (unsigned char *) "BIPSchnorrDerive", (void*)ndata, 0);
+    memset(seckey_tmp, 0, sizeof(seckey_tmp));
+    if (ret) {
+        secp256k1_scalar_set_b32(k, buf, NULL);
+        ret = !secp256k1_scalar_is_zero(k);
+    }
+    memset(buf, 0, sizeof(buf));
+    return ret;
+}
+
+/* Completes the signature of msg32 given the nonce point r = k*G, the secret key
+ * x and its public key pk, which must have a square Y (i.e. x has already been
+ * negated if necessary). Clears k. */
+static void secp256k1_schnorrsig_sign_finish(secp256k1_schnorrsig *sig, const unsigned char *msg32, const secp256k1_scalar *x, secp256k1_scalar *k, secp256k1_ge *r, secp256k1_ge *pk) {
     secp256k1_scalar e;
+    secp256k1_sha256 sha;
+    unsigned char buf[32];
+
+    if (!secp256k1_fe_is_quad_var(&r->y)) {
+        secp256k1_scalar_negate(k, k);
+    }
+    secp256k1_fe_normalize(&r->x);
+    secp256k1_fe_get_b32(&sig->data[0], &r->x);
+
+    /* tagged hash(r.x, pk.x, msg32) */
+    secp256k1_schnorrsig_sha256_tagged(&sha);
+    secp256k1_sha256_write(&sha, &sig->data[0], 32);
+    secp256k1_fe_normalize(&pk->x);
+    secp256k1_fe_get_b32(buf, &pk->x);
+    secp256k1_sha256_write(&sha, buf, sizeof(buf));
+    secp256k1_sha256_write(&sha, msg32, 32);
+    secp256k1_sha256_finalize(&sha, buf);
+
+    secp256k1_scalar_set_b32(&e, buf, NULL);
+    secp256k1_scalar_mul(&e, &e, x);
+    secp256k1_scalar_add(&e, &e, k);
+
+    secp256k1_scalar_get_b32(&sig->data[32], &e);
+    secp256k1_scalar_clear(k);
+}
+
+/* Signs msg32 with the secret key x, whose public key pk must have a square Y
+ * (i.e. x has already been negated if necessary). Clears x. */
+static int secp256k1_schnorrsig_sign_internal(const secp256k1_context* ctx, secp256k1_schnorrsig *sig, const unsigned char *msg32, secp256k1_scalar *x, secp256k1_ge *pk, secp256k1_nonce_function noncefp, void *ndata) {
     secp256k1_scalar k;
-    secp256k1_gej pkj;
     secp256k1_gej rj;
-    secp256k1_ge pk;
     secp256k1_ge r;
-    secp256k1_sha256 sha;
+
+    if (!secp256k1_schnorrsig_nonce(&k, msg32, x, noncefp, ndata)) {
+        memset(sig, 0, sizeof(*sig));
+        secp256k1_scalar_clear(x);
+        return 0;
+    }
+
+    secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &rj, &k);
+    secp256k1_ge_set_gej(&r, &rj);
+    secp256k1_schnorrsig_sign_finish(sig, msg32, x, &k, &r, pk);
+    secp256k1_scalar_clear(x);
+
+    return 1;
+}
+
+int secp256k1_schnorrsig_sign(const secp256k1_context* ctx, secp256k1_schnorrsig *sig, const unsigned char *msg32, const unsigned char *seckey, secp256k1_nonce_function noncefp, void *ndata) {
+    secp256k1_scalar x;
+    secp256k1_gej pkj;
+    secp256k1_ge pk;
     int overflow;
-    unsigned char buf[32];
-    unsigned char seckey_tmp[32];
 
     VERIFY_CHECK(ctx != NULL);
     ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
@@ -63,9 +130,6 @@ int secp256k1_schnorrsig_sign(const secp256k1_context* ctx, secp256k1_schnorrsig
     ARG_CHECK(msg32 != NULL);
     ARG_CHECK(seckey != NULL);
 
-    if (noncefp == NULL) {
-        noncefp = secp256k1_nonce_function_bipschnorr;
-    }
     secp256k1_scalar_set_b32(&x, seckey, &overflow);
     /* Fail if the secret key is invalid. */
     if (overflow || secp256k1_scalar_is_zero(&x)) {
@@ -83,49 +147,81 @@ int secp256k1_schnorrsig_sign(const secp256k1_context* ctx, secp256k1_schnorrsig
         secp256k1_scalar_negate(&x, &x);
     }
 
-    secp256k1_scalar_get_b32(seckey_tmp, &x);
-    if (!noncefp(buf, msg32, seckey_tmp, (unsigned char *) "BIPSchnorrDerive", (void*)ndata, 0)) {
-        memset(sig, 0, sizeof(*sig));
-        memset(seckey_tmp, 0, sizeof(seckey_tmp));
-        secp256k1_scalar_clear(&x);
-        return 0;
-    }
-    memset(seckey_tmp, 0, sizeof(seckey_tmp));
+    return secp256k1_schnorrsig_sign_internal(ctx, sig, msg32, &x, &pk, noncefp, ndata);
+}
 
-    secp256k1_scalar_set_b32(&k, buf, NULL);
-    if (secp256k1_scalar_is_zero(&k)) {
-        memset(sig, 0, sizeof(*sig));
-        secp256k1_scalar_clear(&x);
-        return 0;
-    }
+int secp256k1_schnorrsig_sign_keypair(const secp256k1_context* ctx, secp256k1_schnorrsig *sig, const unsigned char *msg32, const secp256k1_keypair *keypair, secp256k1_nonce_function noncefp, void *ndata) {
+    secp256k1_scalar x;
+    secp256k1_ge pk;
 
-    secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &rj, &k);
-    secp256k1_ge_set_gej(&r, &rj);
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(sig != NULL);
+    ARG_CHECK(msg32 != NULL);
+    ARG_CHECK(keypair != NULL);
 
-    if (!secp256k1_fe_is_quad_var(&r.y)) {
-        secp256k1_scalar_negate(&k, &k);
+    /* The keypair already holds the secret key negated as needed for its
+     * x-only public key. */
+    if (!secp256k1_keypair_load(ctx, &x, &pk, keypair)) {
+        memset(sig, 0, sizeof(*sig));
+        return 0;
     }
-    secp256k1_fe_normalize(&r.x);
-    secp256k1_fe_get_b32(&sig->data[0], &r.x);
 
-    /* tagged hash(r.x, pk.x, msg32) */
-    secp256k1_schnorrsig_sha256_tagged(&sha);
-    secp256k1_sha256_write(&sha, &sig->data[0], 32);
-    secp256k1_fe_normalize(&pk.x);
-    secp256k1_fe_get_b32(buf, &pk.x);
-    secp256k1_sha256_write(&sha, buf, sizeof(buf));
-    secp256k1_sha256_write(&sha, msg32, 32);
-    secp256k1_sha256_finalize(&sha, buf);
+    return secp256k1_schnorrsig_sign_internal(ctx, sig, msg32, &x, &pk, noncefp, ndata);
+}
 
-    secp256k1_scalar_set_b32(&e, buf, NULL);
-    secp256k1_scalar_mul(&e, &e, &x);
-    secp256k1_scalar_add(&e, &e, &k);
+/* Number of nonce points secp256k1_schnorrsig_sign_batch converts to affine
+ * coordinates with a single field inversion. */
+#define SCHNORRSIG_SIGN_BATCH_CHUNK 64
 
-    secp256k1_scalar_get_b32(&sig->data[32], &e);
-    secp256k1_scalar_clear(&k);
-    secp256k1_scalar_clear(&x);
+int secp256k1_schnorrsig_sign_batch(const secp256k1_context* ctx, secp256k1_schnorrsig *sig, const unsigned char *const *msg32, const secp256k1_keypair *const *keypair, size_t n_sigs, secp256k1_nonce_function noncefp, void *ndata) {
+    secp256k1_scalar x[SCHNORRSIG_SIGN_BATCH_CHUNK];
+    secp256k1_scalar k[SCHNORRSIG_SIGN_BATCH_CHUNK];
+    secp256k1_ge pk[SCHNORRSIG_SIGN_BATCH_CHUNK];
+    secp256k1_gej rj[SCHNORRSIG_SIGN_BATCH_CHUNK];
+    secp256k1_ge r[SCHNORRSIG_SIGN_BATCH_CHUNK];
+    int valid[SCHNORRSIG_SIGN_BATCH_CHUNK];
+    size_t i, j;
+    int ret = 1;
 
-    return 1;
+    VERIFY_CHECK(ctx != NULL);
+    if (n_sigs == 0) {
+        return 1;
+    }
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(sig != NULL);
+    ARG_CHECK(msg32 != NULL);
+    ARG_CHECK(keypair != NULL);
+
+    for (i = 0; i < n_sigs; i += SCHNORRSIG_SIGN_BATCH_CHUNK) {
+        size_t m = n_sigs - i < SCHNORRSIG_SIGN_BATCH_CHUNK ? n_sigs - i : SCHNORRSIG_SIGN_BATCH_CHUNK;
+
+        /* Failed signatures get a nonce of one, so that no nonce point is
+         * infinity in the batch inversion. */
+        for (j = 0; j < m; j++) {
+            valid[j] = secp256k1_keypair_load(ctx, &x[j], &pk[j], keypair[i + j]) &&
+                       secp256k1_schnorrsig_nonce(&k[j], msg32[i + j], &x[j], noncefp, ndata);
+            if (!valid[j]) {
+                secp256k1_scalar_set_int(&k[j], 1);
+            }
+        }
+        secp256k1_ecmult_gen_multi(&ctx->ecmult_gen_ctx, rj, k, m);
+        secp256k1_ge_set_all_gej(r, rj, m);
+
+        for (j = 0; j < m; j++) {
+            if (valid[j]) {
+                secp256k1_schnorrsig_sign_finish(&sig[i + j], msg32[i + j], &x[j], &k[j], &r[j], &pk[j]);
+            } else {
+                memset(&sig[i + j], 0, sizeof(sig[i + j]));
+            }
+            ret &= valid[j];
+        }
+        for (j = 0; j < m; j++) {
+            secp256k1_scalar_clear(&x[j]);
+            secp256k1_scalar_clear(&k[j]);
+        }
+    }
+    return ret;
 }
 
 int secp256k1_schnorrsig_verify(const secp256k1_context* ctx, const secp256k1_schnorrsig *sig, const unsigned char *msg32, const secp256k1_xonly_pubkey *pubkey) {
@@ -184,6 +280,10 @@ typedef struct {
      * avoids having to call the PRNG twice as often. The very first randomizer will be set to 1 and
      * the PRNG is called at every odd indexed schnorrsig to fill the cache. */
     secp256k1_scalar randomizer_cache[2];
+    /* Caches the challenges of the SECP256K1_SHA256_LANES signatures starting
+     * at index challenge_cache_start, which are hashed together. */
+    secp256k1_scalar challenge_cache[SECP256K1_SHA256_LANES];
+    size_t challenge_cache_start;
     /* Signature, message, public key tuples to verify */
     const secp256k1_schnorrsig *const *sig;
     const unsigned char *const *msg32;
@@ -191,25 +291,48 @@ typedef struct {
     size_t n_sigs;
 } secp256k1_schnorrsig_verify_ecmult_context;
 
-/* Callback function which is called by ecmult_multi in order to convert the ecmult_context
- * consisting of signature, message and public key tuples into scalars and points. */
-static int secp256k1_schnorrsig_verify_batch_ecmult_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data) {
-    secp256k1_schnorrsig_verify_ecmult_context *ecmult_context = (secp256k1_schnorrsig_verify_ecmult_context *) data;
+/* Fills the challenge cache with the challenges e of the signatures starting at
+ * index start, hashing them SECP256K1_SHA256_LANES at a time. */
+static void secp256k1_schnorrsig_verify_batch_challenges(secp256k1_schnorrsig_verify_ecmult_context *ecmult_context, size_t start) {
+    unsigned char buf[SECP256K1_SHA256_LANES][96];
+    unsigned char hash[SECP256K1_SHA256_LANES][32];
+    const unsigned char *msg[SECP256K1_SHA256_LANES];
+    unsigned char *out[SECP256K1_SHA256_LANES];
+    secp256k1_sha256 sha;
+    size_t n = ecmult_context->n_sigs - start < SECP256K1_SHA256_LANES ? ecmult_context->n_sigs - start : SECP256K1_SHA256_LANES;
+    size_t i;
 
-    if (idx % 4 == 2) {
-        /* Every idx corresponds to a (scalar,point)-tuple. So this callback is called with 4
-         * consecutive tuples before we need to call the RNG for new randomizers:
-         * (-randomizer_cache[0], R1)
-         * (-randomizer_cache[0]*e1, P1)
-         * (-randomizer_cache[1], R2)
-         * (-randomizer_cache[1]*e2, P2) */
-        secp256k1_scalar_chacha20(&ecmult_context->randomizer_cache[0], &ecmult_context->randomizer_cache[1], ecmult_context->chacha_seed, idx / 4);
+    for (i = 0; i < n; i++) {
+        secp256k1_ge pk;
+        int r;
+        /* See verify_batch_ecmult_term for why this can't fail */
+        r = secp256k1_xonly_pubkey_load(ecmult_context->ctx, &pk, ecmult_context->pk[start + i]);
+        (void)r;
+        VERIFY_CHECK(r);
+        memcpy(buf[i], &ecmult_context->sig[start + i]->data[0], 32);
+        secp256k1_fe_get_b32(&buf[i][32], &pk.x);
+        memcpy(&buf[i][64], ecmult_context->msg32[start + i], 32);
+    }
+    for (i = 0; i < SECP256K1_SHA256_LANES; i++) {
+        msg[i] = buf[i];
+        out[i] = hash[i];
     }
+    secp256k1_schnorrsig_sha256_tagged(&sha);
+    secp256k1_sha256_finalize_multi(&sha, out, msg, 96, n);
+    for (i = 0; i < n; i++) {
+        secp256k1_scalar_set_b32(&ecmult_context->challenge_cache[i], hash[i], NULL);
+    }
+    ecmult_context->challenge_cache_start = start;
+}
 
+/* Computes the (scalar,point)-tuple with index idx given the randomizer of signature idx / 2:
+ * (randomizer, R) for even and (randomizer*e, P) for odd idx. If challenge is NULL, e is
+ * computed here, otherwise it must point to e. */
+static int secp256k1_schnorrsig_verify_batch_ecmult_term(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, const secp256k1_schnorrsig_verify_ecmult_context *ecmult_context, const secp256k1_scalar *randomizer, const secp256k1_scalar *challenge) {
     /* R */
     if (idx % 2 == 0) {
         secp256k1_fe rx;
-        *sc = ecmult_context->randomizer_cache[(idx / 2) % 2];
+        *sc = *randomizer;
         if (!secp256k1_fe_set_b32(&rx, &ecmult_context->sig[idx / 2]->data[0])) {
             return 0;
         }
@@ -227,19 +350,64 @@ static int secp256k1_schnorrsig_verify_batch_ecmult_callback(secp256k1_scalar *s
          * succeeds.*/
         VERIFY_CHECK(secp256k1_xonly_pubkey_load(ecmult_context->ctx, pt, ecmult_context->pk[idx / 2]));
 
-        secp256k1_schnorrsig_sha256_tagged(&sha);
-        secp256k1_sha256_write(&sha, &ecmult_context->sig[idx / 2]->data[0], 32);
-        secp256k1_fe_get_b32(buf, &pt->x);
-        secp256k1_sha256_write(&sha, buf, sizeof(buf));
-        secp256k1_sha256_write(&sha, ecmult_context->msg32[idx / 2], 32);
-        secp256k1_sha256_finalize(&sha, buf);
-
-        secp256k1_scalar_set_b32(sc, buf, NULL);
-        secp256k1_scalar_mul(sc, sc, &ecmult_context->randomizer_cache[(idx / 2) % 2]);
+        if (challenge != NULL) {
+            *sc = *challenge;
+        } else {
+            secp256k1_schnorrsig_sha256_tagged(&sha);
+            secp256k1_sha256_write(&sha, &ecmult_context->sig[idx / 2]->data[0], 32);
+            secp256k1_fe_get_b32(buf, &pt->x);
+            secp256k1_sha256_write(&sha, buf, sizeof(buf));
+            secp256k1_sha256_write(&sha, ecmult_context->msg32[idx / 2], 32);
+            secp256k1_sha256_finalize(&sha, buf);
+            secp256k1_scalar_set_b32(sc, buf, NULL);
+        }
+        secp256k1_scalar_mul(sc, sc, randomizer);
     }
     return 1;
 }
 
+/* Callback function which is called by ecmult_multi in order to convert the ecmult_context
+ * consisting of signature, message and public key tuples into scalars and points. */
+static int secp256k1_schnorrsig_verify_batch_ecmult_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data) {
+    secp256k1_schnorrsig_verify_ecmult_context *ecmult_context = (secp256k1_schnorrsig_verify_ecmult_context *) data;
+
+    if (idx % 4 == 2) {
+        /* Every idx corresponds to a (scalar,point)-tuple. So this callback is called with 4
+         * consecutive tuples before we need to call the RNG for new randomizers:
+         * (-randomizer_cache[0], R1)
+         * (-randomizer_cache[0]*e1, P1)
+         * (-randomizer_cache[1], R2)
+         * (-randomizer_cache[1]*e2, P2) */
+        secp256k1_scalar_chacha20(&ecmult_context->randomizer_cache[0], &ecmult_context->randomizer_cache[1], ecmult_context->chacha_seed, idx / 4);
+    }
+
+    if (idx % 2 == 1) {
+        size_t i = idx / 2;
+        if (ecmult_context->challenge_cache_start > i || i - ecmult_context->challenge_cache_start >= SECP256K1_SHA256_LANES) {
+            secp256k1_schnorrsig_verify_batch_challenges(ecmult_context, i - i % SECP256K1_SHA256_LANES);
+        }
+        return secp256k1_schnorrsig_verify_batch_ecmult_term(sc, pt, idx, ecmult_context, &ecmult_context->randomizer_cache[i % 2], &ecmult_context->challenge_cache[i - ecmult_context->challenge_cache_start]);
+    }
+    return secp256k1_schnorrsig_verify_batch_ecmult_term(sc, pt, idx, ecmult_context, &ecmult_context->randomizer_cache[(idx / 2) % 2], NULL);
+}
+
+/* Same as verify_batch_ecmult_callback, but derives the randomizer of every signature
+ * from scratch instead of relying on the cache filled by previous calls. This makes it
+ * safe to call concurrently and in any order, at the cost of one PRNG call per tuple. */
+static int secp256k1_schnorrsig_verify_batch_ecmult_callback_stateless(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data) {
+    const secp256k1_schnorrsig_verify_ecmult_context *ecmult_context = (const secp256k1_schnorrsig_verify_ecmult_context *) data;
+    secp256k1_scalar randomizer[2];
+    size_t i = idx / 2;
+
+    if (i == 0) {
+        secp256k1_scalar_set_int(&randomizer[0], 1);
+    } else {
+        /* Signature i uses the (i % 2)-th output of the PRNG call with counter (i - 1) / 2 */
+        secp256k1_scalar_chacha20(&randomizer[0], &randomizer[1], ecmult_context->chacha_seed, (i - 1) / 2);
+    }
+    return secp256k1_schnorrsig_verify_batch_ecmult_term(sc, pt, idx, ecmult_context, &randomizer[i % 2], NULL);
+}
+
 /** Helper function for batch verification. Hashes signature verification data into the
  *  randomization seed and initializes ecmult_context.
  *
@@ -282,6 +450,7 @@ static int secp256k1_schnorrsig_verify_batch_init_randomizer(const secp256k1_con
     ecmult_context->msg32 = msg32;
     ecmult_context->pk = pk;
     ecmult_context->n_sigs = n_sigs;
+    ecmult_context->challenge_cache_start = SIZE_MAX;
 
     return 1;
 }
@@ -355,4 +524,405 @@ int secp256k1_schnorrsig_verify_batch(const secp256k1_context *ctx, secp256k1_sc
             && secp256k1_gej_is_infinity(&rj);
 }
 
+int secp256k1_schnorrsig_verify_batch_parallel(const secp256k1_context *ctx, secp256k1_scratch *const *scratch, size_t n_scratch, const secp256k1_schnorrsig *const *sig, const unsigned char *const *msg32, const secp256k1_xonly_pubkey *const *pk, size_t n_sigs, secp256k1_parallel_for_function parallel_for, void *parallel_data) {
+    secp256k1_schnorrsig_verify_ecmult_context ecmult_context;
+    secp256k1_sha256 sha;
+    secp256k1_scalar s;
+    secp256k1_gej rj;
+    size_t i;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    ARG_CHECK(scratch != NULL);
+    ARG_CHECK(n_scratch > 0);
+    for (i = 0; i < n_scratch; i++) {
+        ARG_CHECK(scratch[i] != NULL);
+    }
+    ARG_CHECK(n_sigs <= SIZE_MAX / 2);
+    ARG_CHECK(n_sigs < ((uint32_t)1 << 31));
+
+    secp256k1_sha256_initialize(&sha);
+    if (!secp256k1_schnorrsig_verify_batch_init_randomizer(ctx, &ecmult_context, &sha, sig, msg32, pk, n_sigs)) {
+        return 0;
+    }
+    secp256k1_sha256_finalize(&sha, ecmult_context.chacha_seed);
+
+    secp256k1_scalar_clear(&s);
+    if (!secp256k1_schnorrsig_verify_batch_sum_s(&s, ecmult_context.chacha_seed, sig, n_sigs)) {
+        return 0;
+    }
+    secp256k1_scalar_negate(&s, &s);
+
+    return secp256k1_ecmult_multi_var_parallel(&ctx->error_callback, &ctx->ecmult_ctx, scratch, n_scratch, &rj, &s, secp256k1_schnorrsig_verify_batch_ecmult_callback_stateless, (void *) &ecmult_context, 2 * n_sigs, parallel_for, parallel_data)
+            && secp256k1_gej_is_infinity(&rj);
+}
+
+/* A signature of secp256k1_schnorrsig_verify_batch_find_invalid, parsed together with its
+ * challenge e and randomizer a. */
+typedef struct {
+    secp256k1_scalar a;
+    secp256k1_scalar s;
+    secp256k1_scalar e;
+    secp256k1_ge r;
+    secp256k1_ge p;
+    size_t idx;
+} secp256k1_schnorrsig_verify_batch_item;
+
+typedef struct {
+    const secp256k1_context *ctx;
+    secp256k1_scratch *scratch;
+    const secp256k1_schnorrsig_verify_batch_item *items;
+    int *results;
+} secp256k1_schnorrsig_verify_bisect_context;
+
+/* ecmult_multi callback returning (a, R) for even and (a*e, P) for odd idx. */
+static int secp256k1_schnorrsig_verify_items_ecmult_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data) {
+    const secp256k1_schnorrsig_verify_batch_item *item = &((const secp256k1_schnorrsig_verify_batch_item *) data)[idx / 2];
+    if (idx % 2 == 0) {
+        *sc = item->a;
+        *pt = item->r;
+    } else {
+        secp256k1_scalar_mul(sc, &item->e, &item->a);
+        *pt = item->p;
+    }
+    return 1;
+}
+
+/* Computes rj = -(a1*s1 + ... + au*su)G + a1*R1 + ... + au*Ru + (a1*e1)P1 + ... + (au*eu)Pu
+ * for the items [lo, hi). It is infinity if all of them are valid. */
+static int secp256k1_schnorrsig_verify_items_sum(const secp256k1_schnorrsig_verify_bisect_context *bisect_context, secp256k1_gej *rj, size_t lo, size_t hi) {
+    secp256k1_scalar s;
+    size_t i;
+
+    secp256k1_scalar_clear(&s);
+    for (i = lo; i < hi; i++) {
+        secp256k1_scalar as;
+        secp256k1_scalar_mul(&as, &bisect_context->items[i].s, &bisect_context->items[i].a);
+        secp256k1_scalar_add(&s, &s, &as);
+    }
+    secp256k1_scalar_negate(&s, &s);
+    return secp256k1_ecmult_multi_var(&bisect_context->ctx->error_callback, &bisect_context->ctx->ecmult_ctx, bisect_context->scratch, rj, &s, secp256k1_schnorrsig_verify_items_ecmult_callback, (void *) &bisect_context->items[lo], 2 * (hi - lo));
+}
+
+/* Sets the results of the items [lo, hi) one by one. */
+static void secp256k1_schnorrsig_verify_items_single(const secp256k1_schnorrsig_verify_bisect_context *bisect_context, size_t lo, size_t hi) {
+    size_t i;
+    for (i = lo; i < hi; i++) {
+        const secp256k1_schnorrsig_verify_batch_item *item = &bisect_context->items[i];
+        secp256k1_scalar e;
+        secp256k1_gej rj;
+        secp256k1_gej pj;
+        secp256k1_ge r;
+
+        /* Compute rj = s*G + (-e)*P - R */
+        secp256k1_scalar_negate(&e, &item->e);
+        secp256k1_gej_set_ge(&pj, &item->p);
+        secp256k1_ecmult(&bisect_context->ctx->ecmult_ctx, &rj, &pj, &e, &item->s);
+        secp256k1_ge_neg(&r, &item->r);
+        secp256k1_gej_add_ge_var(&rj, &rj, &r, NULL);
+        bisect_context->results[item->idx] = secp256k1_gej_is_infinity(&rj);
+    }
+}
+
+/* Sets the results of the items [lo, hi), given the sum of their terms as computed by
+ * verify_items_sum. If it is not infinity, the range is split in halves. Only the sum of
+ * the first half needs a multi-multiplication: the sum of the second half is the
+ * difference. */
+static void secp256k1_schnorrsig_verify_items_bisect(const secp256k1_schnorrsig_verify_bisect_context *bisect_context, size_t lo, size_t hi, const secp256k1_gej *sum) {
+    secp256k1_gej sum_lo;
+    secp256k1_gej sum_hi;
+    size_t i;
+    size_t mid;
+
+    if (secp256k1_gej_is_infinity(sum) || hi - lo == 1) {
+        for (i = lo; i < hi; i++) {
+            bisect_context->results[bisect_context->items[i].idx] = secp256k1_gej_is_infinity(sum);
+        }
+        return;
+    }
+    mid = lo + (hi - lo) / 2;
+    if (!secp256k1_schnorrsig_verify_items_sum(bisect_context, &sum_lo, lo, mid)) {
+        secp256k1_schnorrsig_verify_items_single(bisect_context, lo, hi);
+        return;
+    }
+    secp256k1_gej_neg(&sum_hi, &sum_lo);
+    secp256k1_gej_add_var(&sum_hi, &sum_hi, sum, NULL);
+    secp256k1_schnorrsig_verify_items_bisect(bisect_context, lo, mid, &sum_lo);
+    secp256k1_schnorrsig_verify_items_bisect(bisect_context, mid, hi, &sum_hi);
+}
+
+/* Parses the signatures and computes their randomizers and challenges once, then verifies
+ * them as a batch. If that fails, the batch is bisected recursively, reusing the parsed
+ * items, until the invalid signatures are isolated. The randomizers are derived from all
+ * inputs as in secp256k1_schnorrsig_verify_batch, so they remain unpredictable for every
+ * sub-batch. */
+int secp256k1_schnorrsig_verify_batch_find_invalid(const secp256k1_context *ctx, secp256k1_scratch *scratch, int *results, const secp256k1_schnorrsig *const *sig, const unsigned char *const *msg32, const secp256k1_xonly_pubkey *const *pk, size_t n_sigs) {
+    secp256k1_schnorrsig_verify_ecmult_context ecmult_context;
+    secp256k1_schnorrsig_verify_bisect_context bisect_context;
+    secp256k1_schnorrsig_verify_batch_item *items;
+    secp256k1_sha256 sha;
+    secp256k1_gej sum;
+    size_t scratch_checkpoint;
+    size_t n_items = 0;
+    size_t i;
+    int ret = 1;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    ARG_CHECK(scratch != NULL);
+    ARG_CHECK(n_sigs <= SIZE_MAX / 2);
+    ARG_CHECK(n_sigs < ((uint32_t)1 << 31));
+    if (n_sigs == 0) {
+        return 1;
+    }
+    ARG_CHECK(results != NULL);
+    memset(results, 0, n_sigs * sizeof(*results));
+
+    secp256k1_sha256_initialize(&sha);
+    if (!secp256k1_schnorrsig_verify_batch_init_randomizer(ctx, &ecmult_context, &sha, sig, msg32, pk, n_sigs)) {
+        return 0;
+    }
+    secp256k1_sha256_finalize(&sha, ecmult_context.chacha_seed);
+
+    scratch_checkpoint = secp256k1_scratch_checkpoint(&ctx->error_callback, scratch);
+    items = (secp256k1_schnorrsig_verify_batch_item *) secp256k1_scratch_alloc(&ctx->error_callback, scratch, n_sigs * sizeof(*items));
+    if (items == NULL) {
+        /* Not enough scratch space to keep the parsed signatures: verify them one by one */
+        for (i = 0; i < n_sigs; i++) {
+            results[i] = secp256k1_schnorrsig_verify(ctx, sig[i], msg32[i], pk[i]);
+            ret &= results[i];
+        }
+        return ret;
+    }
+
+    secp256k1_scalar_set_int(&ecmult_context.randomizer_cache[0], 1);
+    for (i = 0; i < n_sigs; i++) {
+        secp256k1_schnorrsig_verify_batch_item *item = &items[n_items];
+        secp256k1_fe rx;
+        int overflow, r;
+
+        if (i % SECP256K1_SHA256_LANES == 0) {
+            secp256k1_schnorrsig_verify_batch_challenges(&ecmult_context, i);
+        }
+        if (i % 2 == 1) {
+            secp256k1_scalar_chacha20(&ecmult_context.randomizer_cache[0], &ecmult_context.randomizer_cache[1], ecmult_context.chacha_seed, i / 2);
+        }
+        /* Signatures that cannot be parsed are invalid on their own and do not take part in
+         * the batch. */
+        secp256k1_scalar_set_b32(&item->s, &sig[i]->data[32], &overflow);
+        if (overflow || !secp256k1_fe_set_b32(&rx, &sig[i]->data[0]) || !secp256k1_ge_set_xquad(&item->r, &rx)) {
+            ret = 0;
+            continue;
+        }
+        /* See verify_batch_ecmult_term for why this can't fail */
+        r = secp256k1_xonly_pubkey_load(ctx, &item->p, pk[i]);
+        (void)r;
+        VERIFY_CHECK(r);
+        item->a = ecmult_context.randomizer_cache[i % 2];
+        item->e = ecmult_context.challenge_cache[i % SECP256K1_SHA256_LANES];
+        item->idx = i;
+        n_items++;
+    }
+
+    if (n_items > 0) {
+        bisect_context.ctx = ctx;
+        bisect_context.scratch = scratch;
+        bisect_context.items = items;
+        bisect_context.results = results;
+        if (secp256k1_schnorrsig_verify_items_sum(&bisect_context, &sum, 0, n_items)) {
+            secp256k1_schnorrsig_verify_items_bisect(&bisect_context, 0, n_items, &sum);
+        } else {
+            secp256k1_schnorrsig_verify_items_single(&bisect_context, 0, n_items);
+        }
+        for (i = 0; i < n_items; i++) {
+            ret &= results[items[i].idx];
+        }
+    }
+    secp256k1_scratch_apply_checkpoint(&ctx->error_callback, scratch, scratch_checkpoint);
+    return ret;
+}
+
+/* A signature added to a secp256k1_batch, as the two terms it contributes to the
+ * multiexponentiation: (a, R) and (a*e, P), where a is its randomizer. */
+typedef struct {
+    secp256k1_scalar a;
+    secp256k1_scalar ae;
+    secp256k1_ge r;
+    secp256k1_ge p;
+} secp256k1_batch_entry;
+
+struct secp256k1_batch_struct {
+    /* Hashes the signature, message, public key tuples added so far. The randomizer
+     * of every signature is derived from it right after the signature is written. */
+    secp256k1_sha256 sha;
+    /* Sum of a*s over the entries */
+    secp256k1_scalar sum_s;
+    secp256k1_batch_entry *entries;
+    size_t n_sigs;
+    size_t capacity;
+    /* 0 if a signature could not be added, which makes the batch invalid */
+    int result;
+};
+
+secp256k1_batch* secp256k1_batch_create(const secp256k1_context* ctx, size_t n_sigs) {
+    secp256k1_batch *batch;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(n_sigs < ((uint32_t)1 << 31));
+    ARG_CHECK(n_sigs <= SIZE_MAX / sizeof(secp256k1_batch_entry));
+
+    batch = (secp256k1_batch *) checked_malloc(&ctx->error_callback, sizeof(*batch));
+    if (batch == NULL) {
+        return NULL;
+    }
+    batch->entries = NULL;
+    if (n_sigs > 0) {
+        batch->entries = (secp256k1_batch_entry *) checked_malloc(&ctx->error_callback, n_sigs * sizeof(secp256k1_batch_entry));
+        if (batch->entries == NULL) {
+            free(batch);
+            return NULL;
+        }
+    }
+    secp256k1_sha256_initialize(&batch->sha);
+    secp256k1_scalar_clear(&batch->sum_s);
+    batch->n_sigs = 0;
+    batch->capacity = n_sigs;
+    batch->result = 1;
+    return batch;
+}
+
+void secp256k1_batch_destroy(const secp256k1_context* ctx, secp256k1_batch* batch) {
+    VERIFY_CHECK(ctx != NULL);
+    if (batch != NULL) {
+        free(batch->entries);
+        free(batch);
+    }
+}
+
+/* Makes room for one more entry, doubling the capacity if necessary. */
+static int secp256k1_batch_reserve(const secp256k1_context* ctx, secp256k1_batch *batch) {
+    secp256k1_batch_entry *entries;
+    size_t capacity;
+
+    if (batch->n_sigs < batch->capacity) {
+        return 1;
+    }
+    capacity = batch->capacity < 16 ? 16 : 2 * batch->capacity;
+    if (capacity > SIZE_MAX / sizeof(secp256k1_batch_entry)) {
+        return 0;
+    }
+    entries = (secp256k1_batch_entry *) checked_realloc(&ctx->error_callback, batch->entries, capacity * sizeof(secp256k1_batch_entry));
+    if (entries == NULL) {
+        return 0;
+    }
+    batch->entries = entries;
+    batch->capacity = capacity;
+    return 1;
+}
+
+static int secp256k1_batch_add_schnorrsig_internal(const secp256k1_context* ctx, secp256k1_batch *batch, const secp256k1_schnorrsig *sig, const unsigned char *msg32, const secp256k1_xonly_pubkey *pk) {
+    secp256k1_batch_entry *entry;
+    secp256k1_scalar s;
+    secp256k1_scalar e;
+    secp256k1_fe rx;
+    secp256k1_sha256 sha;
+    unsigned char pk_buf[33];
+    size_t pk_buflen = sizeof(pk_buf);
+    unsigned char buf[32];
+    int overflow;
+
+    ARG_CHECK(sig != NULL);
+    ARG_CHECK(msg32 != NULL);
+    ARG_CHECK(pk != NULL);
+    /* secp256k1_batch_verify passes 2*n_sigs terms to ecmult_multi, see
+     * secp256k1_schnorrsig_verify_batch for these limits. */
+    ARG_CHECK(batch->n_sigs < SIZE_MAX / 2);
+    ARG_CHECK(batch->n_sigs < ((uint32_t)1 << 31) - 1);
+    if (!secp256k1_batch_reserve(ctx, batch)) {
+        return 0;
+    }
+    entry = &batch->entries[batch->n_sigs];
+
+    if (!secp256k1_xonly_pubkey_load(ctx, &entry->p, pk)) {
+        return 0;
+    }
+    secp256k1_scalar_set_b32(&s, &sig->data[32], &overflow);
+    if (overflow) {
+        return 0;
+    }
+    if (!secp256k1_fe_set_b32(&rx, &sig->data[0]) || !secp256k1_ge_set_xquad(&entry->r, &rx)) {
+        return 0;
+    }
+
+    /* The randomizer. As in verify_batch_init_randomizer, the public key is hashed in
+     * compressed form rather than as an x-only public key. */
+    secp256k1_sha256_write(&batch->sha, sig->data, 64);
+    secp256k1_sha256_write(&batch->sha, msg32, 32);
+    /* Can't fail because the loaded public key is not infinity */
+    secp256k1_eckey_pubkey_serialize(&entry->p, pk_buf, &pk_buflen, 1);
+    secp256k1_sha256_write(&batch->sha, pk_buf, pk_buflen);
+    sha = batch->sha;
+    secp256k1_sha256_finalize(&sha, buf);
+    secp256k1_scalar_set_b32(&entry->a, buf, NULL);
+
+    /* The challenge e = tagged hash(r.x, pk.x, msg32) */
+    secp256k1_schnorrsig_sha256_tagged(&sha);
+    secp256k1_sha256_write(&sha, &sig->data[0], 32);
+    secp256k1_sha256_write(&sha, &pk_buf[1], 32);
+    secp256k1_sha256_write(&sha, msg32, 32);
+    secp256k1_sha256_finalize(&sha, buf);
+    secp256k1_scalar_set_b32(&e, buf, NULL);
+
+    secp256k1_scalar_mul(&entry->ae, &e, &entry->a);
+    secp256k1_scalar_mul(&s, &s, &entry->a);
+    secp256k1_scalar_add(&batch->sum_s, &batch->sum_s, &s);
+    batch->n_sigs++;
+    return 1;
+}
+
+int secp256k1_batch_add_schnorrsig(const secp256k1_context* ctx, secp256k1_batch *batch, const secp256k1_schnorrsig *sig, const unsigned char *msg32, const secp256k1_xonly_pubkey *pk) {
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(batch != NULL);
+
+    if (!secp256k1_batch_add_schnorrsig_internal(ctx, batch, sig, msg32, pk)) {
+        /* The batch must not verify without this signature, even if the caller ignores
+         * the return value. */
+        batch->result = 0;
+        return 0;
+    }
+    return 1;
+}
+
+/* ecmult_multi callback returning (a, R) for even and (a*e, P) for odd idx. */
+static int secp256k1_batch_ecmult_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data) {
+    const secp256k1_batch_entry *entry = &((const secp256k1_batch_entry *) data)[idx / 2];
+    if (idx % 2 == 0) {
+        *sc = entry->a;
+        *pt = entry->r;
+    } else {
+        *sc = entry->ae;
+        *pt = entry->p;
+    }
+    return 1;
+}
+
+/* Checks 0 == -(a1*s1 + ... + au*su)G + a1*R1 + ... + au*Ru + (a1*e1)P1 + ... + (au*eu)Pu
+ * with the terms computed when the signatures were added. */
+int secp256k1_batch_verify(const secp256k1_context *ctx, secp256k1_scratch *scratch, const secp256k1_batch *batch) {
+    secp256k1_scalar s;
+    secp256k1_gej rj;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    ARG_CHECK(scratch != NULL);
+    ARG_CHECK(batch != NULL);
+
+    if (!batch->result) {
+        return 0;
+    }
+    secp256k1_scalar_negate(&s, &batch->sum_s);
+    return secp256k1_ecmult_multi_var(&ctx->error_callback, &ctx->ecmult_ctx, scratch, &rj, &s, secp256k1_batch_ecmult_callback, (void *) batch->entries, 2 * batch->n_sigs)
+            && secp256k1_gej_is_infinity(&rj);
+}
+
 #endif
@@ -33,6 +33,9 @@ void test_schnorrsig_api(secp256k1_scratch_space *scratch) {
     const unsigned char *msgptr = msg;
     const secp256k1_xonly_pubkey *pkptr = &pk[0];
     const secp256k1_xonly_pubkey *zeroptr = &zero_pk;
+    secp256k1_scratch_space *null_scratch = NULL;
+    secp256k1_batch *batch;
+    int result;
 
     /** setup **/
     secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
@@ -128,6 +131,79 @@ void test_schnorrsig_api(secp256k1_scratch_space *scratch) {
     CHECK(secp256k1_schnorrsig_verify_batch(vrfy, scratch, &sigptr, &msgptr, &zeroptr, 1) == 0);
     CHECK(ecount == 9);
 
+    ecount = 0;
+    CHECK(secp256k1_schnorrsig_verify_batch_parallel(none, &scratch, 1, &sigptr, &msgptr, &pkptr, 1, NULL, NULL) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_schnorrsig_verify_batch_parallel(vrfy, &scratch, 1, &sigptr, &msgptr, &pkptr, 1, NULL, NULL) == 1);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_schnorrsig_verify_batch_parallel(vrfy, NULL, 1, &sigptr, &msgptr, &pkptr, 1, NULL, NULL) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_schnorrsig_verify_batch_parallel(vrfy, &scratch, 0, &sigptr, &msgptr, &pkptr, 1, NULL, NULL) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_schnorrsig_verify_batch_parallel(vrfy, &null_scratch, 1, &sigptr, &msgptr, &pkptr, 1, NULL, NULL) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_schnorrsig_verify_batch_parallel(vrfy, &scratch, 1, NULL, NULL, NULL, 0, NULL, NULL) == 1);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_schnorrsig_verify_batch_parallel(vrfy, &scratch, 1, NULL, &msgptr, &pkptr, 1, NULL, NULL) == 0);
+    CHECK(ecount == 5);
+    CHECK(secp256k1_schnorrsig_verify_batch_parallel(vrfy, &scratch, 1, &sigptr, &msgptr, &pkptr, (uint32_t)1 << 31, NULL, NULL) == 0);
+    CHECK(ecount == 6);
+
+    ecount = 0;
+    CHECK(secp256k1_schnorrsig_verify_batch_find_invalid(none, scratch, &result, &sigptr, &msgptr, &pkptr, 1) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_schnorrsig_verify_batch_find_invalid(vrfy, scratch, &result, &sigptr, &msgptr, &pkptr, 1) == 1);
+    CHECK(result == 1);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_schnorrsig_verify_batch_find_invalid(vrfy, NULL, &result, &sigptr, &msgptr, &pkptr, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_schnorrsig_verify_batch_find_invalid(vrfy, scratch, NULL, NULL, NULL, NULL, 0) == 1);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_schnorrsig_verify_batch_find_invalid(vrfy, scratch, NULL, &sigptr, &msgptr, &pkptr, 1) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_schnorrsig_verify_batch_find_invalid(vrfy, scratch, &result, NULL, &msgptr, &pkptr, 1) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_schnorrsig_verify_batch_find_invalid(vrfy, scratch, &result, &sigptr, &msgptr, &pkptr, (uint32_t)1 << 31) == 0);
+    CHECK(ecount == 5);
+    CHECK(secp256k1_schnorrsig_verify_batch_find_invalid(vrfy, scratch, &result, &sigptr, &msgptr, &zeroptr, 1) == 0);
+    CHECK(result == 0);
+    CHECK(ecount == 6);
+
+    ecount = 0;
+    CHECK(secp256k1_batch_create(none, (uint32_t)1 << 31) == NULL);
+    CHECK(ecount == 1);
+    batch = secp256k1_batch_create(none, 0);
+    CHECK(batch != NULL);
+    CHECK(secp256k1_batch_add_schnorrsig(none, batch, &sig, msg, &pk[0]) == 1);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_batch_add_schnorrsig(none, NULL, &sig, msg, &pk[0]) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_batch_verify(none, scratch, batch) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_batch_verify(vrfy, scratch, batch) == 1);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_batch_verify(vrfy, NULL, batch) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_batch_verify(vrfy, scratch, NULL) == 0);
+    CHECK(ecount == 5);
+    /* A signature that can't be added invalidates the batch */
+    CHECK(secp256k1_batch_add_schnorrsig(none, batch, NULL, msg, &pk[0]) == 0);
+    CHECK(ecount == 6);
+    CHECK(secp256k1_batch_verify(vrfy, scratch, batch) == 0);
+    CHECK(ecount == 6);
+    secp256k1_batch_destroy(none, batch);
+    batch = secp256k1_batch_create(none, 1);
+    CHECK(secp256k1_batch_add_schnorrsig(none, batch, &sig, NULL, &pk[0]) == 0);
+    CHECK(ecount == 7);
+    CHECK(secp256k1_batch_add_schnorrsig(none, batch, &sig, msg, NULL) == 0);
+    CHECK(ecount == 8);
+    CHECK(secp256k1_batch_add_schnorrsig(none, batch, &sig, msg, &zero_pk) == 0);
+    CHECK(ecount == 9);
+    CHECK(secp256k1_batch_verify(vrfy, scratch, batch) == 0);
+    CHECK(ecount == 9);
+    secp256k1_batch_destroy(none, batch);
+    secp256k1_batch_destroy(none, NULL);
+
     secp256k1_context_destroy(none);
     secp256k1_context_destroy(sign);
     secp256k1_context_destroy(vrfy);
@@ -169,6 +245,7 @@ void test_schnorrsig_bip_vectors_check_verify(secp256k1_scratch_space *scratch,
     const secp256k1_xonly_pubkey *pk_arr[1];
     secp256k1_xonly_pubkey pk;
     secp256k1_schnorrsig sig;
+    int result;
 
     CHECK(secp256k1_xonly_pubkey_parse(ctx, &pk, pk_serialized));
     CHECK(secp256k1_schnorrsig_parse(ctx, &sig, sig_serialized));
@@ -179,6 +256,8 @@ void test_schnorrsig_bip_vectors_check_verify(secp256k1_scratch_space *scratch,
 
     CHECK(expected == secp256k1_schnorrsig_verify(ctx, &sig, msg32, &pk));
     CHECK(expected == secp256k1_schnorrsig_verify_batch(ctx, scratch, sig_arr, msg_arr, pk_arr, 1));
+    CHECK(expected == secp256k1_schnorrsig_verify_batch_find_invalid(ctx, scratch, &result, sig_arr, msg_arr, pk_arr, 1));
+    CHECK(expected == result);
 }
 
 /* Test vectors according to BIP-schnorr
@@ -631,6 +710,151 @@ void test_schnorrsig_sign(void) {
     CHECK(memcmp(&sig, zeros64, sizeof(sig)) == 0);
 }
 
+void test_schnorrsig_sign_keypair(void) {
+    unsigned char sk[32];
+    unsigned char msg[32];
+    secp256k1_keypair keypair;
+    secp256k1_xonly_pubkey pk;
+    secp256k1_schnorrsig sig, sig_keypair;
+    unsigned char zeros64[64];
+    int i;
+    int ecount = 0;
+    secp256k1_context *vrfy = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
+
+    memset(zeros64, 0, sizeof(zeros64));
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+    secp256k1_context_set_illegal_callback(vrfy, counting_illegal_callback_fn, &ecount);
+
+    /* Signatures are the same as those created from the secret key, with both
+     * possible signs of the public key's Y coordinate. */
+    for (i = 0; i < count; i++) {
+        secp256k1_rand256(sk);
+        secp256k1_rand256(msg);
+        if (!secp256k1_keypair_create(ctx, &keypair, sk)) {
+            continue;
+        }
+        CHECK(secp256k1_schnorrsig_sign(ctx, &sig, msg, sk, NULL, NULL) == 1);
+        CHECK(secp256k1_schnorrsig_sign_keypair(ctx, &sig_keypair, msg, &keypair, NULL, NULL) == 1);
+        CHECK(memcmp(&sig, &sig_keypair, sizeof(sig)) == 0);
+        CHECK(secp256k1_keypair_xonly_pub(ctx, &pk, &keypair) == 1);
+        CHECK(secp256k1_schnorrsig_verify(ctx, &sig_keypair, msg, &pk) == 1);
+    }
+
+    CHECK(ecount == 0);
+    CHECK(secp256k1_schnorrsig_sign_keypair(vrfy, &sig, msg, &keypair, NULL, NULL) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_schnorrsig_sign_keypair(ctx, NULL, msg, &keypair, NULL, NULL) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_schnorrsig_sign_keypair(ctx, &sig, NULL, &keypair, NULL, NULL) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_schnorrsig_sign_keypair(ctx, &sig, msg, NULL, NULL, NULL) == 0);
+    CHECK(ecount == 4);
+
+    memset(&sig, 1, sizeof(sig));
+    CHECK(secp256k1_schnorrsig_sign_keypair(ctx, &sig, msg, &keypair, nonce_function_failing, NULL) == 0);
+    CHECK(memcmp(&sig, zeros64, sizeof(sig)) == 0);
+    memset(&sig, 1, sizeof(sig));
+    CHECK(secp256k1_schnorrsig_sign_keypair(ctx, &sig, msg, &keypair, nonce_function_0, NULL) == 0);
+    CHECK(memcmp(&sig, zeros64, sizeof(sig)) == 0);
+
+    /* A keypair that could not be created cannot be used */
+    memset(sk, 0, sizeof(sk));
+    CHECK(secp256k1_keypair_create(ctx, &keypair, sk) == 0);
+    memset(&sig, 1, sizeof(sig));
+    CHECK(secp256k1_schnorrsig_sign_keypair(ctx, &sig, msg, &keypair, NULL, NULL) == 0);
+    CHECK(ecount == 5);
+    CHECK(memcmp(&sig, zeros64, sizeof(sig)) == 0);
+
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+    secp256k1_context_destroy(vrfy);
+}
+
+#define N_SIGS 80
+void test_schnorrsig_sign_batch(void) {
+    unsigned char sk[4][32];
+    unsigned char msg[N_SIGS][32];
+    secp256k1_keypair keypair[4];
+    secp256k1_schnorrsig sig[N_SIGS];
+    const unsigned char *msg_ptr[N_SIGS];
+    const secp256k1_keypair *keypair_ptr[N_SIGS];
+    unsigned char zeros64[64];
+    size_t n_sigs = secp256k1_rand_int(N_SIGS) + 1;
+    size_t bad = secp256k1_rand_int(n_sigs);
+    size_t i;
+    int ecount = 0;
+    secp256k1_context *vrfy = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
+
+    memset(zeros64, 0, sizeof(zeros64));
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+    secp256k1_context_set_illegal_callback(vrfy, counting_illegal_callback_fn, &ecount);
+    for (i = 0; i < 4; i++) {
+        secp256k1_scalar s;
+        random_scalar_order_test(&s);
+        secp256k1_scalar_get_b32(sk[i], &s);
+        CHECK(secp256k1_keypair_create(ctx, &keypair[i], sk[i]) == 1);
+    }
+    for (i = 0; i < N_SIGS; i++) {
+        secp256k1_rand256(msg[i]);
+        msg_ptr[i] = msg[i];
+        keypair_ptr[i] = &keypair[secp256k1_rand_int(4)];
+    }
+
+    CHECK(secp256k1_schnorrsig_sign_batch(vrfy, NULL, NULL, NULL, 0, NULL, NULL) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_schnorrsig_sign_batch(ctx, sig, msg_ptr, keypair_ptr, n_sigs, NULL, NULL) == 1);
+    for (i = 0; i < n_sigs; i++) {
+        secp256k1_schnorrsig sig1;
+        CHECK(secp256k1_schnorrsig_sign_keypair(ctx, &sig1, msg[i], keypair_ptr[i], NULL, NULL) == 1);
+        CHECK(memcmp(&sig1, &sig[i], sizeof(sig1)) == 0);
+    }
+    /* ndata is passed to every nonce function call */
+    CHECK(secp256k1_schnorrsig_sign_batch(ctx, sig, msg_ptr, keypair_ptr, n_sigs, NULL, msg[0]) == 1);
+    for (i = 0; i < n_sigs; i++) {
+        secp256k1_schnorrsig sig1;
+        CHECK(secp256k1_schnorrsig_sign_keypair(ctx, &sig1, msg[i], keypair_ptr[i], NULL, msg[0]) == 1);
+        CHECK(memcmp(&sig1, &sig[i], sizeof(sig1)) == 0);
+    }
+    CHECK(ecount == 0);
+
+    CHECK(secp256k1_schnorrsig_sign_batch(vrfy, sig, msg_ptr, keypair_ptr, n_sigs, NULL, NULL) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_schnorrsig_sign_batch(ctx, NULL, msg_ptr, keypair_ptr, n_sigs, NULL, NULL) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_schnorrsig_sign_batch(ctx, sig, NULL, keypair_ptr, n_sigs, NULL, NULL) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_schnorrsig_sign_batch(ctx, sig, msg_ptr, NULL, n_sigs, NULL, NULL) == 0);
+    CHECK(ecount == 4);
+
+    /* Failing nonce functions zero all signatures */
+    CHECK(secp256k1_schnorrsig_sign_batch(ctx, sig, msg_ptr, keypair_ptr, n_sigs, nonce_function_failing, NULL) == 0);
+    CHECK(secp256k1_schnorrsig_sign_batch(ctx, sig, msg_ptr, keypair_ptr, n_sigs, nonce_function_0, NULL) == 0);
+    for (i = 0; i < n_sigs; i++) {
+        CHECK(memcmp(&sig[i], zeros64, sizeof(sig[i])) == 0);
+    }
+
+    /* An invalid keypair only affects its own signature */
+    {
+        secp256k1_keypair zero_keypair;
+        memset(&zero_keypair, 0, sizeof(zero_keypair));
+        keypair_ptr[bad] = &zero_keypair;
+        CHECK(secp256k1_schnorrsig_sign_batch(ctx, sig, msg_ptr, keypair_ptr, n_sigs, NULL, NULL) == 0);
+        CHECK(ecount == 5);
+        for (i = 0; i < n_sigs; i++) {
+            if (i == bad) {
+                CHECK(memcmp(&sig[i], zeros64, sizeof(sig[i])) == 0);
+            } else {
+                secp256k1_xonly_pubkey pk;
+                CHECK(secp256k1_keypair_xonly_pub(ctx, &pk, keypair_ptr[i]) == 1);
+                CHECK(secp256k1_schnorrsig_verify(ctx, &sig[i], msg[i], &pk) == 1);
+            }
+        }
+    }
+
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+    secp256k1_context_destroy(vrfy);
+}
+#undef N_SIGS
+
 #define N_SIGS  200
 /* Creates N_SIGS valid signatures and verifies them with verify and verify_batch. Then flips some
  * bits and checks that verification now fails. */
@@ -692,6 +916,222 @@ void test_schnorrsig_sign_verify(secp256k1_scratch_space *scratch) {
 }
 #undef N_SIGS
 
+static void test_schnorrsig_parallel_for(void (*fn)(size_t idx, void *fn_data), void *fn_data, size_t n, void *data) {
+    size_t i;
+    (void) data;
+    /* Run the tasks in an order that differs from the natural one */
+    for (i = 0; i < n; i++) {
+        fn((i + 1) % n, fn_data);
+    }
+}
+
+#define N_SIGS  100
+#define N_SCRATCH  4
+/* Checks that verify_batch_parallel agrees with verify_batch for different numbers of tasks. */
+void test_schnorrsig_verify_batch_parallel(void) {
+    unsigned char sk[32];
+    unsigned char msg[N_SIGS][32];
+    secp256k1_schnorrsig sig[N_SIGS];
+    secp256k1_xonly_pubkey pk[N_SIGS];
+    const secp256k1_schnorrsig *sig_arr[N_SIGS];
+    const unsigned char *msg_arr[N_SIGS];
+    const secp256k1_xonly_pubkey *pk_arr[N_SIGS];
+    secp256k1_scratch_space *scratch[N_SCRATCH];
+    size_t n_scratch;
+    size_t i;
+
+    for (i = 0; i < N_SCRATCH; i++) {
+        scratch[i] = secp256k1_scratch_space_create(ctx, 256 * 1024);
+    }
+    for (i = 0; i < N_SIGS; i++) {
+        secp256k1_rand256(sk);
+        secp256k1_rand256(msg[i]);
+        CHECK(secp256k1_xonly_pubkey_create(ctx, &pk[i], sk));
+        CHECK(secp256k1_schnorrsig_sign(ctx, &sig[i], msg[i], sk, NULL, NULL));
+        sig_arr[i] = &sig[i];
+        msg_arr[i] = msg[i];
+        pk_arr[i] = &pk[i];
+    }
+
+    for (n_scratch = 1; n_scratch <= N_SCRATCH; n_scratch++) {
+        size_t sig_idx = secp256k1_rand_int(N_SIGS);
+        size_t byte_idx = secp256k1_rand_int(32);
+        unsigned char xorbyte = secp256k1_rand_int(254)+1;
+
+        CHECK(secp256k1_schnorrsig_verify_batch_parallel(ctx, scratch, n_scratch, sig_arr, msg_arr, pk_arr, N_SIGS, test_schnorrsig_parallel_for, NULL));
+        CHECK(secp256k1_schnorrsig_verify_batch_parallel(ctx, scratch, n_scratch, sig_arr, msg_arr, pk_arr, N_SIGS, NULL, NULL));
+        CHECK(secp256k1_schnorrsig_verify_batch_parallel(ctx, scratch, n_scratch, sig_arr, msg_arr, pk_arr, 3, test_schnorrsig_parallel_for, NULL));
+
+        sig[sig_idx].data[32 + byte_idx] ^= xorbyte;
+        CHECK(!secp256k1_schnorrsig_verify_batch(ctx, scratch[0], sig_arr, msg_arr, pk_arr, N_SIGS));
+        CHECK(!secp256k1_schnorrsig_verify_batch_parallel(ctx, scratch, n_scratch, sig_arr, msg_arr, pk_arr, N_SIGS, test_schnorrsig_parallel_for, NULL));
+        sig[sig_idx].data[32 + byte_idx] ^= xorbyte;
+
+        msg[sig_idx][byte_idx] ^= xorbyte;
+        CHECK(!secp256k1_schnorrsig_verify_batch_parallel(ctx, scratch, n_scratch, sig_arr, msg_arr, pk_arr, N_SIGS, test_schnorrsig_parallel_for, NULL));
+        msg[sig_idx][byte_idx] ^= xorbyte;
+    }
+
+    for (i = 0; i < N_SCRATCH; i++) {
+        secp256k1_scratch_space_destroy(ctx, scratch[i]);
+    }
+}
+#undef N_SCRATCH
+#undef N_SIGS
+
+#define N_SIGS  77
+/* Plants invalid signatures and checks that verify_batch_find_invalid reports exactly
+ * those, for several numbers of invalid signatures and a scratch space that is too
+ * small to hold the parsed signatures. */
+void test_schnorrsig_verify_batch_find_invalid(void) {
+    unsigned char sk[32];
+    unsigned char msg[N_SIGS][32];
+    secp256k1_schnorrsig sig[N_SIGS];
+    secp256k1_xonly_pubkey pk[N_SIGS];
+    const secp256k1_schnorrsig *sig_arr[N_SIGS];
+    const unsigned char *msg_arr[N_SIGS];
+    const secp256k1_xonly_pubkey *pk_arr[N_SIGS];
+    int invalid[N_SIGS];
+    int results[N_SIGS];
+    secp256k1_scratch_space *scratch = secp256k1_scratch_space_create(ctx, 256 * 1024);
+    secp256k1_scratch_space *small_scratch = secp256k1_scratch_space_create(ctx, 1024);
+    size_t n_invalid;
+    size_t i;
+
+    for (i = 0; i < N_SIGS; i++) {
+        secp256k1_rand256(sk);
+        secp256k1_rand256(msg[i]);
+        CHECK(secp256k1_xonly_pubkey_create(ctx, &pk[i], sk));
+        CHECK(secp256k1_schnorrsig_sign(ctx, &sig[i], msg[i], sk, NULL, NULL));
+        sig_arr[i] = &sig[i];
+        msg_arr[i] = msg[i];
+        pk_arr[i] = &pk[i];
+    }
+
+    for (n_invalid = 0; n_invalid <= 8; n_invalid++) {
+        size_t n_sigs = n_invalid == 8 ? N_SIGS : secp256k1_rand_int(N_SIGS) + 1;
+        int all_valid = 1;
+        memset(invalid, 0, sizeof(invalid));
+        if (n_invalid == 8) {
+            /* All signatures are invalid */
+            for (i = 0; i < n_sigs; i++) {
+                msg[i][0] ^= 1;
+                invalid[i] = 1;
+            }
+        }
+        for (i = 0; i < n_invalid && n_invalid < 8; i++) {
+            size_t idx = secp256k1_rand_int(n_sigs);
+            if (invalid[idx]) {
+                continue;
+            }
+            invalid[idx] = 1;
+            switch (secp256k1_rand_int(3)) {
+            case 0:
+                /* Signature fails verification */
+                msg[idx][secp256k1_rand_int(32)] ^= 1 + secp256k1_rand_int(255);
+                break;
+            case 1:
+                /* s overflows */
+                memset(&sig[idx].data[32], 0xFF, 32);
+                break;
+            default:
+                /* R.x is not a field element */
+                memset(&sig[idx].data[0], 0xFF, 32);
+                break;
+            }
+        }
+        for (i = 0; i < n_sigs; i++) {
+            all_valid &= !invalid[i];
+        }
+
+        CHECK(secp256k1_schnorrsig_verify_batch_find_invalid(ctx, scratch, results, sig_arr, msg_arr, pk_arr, n_sigs) == all_valid);
+        CHECK(secp256k1_schnorrsig_verify_batch(ctx, scratch, sig_arr, msg_arr, pk_arr, n_sigs) == all_valid);
+        for (i = 0; i < n_sigs; i++) {
+            CHECK(results[i] == !invalid[i]);
+            CHECK(secp256k1_schnorrsig_verify(ctx, &sig[i], msg[i], &pk[i]) == results[i]);
+        }
+        CHECK(secp256k1_schnorrsig_verify_batch_find_invalid(ctx, small_scratch, results, sig_arr, msg_arr, pk_arr, n_sigs) == all_valid);
+        for (i = 0; i < n_sigs; i++) {
+            CHECK(results[i] == !invalid[i]);
+        }
+
+        /* Replace the invalid signatures */
+        for (i = 0; i < n_sigs; i++) {
+            if (!invalid[i]) {
+                continue;
+            }
+            secp256k1_rand256(sk);
+            CHECK(secp256k1_xonly_pubkey_create(ctx, &pk[i], sk));
+            CHECK(secp256k1_schnorrsig_sign(ctx, &sig[i], msg[i], sk, NULL, NULL));
+        }
+    }
+
+    secp256k1_scratch_space_destroy(ctx, small_scratch);
+    secp256k1_scratch_space_destroy(ctx, scratch);
+}
+#undef N_SIGS
+
+#define N_SIGS  40
+/* Feeds signatures to a secp256k1_batch one at a time, checking it against
+ * verify_batch as it grows past its initial capacity. */
+void test_schnorrsig_batch(secp256k1_scratch_space *scratch) {
+    unsigned char sk[32];
+    unsigned char msg[N_SIGS][32];
+    secp256k1_schnorrsig sig[N_SIGS];
+    secp256k1_xonly_pubkey pk[N_SIGS];
+    const secp256k1_schnorrsig *sig_arr[N_SIGS];
+    const unsigned char *msg_arr[N_SIGS];
+    const secp256k1_xonly_pubkey *pk_arr[N_SIGS];
+    secp256k1_batch *batch;
+    secp256k1_schnorrsig bad_sig;
+    size_t sig_idx;
+    size_t i;
+
+    for (i = 0; i < N_SIGS; i++) {
+        secp256k1_rand256(sk);
+        secp256k1_rand256(msg[i]);
+        CHECK(secp256k1_xonly_pubkey_create(ctx, &pk[i], sk));
+        CHECK(secp256k1_schnorrsig_sign(ctx, &sig[i], msg[i], sk, NULL, NULL));
+        sig_arr[i] = &sig[i];
+        msg_arr[i] = msg[i];
+        pk_arr[i] = &pk[i];
+    }
+
+    batch = secp256k1_batch_create(ctx, 0);
+    CHECK(secp256k1_batch_verify(ctx, scratch, batch));
+    for (i = 0; i < N_SIGS; i++) {
+        CHECK(secp256k1_batch_add_schnorrsig(ctx, batch, &sig[i], msg[i], &pk[i]));
+        if (i % 7 == 0 || i == N_SIGS - 1) {
+            CHECK(secp256k1_batch_verify(ctx, scratch, batch));
+        }
+    }
+    secp256k1_batch_destroy(ctx, batch);
+
+    /* A signature that fails verification */
+    sig_idx = secp256k1_rand_int(N_SIGS);
+    msg[sig_idx][secp256k1_rand_int(32)] ^= 1 + secp256k1_rand_int(255);
+    CHECK(!secp256k1_schnorrsig_verify_batch(ctx, scratch, sig_arr, msg_arr, pk_arr, N_SIGS));
+    batch = secp256k1_batch_create(ctx, N_SIGS);
+    for (i = 0; i < N_SIGS; i++) {
+        CHECK(secp256k1_batch_add_schnorrsig(ctx, batch, &sig[i], msg[i], &pk[i]));
+        CHECK(secp256k1_batch_verify(ctx, scratch, batch) == (i < sig_idx));
+    }
+    secp256k1_batch_destroy(ctx, batch);
+
+    /* Signatures that can't be parsed are rejected by add and invalidate the batch */
+    batch = secp256k1_batch_create(ctx, 1);
+    bad_sig = sig[0];
+    memset(&bad_sig.data[32], 0xFF, 32);
+    CHECK(!secp256k1_batch_add_schnorrsig(ctx, batch, &bad_sig, msg[0], &pk[0]));
+    bad_sig = sig[0];
+    memset(&bad_sig.data[0], 0xFF, 32);
+    CHECK(!secp256k1_batch_add_schnorrsig(ctx, batch, &bad_sig, msg[0], &pk[0]));
+    CHECK(secp256k1_batch_add_schnorrsig(ctx, batch, &sig[1], msg[1], &pk[1]));
+    CHECK(!secp256k1_batch_verify(ctx, scratch, batch));
+    secp256k1_batch_destroy(ctx, batch);
+}
+#undef N_SIGS
+
 void test_schnorrsig_taproot(void) {
     unsigned char sk[32];
     secp256k1_xonly_pubkey internal_pk;
@@ -736,7 +1176,12 @@ void run_schnorrsig_tests(void) {
     test_schnorrsig_sha256_tagged();
     test_schnorrsig_bip_vectors(scratch);
     test_schnorrsig_sign();
+    test_schnorrsig_sign_keypair();
+    test_schnorrsig_sign_batch();
     test_schnorrsig_sign_verify(scratch);
+    test_schnorrsig_verify_batch_parallel();
+    test_schnorrsig_verify_batch_find_invalid();
+    test_schnorrsig_batch(scratch);
     test_schnorrsig_taproot();
 
     secp256k1_scratch_space_destroy(ctx, scratch);
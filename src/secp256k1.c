@@ -76,17 +76,31 @@ struct secp256k1_context_struct {
     secp256k1_ecmult_gen_context ecmult_gen_ctx;
     secp256k1_callback illegal_callback;
     secp256k1_callback error_callback;
+    int external_tables; /* whether the tables are outside the context's memory */
+    /* For contexts created by secp256k1_context_clone_shared, the context
+     * whose memory holds the tables, otherwise NULL. */
+    struct secp256k1_context_struct *table_owner;
+    int table_refs; /* number of contexts using the tables in this context's memory */
+    int heap; /* whether created by secp256k1_context_create or secp256k1_context_clone */
 };
 
 static const secp256k1_context secp256k1_context_no_precomp_ = {
     { 0 },
     { 0 },
     { secp256k1_default_illegal_callback_fn, 0 },
-    { secp256k1_default_error_callback_fn, 0 }
+    { secp256k1_default_error_callback_fn, 0 },
+    0,
+    NULL,
+    0,
+    0
 };
 const secp256k1_context *secp256k1_context_no_precomp = &secp256k1_context_no_precomp_;
 
 size_t secp256k1_context_preallocated_size(unsigned int flags) {
+    return secp256k1_context_preallocated_size_with_window(flags, WINDOW_G);
+}
+
+size_t secp256k1_context_preallocated_size_with_window(unsigned int flags, unsigned int window) {
     size_t ret = ROUND_TO_ALIGN(sizeof(secp256k1_context));
 
     if (EXPECT((flags & SECP256K1_FLAGS_TYPE_MASK) != SECP256K1_FLAGS_TYPE_CONTEXT, 0)) {
@@ -94,12 +108,17 @@ size_t secp256k1_context_preallocated_size(unsigned int flags) {
                                     "Invalid flags");
             return 0;
     }
+    if (EXPECT(window < 2 || window > 24, 0)) {
+            secp256k1_callback_call(&default_illegal_callback,
+                                    "Invalid window size");
+            return 0;
+    }
 
     if (flags & SECP256K1_FLAGS_BIT_CONTEXT_SIGN) {
         ret += SECP256K1_ECMULT_GEN_CONTEXT_PREALLOCATED_SIZE;
     }
     if (flags & SECP256K1_FLAGS_BIT_CONTEXT_VERIFY) {
-        ret += SECP256K1_ECMULT_CONTEXT_PREALLOCATED_SIZE;
+        ret += secp256k1_ecmult_context_prealloc_size(window);
     }
     return ret;
 }
@@ -107,31 +126,47 @@ size_t secp256k1_context_preallocated_size(unsigned int flags) {
 size_t secp256k1_context_preallocated_clone_size(const secp256k1_context* ctx) {
     size_t ret = ROUND_TO_ALIGN(sizeof(secp256k1_context));
     VERIFY_CHECK(ctx != NULL);
+    if (ctx->external_tables) {
+        return ret;
+    }
     if (secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx)) {
         ret += SECP256K1_ECMULT_GEN_CONTEXT_PREALLOCATED_SIZE;
     }
     if (secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx)) {
-        ret += SECP256K1_ECMULT_CONTEXT_PREALLOCATED_SIZE;
+        ret += secp256k1_ecmult_context_prealloc_size(ctx->ecmult_ctx.window_g);
     }
     return ret;
 }
 
 secp256k1_context* secp256k1_context_preallocated_create(void* prealloc, unsigned int flags) {
+    return secp256k1_context_preallocated_create_with_window(prealloc, flags, WINDOW_G);
+}
+
+secp256k1_context* secp256k1_context_preallocated_create_with_window(void* prealloc, unsigned int flags, unsigned int window) {
     void* const base = prealloc;
     size_t prealloc_size;
     secp256k1_context* ret;
 
     VERIFY_CHECK(prealloc != NULL);
-    prealloc_size = secp256k1_context_preallocated_size(flags);
+    prealloc_size = secp256k1_context_preallocated_size_with_window(flags, window);
     ret = (secp256k1_context*)manual_alloc(&prealloc, sizeof(secp256k1_context), base, prealloc_size);
     ret->illegal_callback = default_illegal_callback;
     ret->error_callback = default_error_callback;
+    ret->external_tables = 0;
+    ret->table_owner = NULL;
+    ret->table_refs = 1;
+    ret->heap = 0;
 
     if (EXPECT((flags & SECP256K1_FLAGS_TYPE_MASK) != SECP256K1_FLAGS_TYPE_CONTEXT, 0)) {
             secp256k1_callback_call(&ret->illegal_callback,
                                     "Invalid flags");
             return NULL;
     }
+    if (EXPECT(window < 2 || window > 24, 0)) {
+            secp256k1_callback_call(&ret->illegal_callback,
+                                    "Invalid window size");
+            return NULL;
+    }
 
     secp256k1_ecmult_context_init(&ret->ecmult_ctx);
     secp256k1_ecmult_gen_context_init(&ret->ecmult_gen_ctx);
@@ -140,7 +175,7 @@ secp256k1_context* secp256k1_context_preallocated_create(void* prealloc, unsigne
         secp256k1_ecmult_gen_context_build(&ret->ecmult_gen_ctx, &prealloc);
     }
     if (flags & SECP256K1_FLAGS_BIT_CONTEXT_VERIFY) {
-        secp256k1_ecmult_context_build(&ret->ecmult_ctx, &prealloc);
+        secp256k1_ecmult_context_build(&ret->ecmult_ctx, window, &prealloc);
     }
 
     return (secp256k1_context*) ret;
@@ -153,6 +188,7 @@ secp256k1_context* secp256k1_context_create(unsigned int flags) {
         free(ctx);
         return NULL;
     }
+    ctx->heap = 1;
 
     return ctx;
 }
@@ -162,12 +198,17 @@ secp256k1_context* secp256k1_context_preallocated_clone(const secp256k1_context*
     secp256k1_context* ret;
     VERIFY_CHECK(ctx != NULL);
     ARG_CHECK(prealloc != NULL);
+    ARG_CHECK(ctx->table_owner == NULL);
 
     prealloc_size = secp256k1_context_preallocated_clone_size(ctx);
     ret = (secp256k1_context*)prealloc;
     memcpy(ret, ctx, prealloc_size);
-    secp256k1_ecmult_gen_context_finalize_memcpy(&ret->ecmult_gen_ctx, &ctx->ecmult_gen_ctx);
-    secp256k1_ecmult_context_finalize_memcpy(&ret->ecmult_ctx, &ctx->ecmult_ctx);
+    if (!ctx->external_tables) {
+        secp256k1_ecmult_gen_context_finalize_memcpy(&ret->ecmult_gen_ctx, &ctx->ecmult_gen_ctx);
+        secp256k1_ecmult_context_finalize_memcpy(&ret->ecmult_ctx, &ctx->ecmult_ctx);
+    }
+    ret->table_refs = 1;
+    ret->heap = 0;
     return ret;
 }
 
@@ -176,12 +217,46 @@ secp256k1_context* secp256k1_context_clone(const secp256k1_context* ctx) {
     size_t prealloc_size;
 
     VERIFY_CHECK(ctx != NULL);
+    if (ctx->table_owner != NULL) {
+        return secp256k1_context_clone_shared(ctx);
+    }
     prealloc_size = secp256k1_context_preallocated_clone_size(ctx);
     ret = (secp256k1_context*)checked_malloc(&ctx->error_callback, prealloc_size);
     ret = secp256k1_context_preallocated_clone(ctx, ret);
+    ret->heap = 1;
     return ret;
 }
 
+/* Adds n to the reference count of the tables in owner's memory and returns the new count. */
+static int secp256k1_context_table_refs_add(secp256k1_context* owner, int n) {
+#ifdef HAVE_BUILTIN_ATOMIC
+    return __atomic_add_fetch(&owner->table_refs, n, __ATOMIC_ACQ_REL);
+#else
+    /* secp256k1_context_clone_shared does not share tables without atomics */
+    return owner->table_refs += n;
+#endif
+}
+
+secp256k1_context* secp256k1_context_clone_shared(const secp256k1_context* ctx) {
+    secp256k1_context* ret;
+    secp256k1_context* owner;
+
+    VERIFY_CHECK(ctx != NULL);
+    owner = ctx->table_owner != NULL ? ctx->table_owner : (secp256k1_context*)ctx;
+#ifdef HAVE_BUILTIN_ATOMIC
+    if (owner->heap) {
+        ret = (secp256k1_context*)checked_malloc(&ctx->error_callback, ROUND_TO_ALIGN(sizeof(secp256k1_context)));
+        memcpy(ret, ctx, sizeof(secp256k1_context));
+        ret->external_tables = 1;
+        ret->table_owner = owner;
+        ret->heap = 1;
+        secp256k1_context_table_refs_add(owner, 1);
+        return ret;
+    }
+#endif
+    return secp256k1_context_clone(ctx);
+}
+
 void secp256k1_context_preallocated_destroy(secp256k1_context* ctx) {
     ARG_CHECK_NO_RETURN(ctx != secp256k1_context_no_precomp);
     if (ctx != NULL) {
@@ -192,11 +267,248 @@ void secp256k1_context_preallocated_destroy(secp256k1_context* ctx) {
 
 void secp256k1_context_destroy(secp256k1_context* ctx) {
     if (ctx != NULL) {
+        secp256k1_context* owner = ctx->table_owner;
         secp256k1_context_preallocated_destroy(ctx);
-        free(ctx);
+        if (owner != NULL) {
+            free(ctx);
+        } else {
+            /* The memory of a context stays allocated while others share its tables */
+            owner = ctx;
+        }
+        if (secp256k1_context_table_refs_add(owner, -1) == 0) {
+            free(owner);
+        }
     }
 }
 
+/* Serialized precomputed tables start with a header of
+ *   8 bytes magic "SECPPREC"
+ *   4 bytes format version (little endian)
+ *   4 bytes SECP256K1_PRECOMPUTED_* flags of the tables that follow
+ *   4 bytes ecmult window size
+ *   4 bytes sizeof(secp256k1_ge_storage)
+ *   4 bytes ecmult_gen comb blocks
+ *   4 bytes ecmult_gen comb teeth
+ *  32 bytes SHA256 of the preceding 32 bytes followed by the tables
+ * which are then stored in the order ecmult_gen prec, pre_g, pre_g_128. The
+ * header size keeps the tables aligned. */
+static const unsigned char secp256k1_precomputed_magic[8] = { 'S', 'E', 'C', 'P', 'P', 'R', 'E', 'C' };
+#define SECP256K1_PRECOMPUTED_VERSION 2
+#define SECP256K1_PRECOMPUTED_HEADER_SIZE 64
+#define SECP256K1_PRECOMPUTED_SIGN 1
+#define SECP256K1_PRECOMPUTED_VERIFY 2
+#define SECP256K1_PRECOMPUTED_ENDOMORPHISM 4
+
+static const size_t SECP256K1_PRECOMPUTED_GEN_SIZE = sizeof(secp256k1_ge_storage) * COMB_BLOCKS * COMB_POINTS;
+#define SECP256K1_PRECOMPUTED_PRE_G_SIZE(window) (sizeof(secp256k1_ge_storage) * ECMULT_TABLE_SIZE(window))
+
+static void secp256k1_precomputed_write_le32(unsigned char *p, uint32_t x) {
+    p[0] = x;
+    p[1] = x >> 8;
+    p[2] = x >> 16;
+    p[3] = x >> 24;
+}
+
+static uint32_t secp256k1_precomputed_read_le32(const unsigned char *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static unsigned int secp256k1_precomputed_flags(unsigned int flags) {
+    unsigned int ret = 0;
+    if (flags & SECP256K1_FLAGS_BIT_CONTEXT_SIGN) {
+        ret |= SECP256K1_PRECOMPUTED_SIGN;
+    }
+    if (flags & SECP256K1_FLAGS_BIT_CONTEXT_VERIFY) {
+        ret |= SECP256K1_PRECOMPUTED_VERIFY;
+#ifdef USE_ENDOMORPHISM
+        ret |= SECP256K1_PRECOMPUTED_ENDOMORPHISM;
+#endif
+    }
+    return ret;
+}
+
+static size_t secp256k1_precomputed_tables_size(unsigned int pflags, int window) {
+    size_t ret = 0;
+    if (pflags & SECP256K1_PRECOMPUTED_SIGN) {
+        ret += SECP256K1_PRECOMPUTED_GEN_SIZE;
+    }
+    if (pflags & SECP256K1_PRECOMPUTED_VERIFY) {
+        ret += SECP256K1_PRECOMPUTED_PRE_G_SIZE(window);
+    }
+    if (pflags & SECP256K1_PRECOMPUTED_ENDOMORPHISM) {
+        ret += SECP256K1_PRECOMPUTED_PRE_G_SIZE(window);
+    }
+    return ret;
+}
+
+static void secp256k1_precomputed_checksum(unsigned char *out32, const unsigned char *input, size_t tables_size) {
+    secp256k1_sha256 sha;
+    secp256k1_sha256_initialize(&sha);
+    secp256k1_sha256_write(&sha, input, 32);
+    secp256k1_sha256_write(&sha, input + SECP256K1_PRECOMPUTED_HEADER_SIZE, tables_size);
+    secp256k1_sha256_finalize(&sha, out32);
+}
+
+/* Checks everything but the checksum and returns the flags of the tables in
+ * input and their window size in *window, or -1 if it is not usable by this
+ * build. */
+static int secp256k1_precomputed_parse_header(int *window, const unsigned char *input, size_t inputlen) {
+    unsigned int pflags;
+    if (inputlen < SECP256K1_PRECOMPUTED_HEADER_SIZE
+        || memcmp(input, secp256k1_precomputed_magic, 8) != 0
+        || secp256k1_precomputed_read_le32(input + 8) != SECP256K1_PRECOMPUTED_VERSION
+        || secp256k1_precomputed_read_le32(input + 16) < 2
+        || secp256k1_precomputed_read_le32(input + 16) > 24
+        || secp256k1_precomputed_read_le32(input + 20) != sizeof(secp256k1_ge_storage)) {
+        return -1;
+    }
+    *window = secp256k1_precomputed_read_le32(input + 16);
+    pflags = secp256k1_precomputed_read_le32(input + 12);
+    if (pflags & ~(unsigned int)(SECP256K1_PRECOMPUTED_SIGN | SECP256K1_PRECOMPUTED_VERIFY | SECP256K1_PRECOMPUTED_ENDOMORPHISM)) {
+        return -1;
+    }
+    if ((pflags & SECP256K1_PRECOMPUTED_SIGN)
+        && (secp256k1_precomputed_read_le32(input + 24) != COMB_BLOCKS
+            || secp256k1_precomputed_read_le32(input + 28) != COMB_TEETH)) {
+        return -1;
+    }
+    if (pflags & SECP256K1_PRECOMPUTED_VERIFY) {
+        /* Verification tables must match the endomorphism setting of this build */
+        if ((pflags & SECP256K1_PRECOMPUTED_ENDOMORPHISM) != (secp256k1_precomputed_flags(SECP256K1_CONTEXT_VERIFY) & SECP256K1_PRECOMPUTED_ENDOMORPHISM)) {
+            return -1;
+        }
+    } else if (pflags & SECP256K1_PRECOMPUTED_ENDOMORPHISM) {
+        return -1;
+    }
+    if (inputlen - SECP256K1_PRECOMPUTED_HEADER_SIZE != secp256k1_precomputed_tables_size(pflags, *window)) {
+        return -1;
+    }
+    return pflags;
+}
+
+size_t secp256k1_context_precomputed_size(unsigned int flags) {
+    return secp256k1_context_precomputed_size_with_window(flags, WINDOW_G);
+}
+
+size_t secp256k1_context_precomputed_size_with_window(unsigned int flags, unsigned int window) {
+    if (EXPECT((flags & SECP256K1_FLAGS_TYPE_MASK) != SECP256K1_FLAGS_TYPE_CONTEXT, 0)) {
+            secp256k1_callback_call(&default_illegal_callback,
+                                    "Invalid flags");
+            return 0;
+    }
+    if (EXPECT(window < 2 || window > 24, 0)) {
+            secp256k1_callback_call(&default_illegal_callback,
+                                    "Invalid window size");
+            return 0;
+    }
+    return SECP256K1_PRECOMPUTED_HEADER_SIZE + secp256k1_precomputed_tables_size(secp256k1_precomputed_flags(flags), window);
+}
+
+int secp256k1_context_precomputed_serialize(const secp256k1_context* ctx, unsigned char *output, size_t outputlen, unsigned int flags) {
+    unsigned int pflags;
+    int window;
+    unsigned char *p;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(output != NULL);
+    ARG_CHECK((flags & SECP256K1_FLAGS_TYPE_MASK) == SECP256K1_FLAGS_TYPE_CONTEXT);
+
+    pflags = secp256k1_precomputed_flags(flags);
+    window = (pflags & SECP256K1_PRECOMPUTED_VERIFY) ? ctx->ecmult_ctx.window_g : WINDOW_G;
+    if (outputlen < SECP256K1_PRECOMPUTED_HEADER_SIZE + secp256k1_precomputed_tables_size(pflags, window)) {
+        return 0;
+    }
+    if (((pflags & SECP256K1_PRECOMPUTED_SIGN) && !secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx))
+        || ((pflags & SECP256K1_PRECOMPUTED_VERIFY) && !secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx))) {
+        return 0;
+    }
+
+    memset(output, 0, SECP256K1_PRECOMPUTED_HEADER_SIZE);
+    memcpy(output, secp256k1_precomputed_magic, 8);
+    secp256k1_precomputed_write_le32(output + 8, SECP256K1_PRECOMPUTED_VERSION);
+    secp256k1_precomputed_write_le32(output + 12, pflags);
+    secp256k1_precomputed_write_le32(output + 16, window);
+    secp256k1_precomputed_write_le32(output + 20, sizeof(secp256k1_ge_storage));
+    secp256k1_precomputed_write_le32(output + 24, COMB_BLOCKS);
+    secp256k1_precomputed_write_le32(output + 28, COMB_TEETH);
+    p = output + SECP256K1_PRECOMPUTED_HEADER_SIZE;
+    if (pflags & SECP256K1_PRECOMPUTED_SIGN) {
+        memcpy(p, *ctx->ecmult_gen_ctx.prec, SECP256K1_PRECOMPUTED_GEN_SIZE);
+        p += SECP256K1_PRECOMPUTED_GEN_SIZE;
+    }
+    if (pflags & SECP256K1_PRECOMPUTED_VERIFY) {
+        memcpy(p, *ctx->ecmult_ctx.pre_g, SECP256K1_PRECOMPUTED_PRE_G_SIZE(window));
+        p += SECP256K1_PRECOMPUTED_PRE_G_SIZE(window);
+#ifdef USE_ENDOMORPHISM
+        memcpy(p, *ctx->ecmult_ctx.pre_g_128, SECP256K1_PRECOMPUTED_PRE_G_SIZE(window));
+#endif
+    }
+    secp256k1_precomputed_checksum(output + 32, output, secp256k1_precomputed_tables_size(pflags, window));
+    return 1;
+}
+
+int secp256k1_context_precomputed_verify(const secp256k1_context* ctx, const unsigned char *input, size_t inputlen) {
+    int pflags;
+    int window;
+    unsigned char checksum[32];
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(input != NULL);
+
+    pflags = secp256k1_precomputed_parse_header(&window, input, inputlen);
+    if (pflags < 0) {
+        return 0;
+    }
+    secp256k1_precomputed_checksum(checksum, input, secp256k1_precomputed_tables_size(pflags, window));
+    return memcmp(checksum, input + 32, 32) == 0;
+}
+
+secp256k1_context* secp256k1_context_preallocated_create_precomputed(void* prealloc, unsigned int flags, const unsigned char *input, size_t inputlen) {
+    secp256k1_context* ctx;
+    int pflags;
+    int window;
+    unsigned int needed;
+    const unsigned char *p;
+
+    VERIFY_CHECK(prealloc != NULL);
+    ctx = secp256k1_context_preallocated_create(prealloc, SECP256K1_CONTEXT_NONE);
+    ctx->external_tables = 1;
+    ARG_CHECK(input != NULL);
+    ARG_CHECK((flags & SECP256K1_FLAGS_TYPE_MASK) == SECP256K1_FLAGS_TYPE_CONTEXT);
+    ARG_CHECK(((uintptr_t)input) % ALIGNMENT == 0);
+
+    pflags = secp256k1_precomputed_parse_header(&window, input, inputlen);
+    needed = secp256k1_precomputed_flags(flags) & (SECP256K1_PRECOMPUTED_SIGN | SECP256K1_PRECOMPUTED_VERIFY);
+    if (pflags < 0 || (pflags & needed) != needed) {
+        return NULL;
+    }
+
+    p = input + SECP256K1_PRECOMPUTED_HEADER_SIZE;
+    if (pflags & SECP256K1_PRECOMPUTED_SIGN) {
+        if (needed & SECP256K1_PRECOMPUTED_SIGN) {
+            ctx->ecmult_gen_ctx.prec = (secp256k1_ge_storage (*)[COMB_BLOCKS][COMB_POINTS])(void*)p;
+            if (!secp256k1_ecmult_gen_table_check(&(*ctx->ecmult_gen_ctx.prec)[0][0], &secp256k1_ge_const_g, COMB_TEETH, COMB_SPACING)) {
+                return NULL;
+            }
+            secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, NULL);
+        }
+        p += SECP256K1_PRECOMPUTED_GEN_SIZE;
+    }
+    if (needed & SECP256K1_PRECOMPUTED_VERIFY) {
+        secp256k1_ge check;
+        ctx->ecmult_ctx.window_g = window;
+        ctx->ecmult_ctx.pre_g = (secp256k1_ge_storage (*)[])(void*)p;
+#ifdef USE_ENDOMORPHISM
+        ctx->ecmult_ctx.pre_g_128 = (secp256k1_ge_storage (*)[])(void*)(p + SECP256K1_PRECOMPUTED_PRE_G_SIZE(window));
+#endif
+        /* The first entry is the generator itself. Comparing it catches tables
+         * written with a different representation of field elements. */
+        secp256k1_ge_from_storage(&check, &(*ctx->ecmult_ctx.pre_g)[0]);
+        if (!secp256k1_fe_equal_var(&check.x, &secp256k1_ge_const_g.x) || !secp256k1_fe_equal_var(&check.y, &secp256k1_ge_const_g.y)) {
+            return NULL;
+        }
+    }
+    return ctx;
+}
+
 void secp256k1_context_set_illegal_callback(secp256k1_context* ctx, void (*fun)(const char* message, void* data), const void* data) {
     ARG_CHECK_NO_RETURN(ctx != secp256k1_context_no_precomp);
     if (fun == NULL) {
@@ -418,6 +730,57 @@ int secp256k1_ecdsa_verify(const secp256k1_context* ctx, const secp256k1_ecdsa_s
             secp256k1_ecdsa_sig_verify(&ctx->ecmult_ctx, &r, &s, &q, &m));
 }
 
+/* Number of signatures whose s values are inverted together by
+ * secp256k1_ecdsa_verify_batch. Larger values only marginally reduce the
+ * amortized cost of the single inversion per chunk. */
+#define ECDSA_VERIFY_BATCH_CHUNK 64
+
+int secp256k1_ecdsa_verify_batch(const secp256k1_context* ctx, int *results, const secp256k1_ecdsa_signature *const *sig, const unsigned char *const *msg32, const secp256k1_pubkey *const *pubkey, size_t n_sigs) {
+    secp256k1_scalar r[ECDSA_VERIFY_BATCH_CHUNK];
+    secp256k1_scalar s[ECDSA_VERIFY_BATCH_CHUNK];
+    secp256k1_scalar sinv[ECDSA_VERIFY_BATCH_CHUNK];
+    int valid[ECDSA_VERIFY_BATCH_CHUNK];
+    size_t i, j;
+    int ret = 1;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    if (n_sigs > 0) {
+        ARG_CHECK(sig != NULL);
+        ARG_CHECK(msg32 != NULL);
+        ARG_CHECK(pubkey != NULL);
+    }
+
+    for (i = 0; i < n_sigs; i += ECDSA_VERIFY_BATCH_CHUNK) {
+        size_t n = n_sigs - i < ECDSA_VERIFY_BATCH_CHUNK ? n_sigs - i : ECDSA_VERIFY_BATCH_CHUNK;
+
+        /* Signatures with a zero or high s are invalid. Their s is replaced by
+         * one so that they do not spoil the batch inversion of the others. */
+        for (j = 0; j < n; j++) {
+            secp256k1_ecdsa_signature_load(ctx, &r[j], &s[j], sig[i + j]);
+            valid[j] = !secp256k1_scalar_is_zero(&r[j]) && !secp256k1_scalar_is_zero(&s[j]) && !secp256k1_scalar_is_high(&s[j]);
+            if (!valid[j]) {
+                secp256k1_scalar_set_int(&s[j], 1);
+            }
+        }
+        secp256k1_scalar_inverse_all_var(sinv, s, n);
+
+        for (j = 0; j < n; j++) {
+            secp256k1_ge q;
+            secp256k1_scalar m;
+            if (valid[j]) {
+                secp256k1_scalar_set_b32(&m, msg32[i + j], NULL);
+                valid[j] = secp256k1_pubkey_load(ctx, &q, pubkey[i + j]) &&
+                           secp256k1_ecdsa_sig_verify_sinv(&ctx->ecmult_ctx, &r[j], &sinv[j], &q, &m);
+            }
+            if (results != NULL) {
+                results[i + j] = valid[j];
+            }
+            ret &= valid[j];
+        }
+    }
+    return ret;
+}
+
 static SECP256K1_INLINE void buffer_append(unsigned char *buf, unsigned int *offset, const void *data, unsigned int len) {
     memcpy(buf + *offset, data, len);
     *offset += len;
@@ -471,8 +834,11 @@ static int nonce_function_bipschnorr(unsigned char *nonce32, const unsigned char
     return 1;
 }
 
-static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, void *data, unsigned int counter) {
-   unsigned char keydata[112];
+/* Computes the same nonce as nonce_function_rfc6979, with the part of the RFC6979
+ * initialization that only depends on key32 taken from hmac, which must have been
+ * computed by secp256k1_rfc6979_hmac_sha256_precompute(hmac, key32, 32). */
+static int nonce_function_rfc6979_precomputed(unsigned char *nonce32, const secp256k1_hmac_sha256 *hmac, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, void *data, unsigned int counter) {
+   unsigned char keydata[80];
    unsigned int offset = 0;
    secp256k1_rfc6979_hmac_sha256 rng;
    unsigned int i;
@@ -482,9 +848,8 @@ static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *m
     * - optionally 16 extra bytes with the algorithm name.
     * Because the arguments have distinct fixed lengths it is not possible for
     *  different argument mixtures to emulate each other and result in the same
-    *  nonces.
+    *  nonces. The private key is the part that hmac was precomputed from.
     */
-   buffer_append(keydata, &offset, key32, 32);
    buffer_append(keydata, &offset, msg32, 32);
    if (data != NULL) {
        buffer_append(keydata, &offset, data, 32);
@@ -492,7 +857,7 @@ static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *m
    if (algo16 != NULL) {
        buffer_append(keydata, &offset, algo16, 16);
    }
-   secp256k1_rfc6979_hmac_sha256_initialize(&rng, keydata, offset);
+   secp256k1_rfc6979_hmac_sha256_initialize_precomputed(&rng, hmac, key32, 32, keydata, offset);
    memset(keydata, 0, sizeof(keydata));
    for (i = 0; i <= counter; i++) {
        secp256k1_rfc6979_hmac_sha256_generate(&rng, nonce32, 32);
@@ -501,13 +866,48 @@ static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *m
    return 1;
 }
 
+static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, void *data, unsigned int counter) {
+   secp256k1_hmac_sha256 hmac;
+   secp256k1_rfc6979_hmac_sha256_precompute(&hmac, key32, 32);
+   nonce_function_rfc6979_precomputed(nonce32, &hmac, msg32, key32, algo16, data, counter);
+   memset(&hmac, 0, sizeof(hmac));
+   return 1;
+}
+
 const secp256k1_nonce_function secp256k1_nonce_function_bipschnorr = nonce_function_bipschnorr;
 const secp256k1_nonce_function secp256k1_nonce_function_rfc6979 = nonce_function_rfc6979;
 const secp256k1_nonce_function secp256k1_nonce_function_default = nonce_function_rfc6979;
 
+/* Runs the signing loop of secp256k1_ecdsa_sign for a valid secret key, starting at
+ * nonce attempt count. */
+static int secp256k1_ecdsa_sign_loop(const secp256k1_context* ctx, secp256k1_scalar *r, secp256k1_scalar *s, const unsigned char *msg32, const unsigned char *seckey, const secp256k1_scalar *sec, secp256k1_nonce_function noncefp, const void* noncedata, unsigned int count) {
+    secp256k1_scalar non, msg;
+    unsigned char nonce32[32];
+    int ret;
+    int overflow = 0;
+    secp256k1_scalar_set_b32(&msg, msg32, NULL);
+    while (1) {
+        ret = noncefp(nonce32, msg32, seckey, NULL, (void*)noncedata, count);
+        if (!ret) {
+            break;
+        }
+        secp256k1_scalar_set_b32(&non, nonce32, &overflow);
+        if (!overflow && !secp256k1_scalar_is_zero(&non)) {
+            if (secp256k1_ecdsa_sig_sign(&ctx->ecmult_gen_ctx, r, s, sec, &msg, &non, NULL)) {
+                break;
+            }
+        }
+        count++;
+    }
+    memset(nonce32, 0, 32);
+    secp256k1_scalar_clear(&msg);
+    secp256k1_scalar_clear(&non);
+    return ret;
+}
+
 int secp256k1_ecdsa_sign(const secp256k1_context* ctx, secp256k1_ecdsa_signature *signature, const unsigned char *msg32, const unsigned char *seckey, secp256k1_nonce_function noncefp, const void* noncedata) {
     secp256k1_scalar r, s;
-    secp256k1_scalar sec, non, msg;
+    secp256k1_scalar sec;
     int ret = 0;
     int overflow = 0;
     VERIFY_CHECK(ctx != NULL);
@@ -522,27 +922,9 @@ int secp256k1_ecdsa_sign(const secp256k1_context* ctx, secp256k1_ecdsa_signature
     secp256k1_scalar_set_b32(&sec, seckey, &overflow);
     /* Fail if the secret key is invalid. */
     if (!overflow && !secp256k1_scalar_is_zero(&sec)) {
-        unsigned char nonce32[32];
-        unsigned int count = 0;
-        secp256k1_scalar_set_b32(&msg, msg32, NULL);
-        while (1) {
-            ret = noncefp(nonce32, msg32, seckey, NULL, (void*)noncedata, count);
-            if (!ret) {
-                break;
-            }
-            secp256k1_scalar_set_b32(&non, nonce32, &overflow);
-            if (!overflow && !secp256k1_scalar_is_zero(&non)) {
-                if (secp256k1_ecdsa_sig_sign(&ctx->ecmult_gen_ctx, &r, &s, &sec, &msg, &non, NULL)) {
-                    break;
-                }
-            }
-            count++;
-        }
-        memset(nonce32, 0, 32);
-        secp256k1_scalar_clear(&msg);
-        secp256k1_scalar_clear(&non);
-        secp256k1_scalar_clear(&sec);
+        ret = secp256k1_ecdsa_sign_loop(ctx, &r, &s, msg32, seckey, &sec, noncefp, noncedata, 0);
     }
+    secp256k1_scalar_clear(&sec);
     if (ret) {
         secp256k1_ecdsa_signature_save(signature, &r, &s);
     } else {
@@ -551,6 +933,107 @@ int secp256k1_ecdsa_sign(const secp256k1_context* ctx, secp256k1_ecdsa_signature
     return ret;
 }
 
+/* Number of signatures whose nonce points and nonce inverses secp256k1_ecdsa_sign_batch
+ * computes with a single field inversion and a single scalar inversion. */
+#define ECDSA_SIGN_BATCH_CHUNK 64
+
+int secp256k1_ecdsa_sign_batch(const secp256k1_context* ctx, secp256k1_ecdsa_signature *signature, const unsigned char *const *msg32, size_t n_sigs, const unsigned char *seckey, secp256k1_nonce_function noncefp, const void* noncedata) {
+    secp256k1_scalar non[ECDSA_SIGN_BATCH_CHUNK];
+    secp256k1_scalar noni[ECDSA_SIGN_BATCH_CHUNK];
+    secp256k1_gej rj[ECDSA_SIGN_BATCH_CHUNK];
+    secp256k1_ge rp[ECDSA_SIGN_BATCH_CHUNK];
+    unsigned int count[ECDSA_SIGN_BATCH_CHUNK];
+    int valid[ECDSA_SIGN_BATCH_CHUNK];
+    secp256k1_hmac_sha256 hmac;
+    secp256k1_scalar sec, msg, r, s;
+    unsigned char nonce32[32];
+    int rfc6979;
+    int overflow = 0;
+    int ret = 1;
+    size_t i, j;
+    VERIFY_CHECK(ctx != NULL);
+    if (n_sigs == 0) {
+        return 1;
+    }
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(signature != NULL);
+    ARG_CHECK(msg32 != NULL);
+    ARG_CHECK(seckey != NULL);
+    if (noncefp == NULL) {
+        noncefp = secp256k1_nonce_function_default;
+    }
+
+    secp256k1_scalar_set_b32(&sec, seckey, &overflow);
+    /* Fail if the secret key is invalid. */
+    if (overflow || secp256k1_scalar_is_zero(&sec)) {
+        memset(signature, 0, n_sigs * sizeof(*signature));
+        secp256k1_scalar_clear(&sec);
+        return 0;
+    }
+    /* With RFC6979 nonces, the HMAC state after absorbing the secret key is shared
+     * by all messages. */
+    rfc6979 = noncefp == nonce_function_rfc6979;
+    if (rfc6979) {
+        secp256k1_rfc6979_hmac_sha256_precompute(&hmac, seckey, 32);
+    }
+
+    for (i = 0; i < n_sigs; i += ECDSA_SIGN_BATCH_CHUNK) {
+        size_t m = n_sigs - i < ECDSA_SIGN_BATCH_CHUNK ? n_sigs - i : ECDSA_SIGN_BATCH_CHUNK;
+
+        /* Failed signatures get a nonce of one, so that no nonce point is
+         * infinity in the batch inversion. */
+        for (j = 0; j < m; j++) {
+            count[j] = 0;
+            while (1) {
+                if (rfc6979) {
+                    valid[j] = nonce_function_rfc6979_precomputed(nonce32, &hmac, msg32[i + j], seckey, NULL, (void*)noncedata, count[j]);
+                } else {
+                    valid[j] = noncefp(nonce32, msg32[i + j], seckey, NULL, (void*)noncedata, count[j]);
+                }
+                if (!valid[j]) {
+                    secp256k1_scalar_set_int(&non[j], 1);
+                    break;
+                }
+                secp256k1_scalar_set_b32(&non[j], nonce32, &overflow);
+                if (!overflow && !secp256k1_scalar_is_zero(&non[j])) {
+                    break;
+                }
+                count[j]++;
+            }
+        }
+        secp256k1_ecmult_gen_multi(&ctx->ecmult_gen_ctx, rj, non, m);
+        secp256k1_ge_set_all_gej(rp, rj, m);
+        secp256k1_scalar_inverse_all(noni, non, m);
+
+        for (j = 0; j < m; j++) {
+            if (valid[j]) {
+                secp256k1_scalar_set_b32(&msg, msg32[i + j], NULL);
+                if (!secp256k1_ecdsa_sig_sign_finish(&r, &s, &rp[j], &sec, &msg, &noni[j], NULL)) {
+                    /* s is zero: continue with the next nonce, like secp256k1_ecdsa_sign. */
+                    valid[j] = secp256k1_ecdsa_sign_loop(ctx, &r, &s, msg32[i + j], seckey, &sec, noncefp, noncedata, count[j] + 1);
+                }
+            }
+            if (valid[j]) {
+                secp256k1_ecdsa_signature_save(&signature[i + j], &r, &s);
+            } else {
+                memset(&signature[i + j], 0, sizeof(signature[i + j]));
+            }
+            ret &= valid[j];
+        }
+        for (j = 0; j < m; j++) {
+            secp256k1_scalar_clear(&non[j]);
+            secp256k1_scalar_clear(&noni[j]);
+            secp256k1_ge_clear(&rp[j]);
+            secp256k1_gej_clear(&rj[j]);
+        }
+    }
+    memset(nonce32, 0, 32);
+    memset(&hmac, 0, sizeof(hmac));
+    secp256k1_scalar_clear(&msg);
+    secp256k1_scalar_clear(&sec);
+    return ret;
+}
+
 int secp256k1_ec_seckey_verify(const secp256k1_context* ctx, const unsigned char *seckey) {
     secp256k1_scalar sec;
     int ret;
@@ -587,6 +1070,65 @@ int secp256k1_ec_pubkey_create(const secp256k1_context* ctx, secp256k1_pubkey *p
     return ret;
 }
 
+/* Number of public keys secp256k1_ec_pubkey_create_batch converts to affine
+ * coordinates with a single field inversion. */
+#define EC_PUBKEY_CREATE_BATCH_CHUNK 64
+
+int secp256k1_ec_pubkey_create_batch(const secp256k1_context* ctx, int *results, secp256k1_pubkey *pubkey, unsigned char *output33, const unsigned char *seckey, size_t n) {
+    secp256k1_scalar sec[EC_PUBKEY_CREATE_BATCH_CHUNK];
+    secp256k1_gej pj[EC_PUBKEY_CREATE_BATCH_CHUNK];
+    secp256k1_ge p[EC_PUBKEY_CREATE_BATCH_CHUNK];
+    int valid[EC_PUBKEY_CREATE_BATCH_CHUNK];
+    size_t i, j;
+    int ret = 1;
+    VERIFY_CHECK(ctx != NULL);
+    if (n == 0) {
+        return 1;
+    }
+    ARG_CHECK(pubkey != NULL);
+    memset(pubkey, 0, n * sizeof(*pubkey));
+    if (output33 != NULL) {
+        memset(output33, 0, n * 33);
+    }
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(seckey != NULL);
+
+    for (i = 0; i < n; i += EC_PUBKEY_CREATE_BATCH_CHUNK) {
+        size_t m = n - i < EC_PUBKEY_CREATE_BATCH_CHUNK ? n - i : EC_PUBKEY_CREATE_BATCH_CHUNK;
+
+        /* Invalid secret keys are replaced by one, so that no point is infinity
+         * in the batch inversion. */
+        for (j = 0; j < m; j++) {
+            int overflow;
+            secp256k1_scalar_set_b32(&sec[j], &seckey[32 * (i + j)], &overflow);
+            valid[j] = !overflow && !secp256k1_scalar_is_zero(&sec[j]);
+            if (!valid[j]) {
+                secp256k1_scalar_set_int(&sec[j], 1);
+            }
+        }
+        secp256k1_ecmult_gen_multi(&ctx->ecmult_gen_ctx, pj, sec, m);
+        secp256k1_ge_set_all_gej(p, pj, m);
+
+        for (j = 0; j < m; j++) {
+            if (valid[j]) {
+                secp256k1_pubkey_save(&pubkey[i + j], &p[j]);
+                if (output33 != NULL) {
+                    size_t len = 33;
+                    secp256k1_eckey_pubkey_serialize(&p[j], &output33[33 * (i + j)], &len, 1);
+                }
+            }
+            if (results != NULL) {
+                results[i + j] = valid[j];
+            }
+            ret &= valid[j];
+        }
+    }
+    for (j = 0; j < EC_PUBKEY_CREATE_BATCH_CHUNK; j++) {
+        secp256k1_scalar_clear(&sec[j]);
+    }
+    return ret;
+}
+
 int secp256k1_ec_privkey_negate(const secp256k1_context* ctx, unsigned char *seckey) {
     secp256k1_scalar sec;
     VERIFY_CHECK(ctx != NULL);
@@ -662,6 +1204,101 @@ int secp256k1_ec_pubkey_tweak_add(const secp256k1_context* ctx, secp256k1_pubkey
     return ret;
 }
 
+/* Number of tweaked public keys secp256k1_pubkey_tweak_add_batch converts to
+ * affine coordinates with a single field inversion. */
+#define PUBKEY_TWEAK_ADD_BATCH_CHUNK 64
+
+/* Computes output[i] = pubkey[i] + tweak32[i]*G. If is_negated is not NULL, the
+ * results are additionally brought into x-only form and is_negated[i] is set as
+ * secp256k1_xonly_pubkey_from_pubkey would. */
+static int secp256k1_pubkey_tweak_add_batch(const secp256k1_context* ctx, int *results, secp256k1_pubkey *output, int *is_negated, const secp256k1_pubkey *const *pubkey, const unsigned char *const *tweak32, size_t n) {
+    secp256k1_scalar term[PUBKEY_TWEAK_ADD_BATCH_CHUNK];
+    secp256k1_gej pj[PUBKEY_TWEAK_ADD_BATCH_CHUNK];
+    secp256k1_ge p[PUBKEY_TWEAK_ADD_BATCH_CHUNK];
+    int valid[PUBKEY_TWEAK_ADD_BATCH_CHUNK];
+    const secp256k1_pubkey *last = NULL;
+    int last_valid = 0;
+    secp256k1_ge q;
+    size_t i, j;
+    int ret = 1;
+    int use_gen;
+    VERIFY_CHECK(ctx != NULL);
+    if (n == 0) {
+        return 1;
+    }
+    use_gen = secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx);
+    ARG_CHECK(use_gen || secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    ARG_CHECK(output != NULL);
+    ARG_CHECK(pubkey != NULL);
+    ARG_CHECK(tweak32 != NULL);
+
+    for (i = 0; i < n; i += PUBKEY_TWEAK_ADD_BATCH_CHUNK) {
+        size_t m = n - i < PUBKEY_TWEAK_ADD_BATCH_CHUNK ? n - i : PUBKEY_TWEAK_ADD_BATCH_CHUNK;
+
+        /* Consecutive tweaks of the same public key load it only once. All inputs
+         * of the chunk are read before any output is written, so output[i] may be
+         * the same object as *pubkey[i]. */
+        for (j = 0; j < m; j++) {
+            int overflow;
+            if (pubkey[i + j] != last) {
+                last = pubkey[i + j];
+                last_valid = secp256k1_pubkey_load(ctx, &q, last);
+            }
+            if (last_valid) {
+                p[j] = q;
+            }
+            secp256k1_scalar_set_b32(&term[j], tweak32[i + j], &overflow);
+            valid[j] = last_valid && !overflow;
+            if (overflow) {
+                secp256k1_scalar_clear(&term[j]);
+            }
+        }
+
+        /* The tweaks are public, but the constant time comb is still faster than
+         * the variable time multiplication if the context has its table. */
+        if (use_gen) {
+            secp256k1_ecmult_gen_multi(&ctx->ecmult_gen_ctx, pj, term, m);
+        } else {
+            secp256k1_gej inf;
+            secp256k1_scalar zero;
+            secp256k1_gej_set_infinity(&inf);
+            secp256k1_scalar_set_int(&zero, 0);
+            for (j = 0; j < m; j++) {
+                secp256k1_ecmult(&ctx->ecmult_ctx, &pj[j], &inf, &zero, &term[j]);
+            }
+        }
+        for (j = 0; j < m; j++) {
+            if (valid[j]) {
+                secp256k1_gej_add_ge_var(&pj[j], &pj[j], &p[j], NULL);
+                valid[j] = !secp256k1_gej_is_infinity(&pj[j]);
+            }
+        }
+        secp256k1_ge_set_all_gej_var(p, pj, m);
+
+        for (j = 0; j < m; j++) {
+            memset(&output[i + j], 0, sizeof(output[i + j]));
+            if (is_negated != NULL) {
+                is_negated[i + j] = 0;
+            }
+            if (valid[j]) {
+                if (is_negated != NULL) {
+                    secp256k1_ge_absolute(&p[j], &is_negated[i + j]);
+                }
+                secp256k1_pubkey_save(&output[i + j], &p[j]);
+            }
+            if (results != NULL) {
+                results[i + j] = valid[j];
+            }
+            ret &= valid[j];
+        }
+    }
+    return ret;
+}
+
+int secp256k1_ec_pubkey_tweak_add_batch(const secp256k1_context* ctx, int *results, secp256k1_pubkey *output, const secp256k1_pubkey *const *pubkey, const unsigned char *const *tweak32, size_t n) {
+    return secp256k1_pubkey_tweak_add_batch(ctx, results, output, NULL, pubkey, tweak32, n);
+}
+
 int secp256k1_ec_privkey_tweak_mul(const secp256k1_context* ctx, unsigned char *seckey, const unsigned char *tweak) {
     secp256k1_scalar factor;
     secp256k1_scalar sec;
@@ -854,6 +1491,16 @@ int secp256k1_xonly_pubkey_tweak_add(const secp256k1_context* ctx, secp256k1_xon
     return secp256k1_xonly_pubkey_from_pubkey(ctx, pubkey, is_negated, (secp256k1_pubkey *) pubkey);
 }
 
+int secp256k1_xonly_pubkey_tweak_add_batch(const secp256k1_context* ctx, int *results, secp256k1_xonly_pubkey *output, int *is_negated, const secp256k1_xonly_pubkey *const *pubkey, const unsigned char *const *tweak32, size_t n) {
+    VERIFY_CHECK(ctx != NULL);
+    if (n == 0) {
+        return 1;
+    }
+    ARG_CHECK(is_negated != NULL);
+
+    return secp256k1_pubkey_tweak_add_batch(ctx, results, (secp256k1_pubkey *) output, is_negated, (const secp256k1_pubkey *const *) pubkey, tweak32, n);
+}
+
 int secp256k1_xonly_pubkey_tweak_test(const secp256k1_context* ctx, const secp256k1_xonly_pubkey *output_pubkey, int is_negated, const secp256k1_xonly_pubkey *internal_pubkey, const unsigned char *tweak32) {
     secp256k1_xonly_pubkey pk_expected;
     int is_negated_expected;
@@ -871,6 +1518,93 @@ int secp256k1_xonly_pubkey_tweak_test(const secp256k1_context* ctx, const secp25
             && is_negated_expected == is_negated;
 }
 
+static void secp256k1_keypair_save(secp256k1_keypair *keypair, const secp256k1_scalar *sk, secp256k1_ge *pk) {
+    secp256k1_scalar_get_b32(&keypair->data[0], sk);
+    secp256k1_xonly_pubkey_save((secp256k1_xonly_pubkey *) &keypair->data[32], pk);
+}
+
+static int secp256k1_keypair_load(const secp256k1_context* ctx, secp256k1_scalar *sk, secp256k1_ge *pk, const secp256k1_keypair *keypair) {
+    if (!secp256k1_xonly_pubkey_load(ctx, pk, (const secp256k1_xonly_pubkey *) &keypair->data[32])) {
+        return 0;
+    }
+    if (sk != NULL) {
+        secp256k1_scalar_set_b32(sk, &keypair->data[0], NULL);
+    }
+    return 1;
+}
+
+int secp256k1_keypair_create(const secp256k1_context* ctx, secp256k1_keypair *keypair, const unsigned char *seckey) {
+    secp256k1_gej pkj;
+    secp256k1_ge pk;
+    secp256k1_scalar sec;
+    int overflow;
+    int is_negated;
+    int ret;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(keypair != NULL);
+    memset(keypair, 0, sizeof(*keypair));
+    ARG_CHECK(secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx));
+    ARG_CHECK(seckey != NULL);
+
+    secp256k1_scalar_set_b32(&sec, seckey, &overflow);
+    ret = !overflow && !secp256k1_scalar_is_zero(&sec);
+    if (ret) {
+        secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &pkj, &sec);
+        secp256k1_ge_set_gej(&pk, &pkj);
+        secp256k1_ge_absolute(&pk, &is_negated);
+        if (is_negated) {
+            secp256k1_scalar_negate(&sec, &sec);
+        }
+        secp256k1_keypair_save(keypair, &sec, &pk);
+    }
+    secp256k1_scalar_clear(&sec);
+    return ret;
+}
+
+int secp256k1_keypair_xonly_pub(const secp256k1_context* ctx, secp256k1_xonly_pubkey *pubkey, const secp256k1_keypair *keypair) {
+    secp256k1_ge pk;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(pubkey != NULL);
+    memset(pubkey, 0, sizeof(*pubkey));
+    ARG_CHECK(keypair != NULL);
+
+    if (!secp256k1_keypair_load(ctx, NULL, &pk, keypair)) {
+        return 0;
+    }
+    secp256k1_xonly_pubkey_save(pubkey, &pk);
+    return 1;
+}
+
+int secp256k1_pubkey_table_create(const secp256k1_context* ctx, secp256k1_pubkey_table *table, const secp256k1_pubkey *pubkey) {
+    secp256k1_ge p;
+
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(table != NULL);
+    memset(table, 0, sizeof(*table));
+    ARG_CHECK(pubkey != NULL);
+    VERIFY_CHECK(sizeof(table->data) == ECMULT_POINT_TABLE_SIZE * sizeof(secp256k1_ge_storage));
+
+    if (!secp256k1_pubkey_load(ctx, &p, pubkey)) {
+        return 0;
+    }
+    secp256k1_ecmult_point_table(table->data, &p);
+    return 1;
+}
+
+int secp256k1_xonly_pubkey_table_create(const secp256k1_context* ctx, secp256k1_pubkey_table *table, const secp256k1_xonly_pubkey *pubkey) {
+    return secp256k1_pubkey_table_create(ctx, table, (const secp256k1_pubkey *) pubkey);
+}
+
+/* Checks that table was created for the point p by comparing its first entry,
+ * which is p itself. The other entries are not checked. */
+static int secp256k1_pubkey_table_matches(const secp256k1_pubkey_table *table, const secp256k1_ge *p) {
+    secp256k1_ge_storage s;
+    secp256k1_ge_storage t;
+    secp256k1_ge_to_storage(&s, p);
+    memcpy(&t, table->data, sizeof(t));
+    return memcmp(&s, &t, sizeof(s)) == 0;
+}
+
 #ifdef ENABLE_MODULE_ECDH
 # include "modules/ecdh/main_impl.h"
 #endif
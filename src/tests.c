@@ -18,6 +18,10 @@
 #include "include/secp256k1.h"
 #include "include/secp256k1_preallocated.h"
 #include "testrand_impl.h"
+#include "modinv32_impl.h"
+#ifdef HAVE___INT128
+#include "modinv64_impl.h"
+#endif
 
 #ifdef ENABLE_OPENSSL_TESTS
 #include "openssl/bn.h"
@@ -186,6 +190,25 @@ void run_util_tests(void) {
     }
 }
 
+void run_ctz_tests(void) {
+    static const uint32_t b32[] = {1, 0xffffffff, 0x5e56968f, 0xe0d63129};
+    static const uint64_t b64[] = {1, 0xffffffffffffffff, 0xbcd02462139b3fc3, 0x98b5f80c769693ef};
+    int shift;
+    unsigned i;
+    for (i = 0; i < sizeof(b32) / sizeof(b32[0]); ++i) {
+        for (shift = 0; shift < 32; ++shift) {
+            CHECK(secp256k1_ctz32_var_debruijn(b32[i] << shift) == shift);
+            CHECK(secp256k1_ctz32_var(b32[i] << shift) == shift);
+        }
+    }
+    for (i = 0; i < sizeof(b64) / sizeof(b64[0]); ++i) {
+        for (shift = 0; shift < 64; ++shift) {
+            CHECK(secp256k1_ctz64_var_debruijn(b64[i] << shift) == shift);
+            CHECK(secp256k1_ctz64_var(b64[i] << shift) == shift);
+        }
+    }
+}
+
 void run_context_tests(int use_prealloc) {
     secp256k1_pubkey pubkey;
     secp256k1_pubkey zero_pubkey;
@@ -380,6 +403,217 @@ void run_context_tests(int use_prealloc) {
 
 }
 
+void run_context_precomputed_tests(void) {
+    secp256k1_pubkey pubkey;
+    secp256k1_ecdsa_signature sig;
+    unsigned char ctmp[32];
+    int32_t ecount = 0;
+    size_t sign_len = secp256k1_context_precomputed_size(SECP256K1_CONTEXT_SIGN);
+    size_t both_len = secp256k1_context_precomputed_size(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    size_t ctx_len = secp256k1_context_preallocated_size(SECP256K1_CONTEXT_NONE);
+    unsigned char *sign_table = (unsigned char *)malloc(sign_len);
+    unsigned char *both_table = (unsigned char *)malloc(both_len);
+    void *prealloc = malloc(ctx_len);
+    void *clone_prealloc;
+    secp256k1_context *mapped;
+    secp256k1_context *clone;
+
+    CHECK(sign_table != NULL && both_table != NULL && prealloc != NULL);
+    CHECK(secp256k1_context_precomputed_size(SECP256K1_CONTEXT_NONE) < sign_len);
+    CHECK(sign_len < both_len);
+
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+    CHECK(secp256k1_context_precomputed_serialize(ctx, both_table, both_len - 1, SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY) == 0);
+    CHECK(secp256k1_context_precomputed_serialize(ctx, both_table, both_len, SECP256K1_EC_COMPRESSED) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_context_precomputed_serialize(ctx, sign_table, sign_len, SECP256K1_CONTEXT_SIGN) == 1);
+    CHECK(secp256k1_context_precomputed_serialize(ctx, both_table, both_len, SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY) == 1);
+    CHECK(secp256k1_context_precomputed_verify(ctx, sign_table, sign_len) == 1);
+    CHECK(secp256k1_context_precomputed_verify(ctx, both_table, both_len) == 1);
+    CHECK(secp256k1_context_precomputed_verify(ctx, both_table, both_len - 1) == 0);
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+
+    /* A context that only has the signing table must not be able to serialize
+     * verification tables. */
+    mapped = secp256k1_context_preallocated_create_precomputed(prealloc, SECP256K1_CONTEXT_SIGN, sign_table, sign_len);
+    CHECK(mapped != NULL);
+    CHECK(secp256k1_context_precomputed_serialize(mapped, both_table, both_len, SECP256K1_CONTEXT_VERIFY) == 0);
+    secp256k1_context_preallocated_destroy(mapped);
+    CHECK(secp256k1_context_preallocated_create_precomputed(prealloc, SECP256K1_CONTEXT_VERIFY, sign_table, sign_len) == NULL);
+
+    /* Use the tables in place and in a clone, which must not copy them. */
+    mapped = secp256k1_context_preallocated_create_precomputed(prealloc, SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY, both_table, both_len);
+    CHECK(mapped != NULL);
+    CHECK(secp256k1_context_preallocated_clone_size(mapped) == ctx_len);
+    clone_prealloc = malloc(ctx_len);
+    CHECK(clone_prealloc != NULL);
+    clone = secp256k1_context_preallocated_clone(mapped, clone_prealloc);
+    secp256k1_rand256(ctmp);
+    CHECK(secp256k1_context_randomize(mapped, ctmp) == 1);
+    CHECK(secp256k1_ec_pubkey_create(mapped, &pubkey, ctmp) == 1);
+    CHECK(secp256k1_ecdsa_sign(clone, &sig, ctmp, ctmp, NULL, NULL) == 1);
+    CHECK(secp256k1_ecdsa_verify(mapped, &sig, ctmp, &pubkey) == 1);
+    CHECK(secp256k1_ecdsa_verify(clone, &sig, ctmp, &pubkey) == 1);
+    CHECK(secp256k1_ecdsa_verify(ctx, &sig, ctmp, &pubkey) == 1);
+    secp256k1_context_preallocated_destroy(clone);
+    secp256k1_context_preallocated_destroy(mapped);
+    free(clone_prealloc);
+
+    /* A damaged table fails the checksum but is not detected at context creation. */
+    both_table[both_len - 1] ^= 1;
+    CHECK(secp256k1_context_precomputed_verify(ctx, both_table, both_len) == 0);
+    mapped = secp256k1_context_preallocated_create_precomputed(prealloc, SECP256K1_CONTEXT_VERIFY, both_table, both_len);
+    CHECK(mapped != NULL);
+    secp256k1_context_preallocated_destroy(mapped);
+    both_table[both_len - 1] ^= 1;
+
+    /* Tables for another window size, version, or representation are rejected. */
+    both_table[16] ^= 1;
+    CHECK(secp256k1_context_preallocated_create_precomputed(prealloc, SECP256K1_CONTEXT_VERIFY, both_table, both_len) == NULL);
+    CHECK(secp256k1_context_precomputed_verify(ctx, both_table, both_len) == 0);
+    both_table[16] ^= 1;
+    both_table[8] ^= 1;
+    CHECK(secp256k1_context_preallocated_create_precomputed(prealloc, SECP256K1_CONTEXT_VERIFY, both_table, both_len) == NULL);
+    both_table[8] ^= 1;
+    both_table[sign_len] ^= 1;
+    CHECK(secp256k1_context_preallocated_create_precomputed(prealloc, SECP256K1_CONTEXT_VERIFY, both_table, both_len) == NULL);
+    both_table[sign_len] ^= 1;
+    sign_table[SECP256K1_PRECOMPUTED_HEADER_SIZE] ^= 1;
+    CHECK(secp256k1_context_preallocated_create_precomputed(prealloc, SECP256K1_CONTEXT_SIGN, sign_table, sign_len) == NULL);
+    sign_table[SECP256K1_PRECOMPUTED_HEADER_SIZE] ^= 1;
+    both_table[SECP256K1_PRECOMPUTED_HEADER_SIZE] ^= 1;
+    CHECK(secp256k1_context_preallocated_create_precomputed(prealloc, SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY, both_table, both_len) == NULL);
+    both_table[SECP256K1_PRECOMPUTED_HEADER_SIZE] ^= 1;
+    CHECK(secp256k1_context_preallocated_create_precomputed(prealloc, SECP256K1_CONTEXT_VERIFY, both_table, both_len - 64) == NULL);
+
+    free(prealloc);
+    free(sign_table);
+    free(both_table);
+}
+
+void run_context_window_tests(void) {
+    static const int windows[5] = { 2, 3, 7, WINDOW_G, WINDOW_G < 24 ? WINDOW_G + 1 : 23 };
+    int i, j;
+
+    for (i = 0; i < 5; i++) {
+        int window = windows[i];
+        size_t len = secp256k1_context_preallocated_size_with_window(SECP256K1_CONTEXT_VERIFY, window);
+        size_t table_len = secp256k1_context_precomputed_size_with_window(SECP256K1_CONTEXT_VERIFY, window);
+        void *prealloc = malloc(len);
+        void *clone_prealloc = malloc(len);
+        void *mapped_prealloc = malloc(secp256k1_context_preallocated_size(SECP256K1_CONTEXT_NONE));
+        unsigned char *table = (unsigned char *)malloc(table_len);
+        secp256k1_context *vrfy, *clone, *mapped;
+
+        CHECK(prealloc != NULL && clone_prealloc != NULL && mapped_prealloc != NULL && table != NULL);
+        CHECK(secp256k1_context_preallocated_size_with_window(SECP256K1_CONTEXT_SIGN, window) == secp256k1_context_preallocated_size(SECP256K1_CONTEXT_SIGN));
+        vrfy = secp256k1_context_preallocated_create_with_window(prealloc, SECP256K1_CONTEXT_VERIFY, window);
+        CHECK(vrfy != NULL);
+        CHECK(vrfy->ecmult_ctx.window_g == window);
+        CHECK(secp256k1_context_preallocated_clone_size(vrfy) == len);
+        clone = secp256k1_context_preallocated_clone(vrfy, clone_prealloc);
+        secp256k1_context_preallocated_destroy(vrfy);
+        memset(prealloc, 0, len);
+        CHECK(clone->ecmult_ctx.window_g == window);
+
+        CHECK(secp256k1_context_precomputed_serialize(clone, table, table_len, SECP256K1_CONTEXT_VERIFY) == 1);
+        CHECK(secp256k1_context_precomputed_verify(ctx, table, table_len) == 1);
+        mapped = secp256k1_context_preallocated_create_precomputed(mapped_prealloc, SECP256K1_CONTEXT_VERIFY, table, table_len);
+        CHECK(mapped != NULL);
+        CHECK(mapped->ecmult_ctx.window_g == window);
+
+        for (j = 0; j < count; j++) {
+            secp256k1_scalar na, ng;
+            secp256k1_ge ag;
+            secp256k1_gej a, r, r2;
+            random_scalar_order_test(&na);
+            random_scalar_order_test(&ng);
+            random_group_element_test(&ag);
+            random_group_element_jacobian_test(&a, &ag);
+            secp256k1_ecmult(&ctx->ecmult_ctx, &r, &a, &na, &ng);
+            secp256k1_ecmult(&clone->ecmult_ctx, &r2, &a, &na, &ng);
+            secp256k1_gej_neg(&r2, &r2);
+            secp256k1_gej_add_var(&r2, &r2, &r, NULL);
+            CHECK(secp256k1_gej_is_infinity(&r2));
+            secp256k1_ecmult(&mapped->ecmult_ctx, &r2, &a, &na, &ng);
+            secp256k1_gej_neg(&r2, &r2);
+            secp256k1_gej_add_var(&r2, &r2, &r, NULL);
+            CHECK(secp256k1_gej_is_infinity(&r2));
+        }
+
+        secp256k1_context_preallocated_destroy(mapped);
+        secp256k1_context_preallocated_destroy(clone);
+        free(table);
+        free(mapped_prealloc);
+        free(clone_prealloc);
+        free(prealloc);
+    }
+}
+
+void run_context_shared_tests(void) {
+    secp256k1_pubkey pubkey;
+    secp256k1_ecdsa_signature sig;
+    unsigned char seed[32];
+    unsigned char prealloc_clone[512];
+    int32_t ecount = 0;
+    void *prealloc = malloc(secp256k1_context_preallocated_size(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY));
+    secp256k1_context *prealloced, *deep;
+    secp256k1_context *both = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    secp256k1_context *shared[3];
+    int i;
+
+    shared[0] = secp256k1_context_clone_shared(both);
+    shared[1] = secp256k1_context_clone_shared(shared[0]);
+    shared[2] = secp256k1_context_clone(shared[1]);
+#ifdef HAVE_BUILTIN_ATOMIC
+    for (i = 0; i < 3; i++) {
+        CHECK(shared[i]->table_owner == both);
+        CHECK(shared[i]->ecmult_ctx.pre_g == both->ecmult_ctx.pre_g);
+        CHECK(shared[i]->ecmult_gen_ctx.prec == both->ecmult_gen_ctx.prec);
+        CHECK(secp256k1_context_preallocated_clone_size(shared[i]) == secp256k1_context_preallocated_size(SECP256K1_CONTEXT_NONE));
+    }
+    CHECK(both->table_refs == 4);
+    secp256k1_context_set_illegal_callback(shared[0], counting_illegal_callback_fn, &ecount);
+    CHECK(sizeof(prealloc_clone) >= secp256k1_context_preallocated_clone_size(shared[0]));
+    CHECK(secp256k1_context_preallocated_clone(shared[0], prealloc_clone) == NULL);
+    CHECK(ecount == 1);
+    secp256k1_context_set_illegal_callback(shared[0], NULL, NULL);
+#else
+    (void)ecount;
+    (void)prealloc_clone;
+#endif
+
+    /* The randomization is per context, and the tables outlive the context
+     * they came from. */
+    secp256k1_rand256(seed);
+    CHECK(secp256k1_context_randomize(shared[0], seed) == 1);
+    CHECK(memcmp(&shared[0]->ecmult_gen_ctx.scalar_offset, &shared[1]->ecmult_gen_ctx.scalar_offset, sizeof(secp256k1_scalar)) != 0);
+    secp256k1_context_destroy(both);
+    for (i = 0; i < 3; i++) {
+        secp256k1_rand256(seed);
+        CHECK(secp256k1_ec_pubkey_create(shared[i], &pubkey, seed) == 1);
+        CHECK(secp256k1_ecdsa_sign(shared[i], &sig, seed, seed, NULL, NULL) == 1);
+        CHECK(secp256k1_ecdsa_verify(shared[(i + 1) % 3], &sig, seed, &pubkey) == 1);
+        CHECK(secp256k1_ecdsa_verify(ctx, &sig, seed, &pubkey) == 1);
+    }
+    secp256k1_context_destroy(shared[1]);
+    secp256k1_context_destroy(shared[0]);
+    secp256k1_context_destroy(shared[2]);
+
+    /* Contexts in caller-provided memory are copied instead. */
+    CHECK(prealloc != NULL);
+    prealloced = secp256k1_context_preallocated_create(prealloc, SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    deep = secp256k1_context_clone_shared(prealloced);
+    CHECK(deep->table_owner == NULL);
+    secp256k1_context_preallocated_destroy(prealloced);
+    free(prealloc);
+    secp256k1_rand256(seed);
+    CHECK(secp256k1_ec_pubkey_create(deep, &pubkey, seed) == 1);
+    CHECK(secp256k1_ecdsa_sign(deep, &sig, seed, seed, NULL, NULL) == 1);
+    CHECK(secp256k1_ecdsa_verify(deep, &sig, seed, &pubkey) == 1);
+    secp256k1_context_destroy(deep);
+}
+
 void run_scratch_tests(void) {
     const size_t adj_alloc = ((500 + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
 
@@ -489,6 +723,92 @@ void run_sha256_tests(void) {
     }
 }
 
+void run_sha256_transform_tests(void) {
+    int i, j;
+    for (i = 0; i < count * 16; i++) {
+        uint32_t s1[8], s2[8], chunk[16];
+        for (j = 0; j < 8; j++) {
+            s1[j] = s2[j] = secp256k1_rand32();
+        }
+        for (j = 0; j < 16; j++) {
+            chunk[j] = secp256k1_rand32();
+        }
+        secp256k1_sha256_transform(s1, chunk);
+        secp256k1_sha256_transform_portable(s2, chunk);
+        CHECK(memcmp(s1, s2, sizeof(s1)) == 0);
+#if defined(USE_SHA256_HW_X86) || defined(USE_SHA256_HW_ARM)
+        if (secp256k1_sha256_hw_supported()) {
+            secp256k1_sha256_transform_hw(s1, chunk);
+            secp256k1_sha256_transform_portable(s2, chunk);
+            CHECK(memcmp(s1, s2, sizeof(s1)) == 0);
+        }
+#endif
+    }
+}
+
+void test_sha256_multi(int lanes) {
+    static const unsigned char tag[3] = "tag";
+    unsigned char data[2 * SECP256K1_SHA256_LANES + 3][200];
+    unsigned char out[2 * SECP256K1_SHA256_LANES + 3][32];
+    const unsigned char *msg[2 * SECP256K1_SHA256_LANES + 3];
+    unsigned char *out32[2 * SECP256K1_SHA256_LANES + 3];
+    secp256k1_sha256 prefix;
+    size_t i, n;
+    int t;
+
+    for (i = 0; i < 2 * SECP256K1_SHA256_LANES + 3; i++) {
+        secp256k1_rand_bytes_test(data[i], sizeof(data[i]));
+        msg[i] = data[i];
+        out32[i] = out[i];
+    }
+    for (t = 0; t < 2; t++) {
+        if (t == 0) {
+            secp256k1_sha256_initialize(&prefix);
+        } else {
+            secp256k1_sha256_initialize_tagged(&prefix, tag, sizeof(tag));
+        }
+        for (n = 0; n <= 2 * SECP256K1_SHA256_LANES + 3; n++) {
+            /* All lengths around the block boundaries */
+            size_t len = n == 2 * SECP256K1_SHA256_LANES + 3 ? 200 : (n * 7) % 140;
+            if (lanes) {
+                secp256k1_sha256_finalize_multi_lanes(&prefix, out32, msg, len, n);
+            } else {
+                secp256k1_sha256_finalize_multi(&prefix, out32, msg, len, n);
+            }
+            for (i = 0; i < n; i++) {
+                secp256k1_sha256 hasher = prefix;
+                unsigned char expected[32];
+                secp256k1_sha256_write(&hasher, data[i], len);
+                secp256k1_sha256_finalize(&hasher, expected);
+                CHECK(memcmp(out[i], expected, 32) == 0);
+            }
+        }
+    }
+    /* Every length up to three blocks */
+    secp256k1_sha256_initialize(&prefix);
+    for (i = 0; i <= 192; i++) {
+        unsigned char expected[32];
+        secp256k1_sha256 hasher = prefix;
+        if (lanes) {
+            secp256k1_sha256_finalize_multi_lanes(&prefix, out32, msg, i, 1);
+        } else {
+            secp256k1_sha256_finalize_multi(&prefix, out32, msg, i, 1);
+        }
+        secp256k1_sha256_write(&hasher, data[0], i);
+        secp256k1_sha256_finalize(&hasher, expected);
+        CHECK(memcmp(out[0], expected, 32) == 0);
+    }
+}
+
+void run_sha256_multi_tests(void) {
+    test_sha256_multi(0);
+    /* With hardware SHA256 the messages are hashed one at a time, so test the
+     * vectorized lanes separately. */
+    if (secp256k1_sha256_hw_supported()) {
+        test_sha256_multi(1);
+    }
+}
+
 /* Tests for the equality of two sha256 structs. This function only produces a
  * correct result if an integer multiple of 64 many bytes have been written
  * into the hash functions. */
@@ -604,7 +924,7 @@ void run_rfc6979_hmac_sha256_tests(void) {
 
     secp256k1_rfc6979_hmac_sha256 rng;
     unsigned char out[32];
-    int i;
+    int i, j;
 
     secp256k1_rfc6979_hmac_sha256_initialize(&rng, key1, 64);
     for (i = 0; i < 3; i++) {
@@ -626,6 +946,19 @@ void run_rfc6979_hmac_sha256_tests(void) {
         CHECK(memcmp(out, out2[i], 32) == 0);
     }
     secp256k1_rfc6979_hmac_sha256_finalize(&rng);
+
+    /* Splitting the key into a precomputed prefix and the rest gives the same output. */
+    for (j = 0; j < 5; j++) {
+        static const size_t splits[5] = {0, 31, 32, 33, 64};
+        secp256k1_hmac_sha256 hmac;
+        secp256k1_rfc6979_hmac_sha256_precompute(&hmac, key2, splits[j]);
+        secp256k1_rfc6979_hmac_sha256_initialize_precomputed(&rng, &hmac, key2, splits[j], key2 + splits[j], 64 - splits[j]);
+        for (i = 0; i < 3; i++) {
+            secp256k1_rfc6979_hmac_sha256_generate(&rng, out, 32);
+            CHECK(memcmp(out, out2[i], 32) == 0);
+        }
+        secp256k1_rfc6979_hmac_sha256_finalize(&rng);
+    }
 }
 
 /***** RANDOM TESTS *****/
@@ -1285,12 +1618,44 @@ void scalar_chacha_tests(void) {
     CHECK(secp256k1_scalar_eq(&exp_r2, &r2));
 }
 
+void run_scalar_inverse_all_var(void) {
+    secp256k1_scalar x[16], xi[16], xii[16];
+    int i;
+    /* Check it's safe to call for 0 elements */
+    secp256k1_scalar_inverse_all_var(xi, x, 0);
+    secp256k1_scalar_inverse_all(xi, x, 0);
+    for (i = 0; i < count; i++) {
+        size_t j;
+        size_t len = secp256k1_rand_int(15) + 1;
+        for (j = 0; j < len; j++) {
+            random_scalar_order_test(&x[j]);
+        }
+        secp256k1_scalar_inverse_all_var(xi, x, len);
+        for (j = 0; j < len; j++) {
+            secp256k1_scalar t;
+            secp256k1_scalar_mul(&t, &x[j], &xi[j]);
+            CHECK(secp256k1_scalar_is_one(&t));
+        }
+        secp256k1_scalar_inverse_all_var(xii, xi, len);
+        for (j = 0; j < len; j++) {
+            CHECK(secp256k1_scalar_eq(&x[j], &xii[j]));
+        }
+        /* The constant-time version computes the same inverses */
+        secp256k1_scalar_inverse_all(xii, x, len);
+        for (j = 0; j < len; j++) {
+            CHECK(secp256k1_scalar_eq(&xi[j], &xii[j]));
+        }
+    }
+}
+
 void run_scalar_tests(void) {
     int i;
     for (i = 0; i < 128 * count; i++) {
         scalar_test();
     }
 
+    run_scalar_inverse_all_var();
+
     scalar_chacha_tests();
 
     {
@@ -1342,9 +1707,7 @@ void run_scalar_tests(void) {
         secp256k1_scalar one;
         secp256k1_scalar r1;
         secp256k1_scalar r2;
-#if defined(USE_SCALAR_INV_NUM)
         secp256k1_scalar zzv;
-#endif
         int overflow;
         unsigned char chal[33][2][32] = {
             {{0xff, 0xff, 0x03, 0x07, 0x00, 0x00, 0x00, 0x00,
@@ -1894,10 +2257,8 @@ void run_scalar_tests(void) {
             if (!secp256k1_scalar_is_zero(&y)) {
                 secp256k1_scalar_inverse(&zz, &y);
                 CHECK(!secp256k1_scalar_check_overflow(&zz));
-#if defined(USE_SCALAR_INV_NUM)
                 secp256k1_scalar_inverse_var(&zzv, &y);
                 CHECK(secp256k1_scalar_eq(&zzv, &zz));
-#endif
                 secp256k1_scalar_mul(&z, &z, &zz);
                 CHECK(!secp256k1_scalar_check_overflow(&z));
                 CHECK(secp256k1_scalar_eq(&x, &z));
@@ -2138,6 +2499,158 @@ void run_field_inv_all_var(void) {
     }
 }
 
+static const secp256k1_scalar scalar_minus_one = SECP256K1_SCALAR_CONST(
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE,
+    0xBAAEDCE6, 0xAF48A03B, 0xBFD25E8C, 0xD0364140
+);
+static const secp256k1_scalar scalar_one = SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 1);
+static const secp256k1_fe fe_minus_one = SECP256K1_FE_CONST(
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE, 0xFFFFFC2E
+);
+static const secp256k1_fe fe_one = SECP256K1_FE_CONST(0, 0, 0, 0, 0, 0, 0, 1);
+
+void test_inverse_scalar(secp256k1_scalar* out, const secp256k1_scalar* x, int var) {
+    secp256k1_scalar l, r, t;
+
+    (var ? secp256k1_scalar_inverse_var : secp256k1_scalar_inverse)(&l, x);  /* l = 1/x */
+    if (out) *out = l;
+    if (secp256k1_scalar_is_zero(x)) {
+        CHECK(secp256k1_scalar_is_zero(&l));
+        return;
+    }
+    secp256k1_scalar_mul(&t, x, &l);                                             /* t = x*(1/x) */
+    CHECK(secp256k1_scalar_is_one(&t));                                          /* x*(1/x) == 1 */
+    secp256k1_scalar_add(&r, x, &scalar_minus_one);                              /* r = x-1 */
+    if (secp256k1_scalar_is_zero(&r)) return;
+    (var ? secp256k1_scalar_inverse_var : secp256k1_scalar_inverse)(&r, &r);  /* r = 1/(x-1) */
+    secp256k1_scalar_add(&l, &scalar_minus_one, &l);                             /* l = 1/x-1 */
+    (var ? secp256k1_scalar_inverse_var : secp256k1_scalar_inverse)(&l, &l);  /* l = 1/(1/x-1) */
+    secp256k1_scalar_add(&l, &l, &scalar_one);                                   /* l = 1/(1/x-1)+1 */
+    secp256k1_scalar_add(&l, &r, &l);                                            /* l = 1/(1/x-1)+1 + 1/(x-1) */
+    CHECK(secp256k1_scalar_is_zero(&l));                                         /* l == 0 */
+}
+
+void test_inverse_field(secp256k1_fe* out, const secp256k1_fe* x, int var) {
+    secp256k1_fe l, r, t;
+
+    (var ? secp256k1_fe_inv_var : secp256k1_fe_inv)(&l, x);   /* l = 1/x */
+    if (out) *out = l;
+    t = *x;                                                    /* t = x */
+    if (secp256k1_fe_normalizes_to_zero_var(&t)) {
+        CHECK(secp256k1_fe_normalizes_to_zero(&l));
+        return;
+    }
+    secp256k1_fe_mul(&t, x, &l);                               /* t = x*(1/x) */
+    secp256k1_fe_add(&t, &fe_minus_one);                       /* t = x*(1/x)-1 */
+    CHECK(secp256k1_fe_normalizes_to_zero(&t));                /* x*(1/x)-1 == 0 */
+    r = *x;                                                    /* r = x */
+    secp256k1_fe_add(&r, &fe_minus_one);                       /* r = x-1 */
+    if (secp256k1_fe_normalizes_to_zero_var(&r)) return;
+    (var ? secp256k1_fe_inv_var : secp256k1_fe_inv)(&r, &r);   /* r = 1/(x-1) */
+    secp256k1_fe_add(&l, &fe_minus_one);                       /* l = 1/x-1 */
+    (var ? secp256k1_fe_inv_var : secp256k1_fe_inv)(&l, &l);   /* l = 1/(1/x-1) */
+    secp256k1_fe_add(&l, &fe_one);                             /* l = 1/(1/x-1)+1 */
+    secp256k1_fe_add(&l, &r);                                  /* l = 1/(1/x-1)+1 + 1/(x-1) */
+    CHECK(secp256k1_fe_normalizes_to_zero_var(&l));            /* l == 0 */
+}
+
+void run_inverse_tests(void) {
+    /* Fixed test cases for field inverses: pairs of (x, 1/x) mod p. */
+    static const secp256k1_fe fe_cases[][2] = {
+        /* 0 */
+        {SECP256K1_FE_CONST(0, 0, 0, 0, 0, 0, 0, 0),
+         SECP256K1_FE_CONST(0, 0, 0, 0, 0, 0, 0, 0)},
+        /* 1 */
+        {SECP256K1_FE_CONST(0, 0, 0, 0, 0, 0, 0, 1),
+         SECP256K1_FE_CONST(0, 0, 0, 0, 0, 0, 0, 1)},
+        /* -1 */
+        {SECP256K1_FE_CONST(0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xfffffffe, 0xfffffc2e),
+         SECP256K1_FE_CONST(0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xfffffffe, 0xfffffc2e)},
+        /* 2^255 */
+        {SECP256K1_FE_CONST(0x80000000, 0, 0, 0, 0, 0, 0, 0),
+         SECP256K1_FE_CONST(0x937a320a, 0x2aa70733, 0x388d8585, 0x2be56ec3, 0x796447fd, 0xb84940b3, 0xb070123b, 0x10d03625)},
+        /* 2^255 - 1 */
+        {SECP256K1_FE_CONST(0x7fffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff),
+         SECP256K1_FE_CONST(0x5798fee7, 0x604d2cc8, 0x3a12716a, 0xd3c20a23, 0x7ffb62cb, 0x9192bab0, 0x922af982, 0xf6bab4b3)},
+        /* 2^128 */
+        {SECP256K1_FE_CONST(0, 0, 0, 1, 0, 0, 0, 0),
+         SECP256K1_FE_CONST(0xbcb223fe, 0xdc24a059, 0xd838091d, 0xd2253530, 0xffffffff, 0xffffffff, 0xffffffff, 0x434dd931)}
+    };
+    /* Fixed test cases for scalar inverses: pairs of (x, 1/x) mod n. */
+    static const secp256k1_scalar scalar_cases[][2] = {
+        /* 0 */
+        {SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 0),
+         SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 0)},
+        /* 1 */
+        {SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 1),
+         SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 1)},
+        /* -1 */
+        {SECP256K1_SCALAR_CONST(0xffffffff, 0xffffffff, 0xffffffff, 0xfffffffe, 0xbaaedce6, 0xaf48a03b, 0xbfd25e8c, 0xd0364140),
+         SECP256K1_SCALAR_CONST(0xffffffff, 0xffffffff, 0xffffffff, 0xfffffffe, 0xbaaedce6, 0xaf48a03b, 0xbfd25e8c, 0xd0364140)},
+        /* 2^255 */
+        {SECP256K1_SCALAR_CONST(0x80000000, 0, 0, 0, 0, 0, 0, 0),
+         SECP256K1_SCALAR_CONST(0xb3d1121a, 0xc929df27, 0x12fe6182, 0x4f9f56bb, 0xbcc8cbc6, 0x5001783d, 0x4227e69a, 0x30f93eeb)},
+        /* 2^128 */
+        {SECP256K1_SCALAR_CONST(0, 0, 0, 1, 0, 0, 0, 0),
+         SECP256K1_SCALAR_CONST(0x50a51ac8, 0x34b9ec24, 0x4b0dff66, 0x5588b13e, 0x9984d5b3, 0xcf80ef0f, 0xd6a23766, 0xa3ee9f22)}
+    };
+    int i, var, testrand, fe_valid;
+    unsigned char b32[32];
+    secp256k1_fe x_fe;
+    secp256k1_scalar x_scalar;
+    memset(b32, 0, sizeof(b32));
+    /* Test fixed test cases through test_inverse_{scalar,field}, both ways. */
+    for (i = 0; (size_t)i < sizeof(fe_cases)/sizeof(fe_cases[0]); ++i) {
+        for (var = 0; var <= 1; ++var) {
+            test_inverse_field(&x_fe, &fe_cases[i][0], var);
+            CHECK(check_fe_equal(&x_fe, &fe_cases[i][1]));
+            test_inverse_field(&x_fe, &fe_cases[i][1], var);
+            CHECK(check_fe_equal(&x_fe, &fe_cases[i][0]));
+        }
+    }
+    for (i = 0; (size_t)i < sizeof(scalar_cases)/sizeof(scalar_cases[0]); ++i) {
+        for (var = 0; var <= 1; ++var) {
+            test_inverse_scalar(&x_scalar, &scalar_cases[i][0], var);
+            CHECK(secp256k1_scalar_eq(&x_scalar, &scalar_cases[i][1]));
+            test_inverse_scalar(&x_scalar, &scalar_cases[i][1], var);
+            CHECK(secp256k1_scalar_eq(&x_scalar, &scalar_cases[i][0]));
+        }
+    }
+    /* Test inputs 0..999 and their respective negations. */
+    for (i = 0; i < 1000; ++i) {
+        b32[31] = i & 0xff;
+        b32[30] = (i >> 8) & 0xff;
+        secp256k1_scalar_set_b32(&x_scalar, b32, NULL);
+        secp256k1_fe_set_b32(&x_fe, b32);
+        for (var = 0; var <= 1; ++var) {
+            test_inverse_scalar(NULL, &x_scalar, var);
+            test_inverse_field(NULL, &x_fe, var);
+        }
+        secp256k1_scalar_negate(&x_scalar, &x_scalar);
+        secp256k1_fe_negate(&x_fe, &x_fe, 1);
+        for (var = 0; var <= 1; ++var) {
+            test_inverse_scalar(NULL, &x_scalar, var);
+            test_inverse_field(NULL, &x_fe, var);
+        }
+    }
+    /* test 128*count random inputs; half with testrand256_test, half with testrand256 */
+    for (testrand = 0; testrand <= 1; ++testrand) {
+        for (i = 0; i < 64 * count; ++i) {
+            (testrand ? secp256k1_rand256_test : secp256k1_rand256)(b32);
+            secp256k1_scalar_set_b32(&x_scalar, b32, NULL);
+            /* b32 may not be a valid field element, in which case x_fe is not set */
+            fe_valid = secp256k1_fe_set_b32(&x_fe, b32);
+            for (var = 0; var <= 1; ++var) {
+                test_inverse_scalar(NULL, &x_scalar, var);
+                if (fe_valid) {
+                    test_inverse_field(NULL, &x_fe, var);
+                }
+            }
+        }
+    }
+}
+
 void run_sqr(void) {
     secp256k1_fe x, s;
 
@@ -2154,10 +2667,122 @@ void run_sqr(void) {
     }
 }
 
+void random_fe_lanes_test(secp256k1_fe_lanes *r, int extreme) {
+    /* Random limbs of magnitude at most 8; if extreme, every limb is 0 or its maximum. */
+    int i, l;
+    for (i = 0; i < 10; i++) {
+        uint32_t max = (i == 9 ? 0x3FFFFFUL : 0x3FFFFFFUL) * 16;
+        for (l = 0; l < SECP256K1_FE_LANES; l++) {
+            if (extreme) {
+                r->n[i][l] = secp256k1_rand_bits(2) ? max : 0;
+            } else {
+                r->n[i][l] = secp256k1_rand_int(max + 1);
+            }
+        }
+    }
+}
+
+void check_fe_lanes_magnitude_1(const secp256k1_fe_lanes *a) {
+    int i, l;
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        for (i = 0; i < 10; i++) {
+            CHECK(a->n[i][l] <= (i == 9 ? 0x3FFFFFUL : 0x3FFFFFFUL) * 2);
+        }
+    }
+}
+
+void test_field_lanes(void) {
+    secp256k1_fe_lanes a, b, r, s, t;
+    secp256k1_fe fa, fb, fr, fx;
+    int zero[SECP256K1_FE_LANES], flag[SECP256K1_FE_LANES];
+    int extreme = secp256k1_rand_bits(1);
+    int l;
+
+    random_fe_lanes_test(&a, extreme);
+    random_fe_lanes_test(&b, extreme);
+    secp256k1_fe_lanes_mul(&r, &a, &b);
+    secp256k1_fe_lanes_sqr(&s, &a);
+    check_fe_lanes_magnitude_1(&r);
+    check_fe_lanes_magnitude_1(&s);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        secp256k1_fe_lanes_get_fe(&fa, &a, l);
+        secp256k1_fe_lanes_get_fe(&fb, &b, l);
+        secp256k1_fe_mul(&fx, &fa, &fb);
+        secp256k1_fe_lanes_get_fe(&fr, &r, l);
+        CHECK(check_fe_equal(&fx, &fr));
+        secp256k1_fe_sqr(&fx, &fa);
+        secp256k1_fe_lanes_get_fe(&fr, &s, l);
+        CHECK(check_fe_equal(&fx, &fr));
+    }
+
+    /* Aliasing */
+    t = a;
+    secp256k1_fe_lanes_mul(&t, &t, &b);
+    CHECK(memcmp(&t, &r, sizeof(t)) == 0);
+    t = a;
+    secp256k1_fe_lanes_sqr(&t, &t);
+    CHECK(memcmp(&t, &s, sizeof(t)) == 0);
+
+    /* set_fe/get_fe, negate, add and normalizes_to_zero */
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        random_fe_test(&fa);
+        secp256k1_fe_lanes_set_fe(&a, l, &fa);
+        secp256k1_fe_lanes_get_fe(&fr, &a, l);
+        CHECK(check_fe_equal(&fa, &fr));
+        flag[l] = l & 1;
+    }
+    secp256k1_fe_lanes_negate(&b, &a, 1);
+    secp256k1_fe_lanes_mul_int(&b, 3);
+    t = a;
+    secp256k1_fe_lanes_mul_int(&t, 3);
+    secp256k1_fe_lanes_add(&b, &t);
+    secp256k1_fe_lanes_normalizes_to_zero(zero, &b);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        CHECK(zero[l]);
+    }
+
+    /* cmov */
+    t = r;
+    secp256k1_fe_lanes_cmov(&t, &s, flag);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        secp256k1_fe_lanes_get_fe(&fx, flag[l] ? &s : &r, l);
+        secp256k1_fe_lanes_get_fe(&fr, &t, l);
+        CHECK(check_fe_equal(&fx, &fr));
+    }
+}
+
+/* Runs test n times with every lane engine the CPU supports. Without VERIFY (in
+ * coverage builds) the engine cannot be forced, so only the default one runs. */
+void run_lanes_test(void (*test)(void), int n) {
+    int i;
+#ifdef VERIFY
+    int e;
+    for (e = SECP256K1_FE_LANES_PORTABLE; e <= SECP256K1_FE_LANES_IFMA; e++) {
+        if (!secp256k1_fe_lanes_engine_supported(e)) {
+            continue;
+        }
+        secp256k1_fe_lanes_engine_override = e;
+        for (i = 0; i < n; i++) {
+            test();
+        }
+    }
+    secp256k1_fe_lanes_engine_override = -1;
+#else
+    for (i = 0; i < n; i++) {
+        test();
+    }
+#endif
+}
+
+void run_field_lanes(void) {
+    run_lanes_test(test_field_lanes, 4 * count);
+}
+
 void test_sqrt(const secp256k1_fe *a, const secp256k1_fe *k) {
     secp256k1_fe r1, r2;
     int v = secp256k1_fe_sqrt(&r1, a);
     CHECK((v == 0) == (k == NULL));
+    CHECK(secp256k1_fe_is_quad_var(a) == v);
 
     if (k != NULL) {
         /* Check that the returned root is +/- the given known answer */
@@ -2202,6 +2827,125 @@ void run_sqrt(void) {
     }
 }
 
+/* Extract len <= 62 bits starting at bit pos from a 32-byte big endian number. */
+uint64_t b32_get_bits(const unsigned char *b32, int pos, int len) {
+    uint64_t r = 0;
+    int i;
+    for (i = 0; i < len && pos + i < 256; i++) {
+        r |= (uint64_t)((b32[31 - ((pos + i) >> 3)] >> ((pos + i) & 7)) & 1) << i;
+    }
+    return r;
+}
+
+/* p in the limb representations of modinv32 and modinv64, independently of the
+ * field implementation that is in use. */
+static const secp256k1_modinv32_modinfo test_modinfo_fe32 = {
+    {{-0x3D1, -4, 0, 0, 0, 0, 0, 0, 65536}},
+    0x2DDACACFL
+};
+#ifdef HAVE___INT128
+static const secp256k1_modinv64_modinfo test_modinfo_fe64 = {
+    {{-0x1000003D1LL, 0, 0, 0, 256}},
+    0x27C7F6E22DDACACFLL
+};
+#endif
+
+/* Check the Jacobi symbol of x against secp256k1_fe_sqrt with both limb sizes,
+ * through secp256k1_fe_jacobi_maybe_var, and through secp256k1_fe_is_quad_var
+ * including its fallback for unknown results. */
+void test_jacobi(const secp256k1_fe *x) {
+    secp256k1_modinv32_signed30 s30;
+#ifdef HAVE___INT128
+    secp256k1_modinv64_signed62 s62;
+#endif
+    secp256k1_fe t, r;
+    unsigned char b32[32];
+    int sq, jac, i;
+
+    t = *x;
+    secp256k1_fe_normalize_var(&t);
+    sq = secp256k1_fe_sqrt(&r, &t);
+    jac = secp256k1_fe_jacobi_maybe_var(x);
+    CHECK(jac == 0 || jac == (sq ? 1 : -1));
+    CHECK(secp256k1_fe_is_quad_var(x) == sq);
+    CHECK(secp256k1_fe_is_quad_jacobi_var(x, 0) == sq);
+    if (secp256k1_fe_is_zero(&t)) {
+        /* 0 is a square, but the limb functions require inputs coprime to p. */
+        CHECK(sq == 1 && jac == 1);
+        return;
+    }
+
+    secp256k1_fe_get_b32(b32, &t);
+    for (i = 0; i < 9; i++) {
+        s30.v[i] = b32_get_bits(b32, 30 * i, 30);
+    }
+    jac = secp256k1_jacobi32_maybe_var(&s30, &test_modinfo_fe32);
+    CHECK(jac == 0 || jac == (sq ? 1 : -1));
+#ifdef HAVE___INT128
+    for (i = 0; i < 5; i++) {
+        s62.v[i] = b32_get_bits(b32, 62 * i, 62);
+    }
+    jac = secp256k1_jacobi64_maybe_var(&s62, &test_modinfo_fe64);
+    CHECK(jac == 0 || jac == (sq ? 1 : -1));
+#endif
+}
+
+void run_jacobi_tests(void) {
+    static const secp256k1_fe fe_cases[] = {
+        /* -1 */
+        SECP256K1_FE_CONST(0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xfffffffe, 0xfffffc2e),
+        /* (p-1)/2 */
+        SECP256K1_FE_CONST(0x7fffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x7ffffe17),
+        /* 2^255 */
+        SECP256K1_FE_CONST(0x80000000, 0, 0, 0, 0, 0, 0, 0),
+        /* 2^255 - 1 */
+        SECP256K1_FE_CONST(0x7fffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff),
+        /* 2^128 */
+        SECP256K1_FE_CONST(0, 0, 0, 1, 0, 0, 0, 0)
+    };
+    secp256k1_fe x, s, t, ns, zero;
+    int i, j;
+
+    /* 0, normalized and as a multiple of p. */
+    secp256k1_fe_set_int(&zero, 0);
+    test_jacobi(&zero);
+    for (i = 1; i <= 8; i *= 2) {
+        secp256k1_fe_negate(&t, &zero, i);
+        test_jacobi(&t);
+    }
+
+    /* Small values and their negations. These always converge. */
+    for (i = 1; i <= 1000; i++) {
+        secp256k1_fe_set_int(&x, i);
+        CHECK(secp256k1_fe_jacobi_maybe_var(&x) != 0);
+        test_jacobi(&x);
+        secp256k1_fe_negate(&t, &x, 1);
+        test_jacobi(&t);
+    }
+
+    for (i = 0; (size_t)i < sizeof(fe_cases) / sizeof(fe_cases[0]); i++) {
+        test_jacobi(&fe_cases[i]);
+        secp256k1_fe_negate(&t, &fe_cases[i], 1);
+        test_jacobi(&t);
+    }
+
+    /* Random squares, non-squares and other values, also before normalization. */
+    random_fe_non_square(&ns);
+    for (i = 0; i < 10 * count; i++) {
+        random_fe(&x);
+        test_jacobi(&x);
+        secp256k1_fe_sqr(&s, &x);
+        test_jacobi(&s);
+        secp256k1_fe_mul(&t, &s, &ns);
+        test_jacobi(&t);
+        for (j = 1; j <= 4; j *= 2) {
+            secp256k1_fe_negate(&t, &zero, j);
+            secp256k1_fe_add(&t, &s);
+            test_jacobi(&t);
+        }
+    }
+}
+
 /***** GROUP TESTS *****/
 
 void ge_equals_ge(const secp256k1_ge *a, const secp256k1_ge *b) {
@@ -2443,6 +3187,11 @@ void test_ge(void) {
             secp256k1_gej_rescale(&gej[i], &s);
             ge_equals_gej(&ge_set_all[i], &gej[i]);
         }
+        /* The constant time version does not support infinity, which is only at index 0. */
+        secp256k1_ge_set_all_gej(ge_set_all, &gej[1], 4 * runs);
+        for (i = 0; i < 4 * runs; i++) {
+            ge_equals_gej(&ge_set_all[i], &gej[i + 1]);
+        }
         free(ge_set_all);
         free(zr);
     }
@@ -2639,6 +3388,77 @@ void test_group_decompress(const secp256k1_fe* x) {
     }
 }
 
+void test_group_lanes(void) {
+    static const secp256k1_fe beta = SECP256K1_FE_CONST(
+        0x7ae96a2bul, 0x657c0710ul, 0x6e64479eul, 0xac3434e9ul,
+        0x9cf04975ul, 0x12f58995ul, 0xc1396c28ul, 0x719501eeul
+    );
+    secp256k1_ge b[SECP256K1_FE_LANES], ga;
+    secp256k1_gej a[SECP256K1_FE_LANES], r, rl;
+    secp256k1_ge_lanes bl;
+    secp256k1_gej_lanes al, sl;
+    int l;
+
+    /* Lane 0 is a generic addition, lane 1 adds to infinity, lane 2 doubles and lane 3
+     * adds points with opposite y, which is either b + -b or the degenerate case of the
+     * unified formula where x differs by a cube root of one. */
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        random_group_element_test(&b[l]);
+        switch (l & 3) {
+        case 0:
+            random_group_element_test(&ga);
+            break;
+        case 2:
+            ga = b[l];
+            break;
+        case 3:
+            secp256k1_ge_neg(&ga, &b[l]);
+            if (secp256k1_rand_bits(1)) {
+                secp256k1_fe_mul(&ga.x, &ga.x, &beta);
+            }
+            break;
+        }
+        if ((l & 3) == 1) {
+            secp256k1_gej_set_infinity(&a[l]);
+        } else {
+            random_group_element_jacobian_test(&a[l], &ga);
+        }
+        secp256k1_ge_lanes_set_ge(&bl, l, &b[l]);
+        secp256k1_fe_lanes_set_fe(&al.x, l, &a[l].x);
+        secp256k1_fe_lanes_set_fe(&al.y, l, &a[l].y);
+        secp256k1_fe_lanes_set_fe(&al.z, l, &a[l].z);
+        al.infinity[l] = a[l].infinity;
+    }
+
+    secp256k1_gej_lanes_add_ge(&sl, &al, &bl);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        secp256k1_gej_add_ge(&r, &a[l], &b[l]);
+        secp256k1_gej_lanes_get_gej(&rl, &sl, l);
+        CHECK(r.infinity == rl.infinity);
+        if (!r.infinity) {
+            secp256k1_ge_set_gej(&ga, &r);
+            ge_equals_gej(&ga, &rl);
+        }
+    }
+
+    /* Double the sums (including the infinity of lane 3 when a = -b), in place */
+    secp256k1_gej_lanes_double(&sl, &sl);
+    for (l = 0; l < SECP256K1_FE_LANES; l++) {
+        secp256k1_gej_add_ge(&r, &a[l], &b[l]);
+        secp256k1_gej_double(&r, &r);
+        secp256k1_gej_lanes_get_gej(&rl, &sl, l);
+        CHECK(r.infinity == rl.infinity);
+        if (!r.infinity) {
+            secp256k1_ge_set_gej(&ga, &r);
+            ge_equals_gej(&ga, &rl);
+        }
+    }
+}
+
+void run_group_lanes(void) {
+    run_lanes_test(test_group_lanes, count);
+}
+
 void run_group_decompress(void) {
     int i;
     for (i = 0; i < count * 4; i++) {
@@ -3321,6 +4141,245 @@ void test_ecmult_multi_batching(void) {
     free(pt);
 }
 
+/* Compares affine bucket accumulation to the regular Pippenger algorithm
+ * with enough points to fill several batches of affine additions. Some
+ * points occur repeatedly and with opposite signs to exercise the doubling
+ * and cancellation cases. */
+void test_ecmult_multi_pippenger_affine(void) {
+    static const size_t n_points = 3*PIPPENGER_AFFINE_BATCH;
+    secp256k1_scalar scG;
+    secp256k1_scalar *sc = (secp256k1_scalar *)checked_malloc(&ctx->error_callback, sizeof(secp256k1_scalar) * n_points);
+    secp256k1_ge *pt = (secp256k1_ge *)checked_malloc(&ctx->error_callback, sizeof(secp256k1_ge) * n_points);
+    secp256k1_gej r, r2;
+    ecmult_multi_data data;
+    secp256k1_scratch *scratch;
+    size_t i;
+
+    random_scalar_order(&scG);
+    for (i = 0; i < n_points; i++) {
+        if (i % 4 == 3) {
+            pt[i] = pt[i / 8];
+            sc[i] = sc[i / 8];
+            if (i % 8 == 7) {
+                secp256k1_scalar_negate(&sc[i], &sc[i]);
+            }
+        } else {
+            random_group_element_test(&pt[i]);
+            random_scalar_order(&sc[i]);
+        }
+    }
+    data.sc = sc;
+    data.pt = pt;
+
+    scratch = secp256k1_scratch_create(&ctx->error_callback, secp256k1_pippenger_affine_scratch_size(n_points, secp256k1_pippenger_bucket_window(n_points)) + PIPPENGER_AFFINE_SCRATCH_OBJECTS*ALIGNMENT);
+    CHECK(secp256k1_ecmult_pippenger_affine_batch_single(&ctx->error_callback, &ctx->ecmult_ctx, scratch, &r, &scG, ecmult_multi_callback, &data, n_points));
+    CHECK(secp256k1_ecmult_pippenger_batch_single(&ctx->error_callback, &ctx->ecmult_ctx, scratch, &r2, &scG, ecmult_multi_callback, &data, n_points));
+    secp256k1_gej_neg(&r2, &r2);
+    secp256k1_gej_add_var(&r, &r, &r2, NULL);
+    CHECK(secp256k1_gej_is_infinity(&r));
+    secp256k1_scratch_destroy(&ctx->error_callback, scratch);
+
+    /* The scratch space required by the regular algorithm is not enough */
+    scratch = secp256k1_scratch_create(&ctx->error_callback, secp256k1_pippenger_scratch_size(n_points, secp256k1_pippenger_bucket_window(n_points)) + PIPPENGER_SCRATCH_OBJECTS*ALIGNMENT);
+    CHECK(!secp256k1_ecmult_pippenger_affine_batch_single(&ctx->error_callback, &ctx->ecmult_ctx, scratch, &r, &scG, ecmult_multi_callback, &data, n_points));
+    secp256k1_scratch_destroy(&ctx->error_callback, scratch);
+
+    free(sc);
+    free(pt);
+}
+
+/* Runs the tasks in reverse order to make sure the parallel ecmult_multi
+ * functions do not depend on the order in which they are executed. */
+static void test_parallel_for_reverse(void (*fn)(size_t idx, void *fn_data), void *fn_data, size_t n, void *data) {
+    size_t *n_calls = (size_t *) data;
+    while (n > 0) {
+        n--;
+        fn(n, fn_data);
+    }
+    if (n_calls != NULL) {
+        (*n_calls)++;
+    }
+}
+
+/* Wrapper for secp256k1_ecmult_multi_func interface which gives the
+ * parallel Pippenger algorithm three tasks. */
+static secp256k1_scratch *pippenger_parallel_extra_scratch[2];
+static int ecmult_pippenger_batch_parallel_single(const secp256k1_callback* error_callback, const secp256k1_ecmult_context *actx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n) {
+    secp256k1_scratch *scratches[3];
+    scratches[0] = scratch;
+    scratches[1] = pippenger_parallel_extra_scratch[0];
+    scratches[2] = pippenger_parallel_extra_scratch[1];
+    return secp256k1_ecmult_pippenger_batch_parallel(error_callback, actx, scratches, 3, r, inp_g_sc, cb, cbdata, n, 0, test_parallel_for_reverse, NULL);
+}
+
+void test_ecmult_multi_parallel(void) {
+    static const int n_points = 4*ECMULT_PARALLEL_MIN_POINTS + 3;
+    secp256k1_scalar scG;
+    secp256k1_scalar szero;
+    secp256k1_scalar sc[4*ECMULT_PARALLEL_MIN_POINTS + 3];
+    secp256k1_ge pt[4*ECMULT_PARALLEL_MIN_POINTS + 3];
+    secp256k1_gej r;
+    secp256k1_gej r2;
+    ecmult_multi_data data;
+    secp256k1_scratch *scratch[5];
+    size_t scratch_size[2];
+    size_t n_scratch;
+    size_t n_calls;
+    int i, k;
+
+    secp256k1_gej_set_infinity(&r2);
+    secp256k1_scalar_set_int(&szero, 0);
+    random_scalar_order(&scG);
+    secp256k1_ecmult(&ctx->ecmult_ctx, &r2, &r2, &szero, &scG);
+    for (i = 0; i < n_points; i++) {
+        secp256k1_gej ptgj;
+        random_group_element_test(&pt[i]);
+        random_scalar_order(&sc[i]);
+        secp256k1_gej_set_ge(&ptgj, &pt[i]);
+        secp256k1_ecmult(&ctx->ecmult_ctx, &ptgj, &ptgj, &sc[i], NULL);
+        secp256k1_gej_add_var(&r2, &r2, &ptgj, NULL);
+    }
+    secp256k1_gej_neg(&r2, &r2);
+    data.sc = sc;
+    data.pt = pt;
+
+    /* With the large scratch spaces all points fit into a single Pippenger
+     * batch which is parallelized over its windows. The small ones only fit
+     * half of the points, so the points are split between the tasks. */
+    scratch_size[0] = 262144;
+    scratch_size[1] = secp256k1_pippenger_scratch_size(n_points / 2, secp256k1_pippenger_bucket_window(n_points / 2)) + PIPPENGER_SCRATCH_OBJECTS*ALIGNMENT;
+    for (k = 0; k < 2; k++) {
+        for (i = 0; i < 5; i++) {
+            scratch[i] = secp256k1_scratch_create(&ctx->error_callback, scratch_size[k]);
+        }
+        CHECK((secp256k1_pippenger_max_points(&ctx->error_callback, scratch[0]) >= (size_t)n_points) == (k == 0));
+        for (n_scratch = 1; n_scratch <= 5; n_scratch++) {
+            n_calls = 0;
+            CHECK(secp256k1_ecmult_multi_var_parallel(&ctx->error_callback, &ctx->ecmult_ctx, scratch, n_scratch, &r, &scG, ecmult_multi_callback, &data, n_points, test_parallel_for_reverse, &n_calls));
+            CHECK((n_calls > 0) == (n_scratch > 1));
+            secp256k1_gej_add_var(&r, &r, &r2, NULL);
+            CHECK(secp256k1_gej_is_infinity(&r));
+
+            /* Without a parallel_for the tasks are run serially */
+            CHECK(secp256k1_ecmult_multi_var_parallel(&ctx->error_callback, &ctx->ecmult_ctx, scratch, n_scratch, &r, &scG, ecmult_multi_callback, &data, n_points, NULL, NULL));
+            secp256k1_gej_add_var(&r, &r, &r2, NULL);
+            CHECK(secp256k1_gej_is_infinity(&r));
+
+            CHECK(!secp256k1_ecmult_multi_var_parallel(&ctx->error_callback, &ctx->ecmult_ctx, scratch, n_scratch, &r, &scG, ecmult_multi_false_callback, &data, n_points, test_parallel_for_reverse, NULL));
+            for (i = 0; i < 5; i++) {
+                CHECK(secp256k1_scratch_checkpoint(&ctx->error_callback, scratch[i]) == 0);
+            }
+        }
+        for (i = 0; i < 5; i++) {
+            secp256k1_scratch_destroy(&ctx->error_callback, scratch[i]);
+        }
+    }
+}
+
+typedef struct {
+    secp256k1_scalar *sc;
+    const secp256k1_pubkey_table *tables;
+} ecmult_multi_table_data;
+
+static int ecmult_multi_table_callback(secp256k1_scalar *sc, const unsigned char **table, size_t idx, void *cbdata) {
+    ecmult_multi_table_data *data = (ecmult_multi_table_data*) cbdata;
+    *sc = data->sc[idx];
+    *table = data->tables[idx].data;
+    return 1;
+}
+
+static int ecmult_multi_table_false_callback(secp256k1_scalar *sc, const unsigned char **table, size_t idx, void *cbdata) {
+    (void)sc;
+    (void)table;
+    (void)idx;
+    (void)cbdata;
+    return 0;
+}
+
+void test_ecmult_multi_table(void) {
+    static const size_t ns[] = {0, 1, ECMULT_MULTI_TABLE_CHUNK, ECMULT_MULTI_TABLE_CHUNK + 1, 40};
+    secp256k1_scalar sc[40];
+    secp256k1_ge pt[40];
+    secp256k1_pubkey_table tables[40];
+    secp256k1_scalar scG;
+    secp256k1_gej r, r2;
+    ecmult_multi_data data;
+    ecmult_multi_table_data table_data;
+    size_t i;
+    int g;
+
+    random_scalar_order(&scG);
+    for (i = 0; i < 40; i++) {
+        random_group_element_test(&pt[i]);
+        random_scalar_order(&sc[i]);
+        secp256k1_ecmult_point_table(tables[i].data, &pt[i]);
+        CHECK(secp256k1_pubkey_table_matches(&tables[i], &pt[i]));
+    }
+    CHECK(!secp256k1_pubkey_table_matches(&tables[0], &pt[1]));
+    /* Zero scalars are allowed */
+    secp256k1_scalar_set_int(&sc[3], 0);
+    data.sc = sc;
+    data.pt = pt;
+    table_data.sc = sc;
+    table_data.tables = tables;
+
+    for (i = 0; i < sizeof(ns) / sizeof(ns[0]); i++) {
+        for (g = 0; g < 2; g++) {
+            const secp256k1_scalar *inp_g_sc = g ? &scG : NULL;
+            CHECK(secp256k1_ecmult_multi_var(&ctx->error_callback, &ctx->ecmult_ctx, NULL, &r2, inp_g_sc, ecmult_multi_callback, &data, ns[i]));
+            CHECK(secp256k1_ecmult_multi_table_var(&ctx->ecmult_ctx, &r, inp_g_sc, ecmult_multi_table_callback, &table_data, ns[i]));
+            secp256k1_gej_neg(&r2, &r2);
+            secp256k1_gej_add_var(&r, &r, &r2, NULL);
+            CHECK(secp256k1_gej_is_infinity(&r));
+        }
+        if (ns[i] > 0) {
+            CHECK(!secp256k1_ecmult_multi_table_var(&ctx->ecmult_ctx, &r, &scG, ecmult_multi_table_false_callback, &table_data, ns[i]));
+        }
+    }
+
+    /* Tables are position independent and can be copied */
+    memcpy(&tables[0], &tables[2], sizeof(tables[0]));
+    data.pt = pt + 2;
+    table_data.tables = tables;
+    CHECK(secp256k1_ecmult_multi_var(&ctx->error_callback, &ctx->ecmult_ctx, NULL, &r2, NULL, ecmult_multi_callback, &data, 1));
+    CHECK(secp256k1_ecmult_multi_table_var(&ctx->ecmult_ctx, &r, NULL, ecmult_multi_table_callback, &table_data, 1));
+    secp256k1_gej_neg(&r2, &r2);
+    secp256k1_gej_add_var(&r, &r, &r2, NULL);
+    CHECK(secp256k1_gej_is_infinity(&r));
+}
+
+void test_pubkey_table_create(void) {
+    unsigned char seckey[32];
+    secp256k1_pubkey pubkey;
+    secp256k1_xonly_pubkey xonly_pubkey;
+    secp256k1_pubkey_table table;
+    secp256k1_pubkey_table table2;
+    secp256k1_ge pk;
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+    secp256k1_rand256(seckey);
+    CHECK(secp256k1_ec_pubkey_create(ctx, &pubkey, seckey) == 1);
+    CHECK(secp256k1_xonly_pubkey_create(ctx, &xonly_pubkey, seckey) == 1);
+    CHECK(secp256k1_pubkey_table_create(ctx, &table, &pubkey) == 1);
+    CHECK(secp256k1_pubkey_load(ctx, &pk, &pubkey));
+    CHECK(secp256k1_pubkey_table_matches(&table, &pk));
+    CHECK(secp256k1_xonly_pubkey_table_create(ctx, &table2, &xonly_pubkey) == 1);
+    CHECK(secp256k1_xonly_pubkey_load(ctx, &pk, &xonly_pubkey));
+    CHECK(secp256k1_pubkey_table_matches(&table2, &pk));
+    CHECK(ecount == 0);
+
+    CHECK(secp256k1_pubkey_table_create(ctx, NULL, &pubkey) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_pubkey_table_create(ctx, &table, NULL) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_xonly_pubkey_table_create(ctx, NULL, &xonly_pubkey) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_xonly_pubkey_table_create(ctx, &table, NULL) == 0);
+    CHECK(ecount == 4);
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+}
+
 void run_ecmult_multi_tests(void) {
     secp256k1_scratch *scratch;
 
@@ -3331,8 +4390,15 @@ void run_ecmult_multi_tests(void) {
     test_ecmult_multi(NULL, secp256k1_ecmult_multi_var);
     test_ecmult_multi(scratch, secp256k1_ecmult_pippenger_batch_single);
     test_ecmult_multi_batch_single(secp256k1_ecmult_pippenger_batch_single);
+    test_ecmult_multi(scratch, secp256k1_ecmult_pippenger_affine_batch_single);
+    test_ecmult_multi_batch_single(secp256k1_ecmult_pippenger_affine_batch_single);
     test_ecmult_multi(scratch, secp256k1_ecmult_strauss_batch_single);
     test_ecmult_multi_batch_single(secp256k1_ecmult_strauss_batch_single);
+    pippenger_parallel_extra_scratch[0] = secp256k1_scratch_create(&ctx->error_callback, 65536);
+    pippenger_parallel_extra_scratch[1] = secp256k1_scratch_create(&ctx->error_callback, 65536);
+    test_ecmult_multi(scratch, ecmult_pippenger_batch_parallel_single);
+    secp256k1_scratch_destroy(&ctx->error_callback, pippenger_parallel_extra_scratch[0]);
+    secp256k1_scratch_destroy(&ctx->error_callback, pippenger_parallel_extra_scratch[1]);
     secp256k1_scratch_destroy(&ctx->error_callback, scratch);
 
     /* Run test_ecmult_multi with space for exactly one point */
@@ -3341,7 +4407,11 @@ void run_ecmult_multi_tests(void) {
     secp256k1_scratch_destroy(&ctx->error_callback, scratch);
 
     test_ecmult_multi_batch_size_helper();
+    test_ecmult_multi_table();
+    test_pubkey_table_create();
     test_ecmult_multi_batching();
+    test_ecmult_multi_pippenger_affine();
+    test_ecmult_multi_parallel();
 }
 
 void test_wnaf(const secp256k1_scalar *number, int w) {
@@ -3602,6 +4672,75 @@ void run_ecmult_constants(void) {
     test_ecmult_constants();
 }
 
+void test_ecmult_gen_compute_table(int blocks, int teeth) {
+    /* Check the first and last entry of every block against ecmult. */
+    int spacing = (256 + blocks * teeth - 1) / (blocks * teeth);
+    int points = 1 << (teeth - 1);
+    secp256k1_ge_storage *table = (secp256k1_ge_storage *)checked_malloc(&ctx->error_callback, blocks * points * sizeof(secp256k1_ge_storage));
+    secp256k1_scalar two, half, pow, sum, zero;
+    secp256k1_gej rj;
+    secp256k1_ge r;
+    int block, tooth, i, j;
+
+    secp256k1_ecmult_gen_compute_table(table, &secp256k1_ge_const_g, blocks, teeth, spacing);
+    secp256k1_scalar_set_int(&two, 2);
+    secp256k1_scalar_inverse(&half, &two);
+    secp256k1_scalar_set_int(&zero, 0);
+    for (block = 0; block < blocks; block++) {
+        for (j = 0; j < 2; j++) {
+            int index = j ? points - 1 : 0;
+            secp256k1_scalar_set_int(&sum, 0);
+            for (tooth = 0; tooth < teeth; tooth++) {
+                secp256k1_scalar_set_int(&pow, 1);
+                for (i = 0; i < (block * teeth + tooth) * spacing; i++) {
+                    secp256k1_scalar_add(&pow, &pow, &pow);
+                }
+                if (tooth == teeth - 1 || !((index >> tooth) & 1)) {
+                    secp256k1_scalar_negate(&pow, &pow);
+                }
+                secp256k1_scalar_add(&sum, &sum, &pow);
+            }
+            secp256k1_scalar_mul(&sum, &sum, &half);
+            secp256k1_gej_set_infinity(&rj);
+            secp256k1_ecmult(&ctx->ecmult_ctx, &rj, &rj, &zero, &sum);
+            secp256k1_ge_from_storage(&r, &table[block * points + index]);
+            ge_equals_gej(&r, &rj);
+        }
+    }
+    free(table);
+}
+
+void run_ecmult_gen_comb(void) {
+    secp256k1_scalar x;
+    secp256k1_gej r1, r2;
+    secp256k1_scalar zero;
+    int i;
+
+    test_ecmult_gen_compute_table(1, 1);
+    test_ecmult_gen_compute_table(1, 8);
+    test_ecmult_gen_compute_table(2, 5);
+    test_ecmult_gen_compute_table(11, 6);
+    test_ecmult_gen_compute_table(43, 6);
+    test_ecmult_gen_compute_table(256, 1);
+
+    /* Compare the comb with ecmult on scalars whose top bits are all set, which
+     * exercises the teeth beyond the scalar in the last block. */
+    secp256k1_scalar_set_int(&zero, 0);
+    for (i = 0; i < count; i++) {
+        random_scalar_order_test(&x);
+        if (i & 1) {
+            secp256k1_scalar_set_int(&x, 1);
+            secp256k1_scalar_negate(&x, &x);
+        }
+        secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &r1, &x);
+        secp256k1_gej_set_infinity(&r2);
+        secp256k1_ecmult(&ctx->ecmult_ctx, &r2, &r2, &zero, &x);
+        secp256k1_gej_neg(&r2, &r2);
+        secp256k1_gej_add_var(&r1, &r1, &r2, NULL);
+        CHECK(secp256k1_gej_is_infinity(&r1));
+    }
+}
+
 void test_ecmult_gen_blind(void) {
     /* Test ecmult_gen() blinding and confirm that the blinding changes, the affine points match, and the z's don't match. */
     secp256k1_scalar key;
@@ -3609,18 +4748,18 @@ void test_ecmult_gen_blind(void) {
     unsigned char seed32[32];
     secp256k1_gej pgej;
     secp256k1_gej pgej2;
-    secp256k1_gej i;
+    secp256k1_ge p;
     secp256k1_ge pge;
     random_scalar_order_test(&key);
     secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &pgej, &key);
     secp256k1_rand256(seed32);
-    b = ctx->ecmult_gen_ctx.blind;
-    i = ctx->ecmult_gen_ctx.initial;
+    b = ctx->ecmult_gen_ctx.scalar_offset;
+    p = ctx->ecmult_gen_ctx.ge_offset;
     secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, seed32);
-    CHECK(!secp256k1_scalar_eq(&b, &ctx->ecmult_gen_ctx.blind));
+    CHECK(!secp256k1_scalar_eq(&b, &ctx->ecmult_gen_ctx.scalar_offset));
     secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &pgej2, &key);
     CHECK(!gej_xyz_equals_gej(&pgej, &pgej2));
-    CHECK(!gej_xyz_equals_gej(&i, &ctx->ecmult_gen_ctx.initial));
+    CHECK(!secp256k1_fe_equal_var(&p.x, &ctx->ecmult_gen_ctx.ge_offset.x));
     secp256k1_ge_set_gej(&pge, &pgej);
     ge_equals_gej(&pge, &pgej2);
 }
@@ -3628,13 +4767,16 @@ void test_ecmult_gen_blind(void) {
 void test_ecmult_gen_blind_reset(void) {
     /* Test ecmult_gen() blinding reset and confirm that the blinding is consistent. */
     secp256k1_scalar b;
-    secp256k1_gej initial;
+    secp256k1_ge p;
+    secp256k1_fe s;
     secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, 0);
-    b = ctx->ecmult_gen_ctx.blind;
-    initial = ctx->ecmult_gen_ctx.initial;
+    b = ctx->ecmult_gen_ctx.scalar_offset;
+    p = ctx->ecmult_gen_ctx.ge_offset;
+    s = ctx->ecmult_gen_ctx.proj_blind;
     secp256k1_ecmult_gen_blind(&ctx->ecmult_gen_ctx, 0);
-    CHECK(secp256k1_scalar_eq(&b, &ctx->ecmult_gen_ctx.blind));
-    CHECK(gej_xyz_equals_gej(&initial, &ctx->ecmult_gen_ctx.initial));
+    CHECK(secp256k1_scalar_eq(&b, &ctx->ecmult_gen_ctx.scalar_offset));
+    ge_equals_ge(&p, &ctx->ecmult_gen_ctx.ge_offset);
+    CHECK(secp256k1_fe_equal_var(&s, &ctx->ecmult_gen_ctx.proj_blind));
 }
 
 void run_ecmult_gen_blind(void) {
@@ -3645,6 +4787,51 @@ void run_ecmult_gen_blind(void) {
     }
 }
 
+void test_ecmult_gen_multi(void) {
+    secp256k1_scalar x[2 * SECP256K1_FE_LANES + 1];
+    secp256k1_gej r[2 * SECP256K1_FE_LANES + 1], rr;
+    secp256k1_ge ge;
+    int n, i;
+
+    /* Also check the lane code directly, even if the engine would not use it */
+    for (i = 0; i < SECP256K1_FE_LANES; i++) {
+        random_scalar_order_test(&x[i]);
+    }
+    secp256k1_scalar_set_int(&x[1], 0);
+    secp256k1_ecmult_gen_lanes(&ctx->ecmult_gen_ctx, r, x);
+    for (i = 0; i < SECP256K1_FE_LANES; i++) {
+        secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &rr, &x[i]);
+        CHECK(secp256k1_gej_is_infinity(&rr) == (i == 1));
+        CHECK(secp256k1_gej_is_infinity(&r[i]) == (i == 1));
+        if (i != 1) {
+            secp256k1_ge_set_gej(&ge, &rr);
+            ge_equals_gej(&ge, &r[i]);
+        }
+    }
+    for (n = 0; n < (int)(sizeof(x) / sizeof(x[0])); n++) {
+        for (i = 0; i < n; i++) {
+            random_scalar_order_test(&x[i]);
+        }
+        if (n > 2) {
+            secp256k1_scalar_set_int(&x[n - 2], 0);
+        }
+        secp256k1_ecmult_gen_multi(&ctx->ecmult_gen_ctx, r, x, n);
+        for (i = 0; i < n; i++) {
+            secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &rr, &x[i]);
+            if (secp256k1_gej_is_infinity(&rr)) {
+                CHECK(secp256k1_gej_is_infinity(&r[i]));
+            } else {
+                secp256k1_ge_set_gej(&ge, &rr);
+                ge_equals_gej(&ge, &r[i]);
+            }
+        }
+    }
+}
+
+void run_ecmult_gen_multi(void) {
+    run_lanes_test(test_ecmult_gen_multi, 1);
+}
+
 #ifdef USE_ENDOMORPHISM
 /***** ENDOMORPHISH TESTS *****/
 void test_scalar_split(void) {
@@ -4314,6 +5501,189 @@ void run_eckey_edge_case_test(void) {
     secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
 }
 
+#define N_KEYS 150
+void run_ec_pubkey_create_batch(void) {
+    static unsigned char seckey[N_KEYS][32];
+    static unsigned char output33[N_KEYS][33];
+    static secp256k1_pubkey pubkey[N_KEYS];
+    const unsigned char zeros33[33] = {0};
+    int results[N_KEYS];
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    size_t n = secp256k1_rand_int(N_KEYS) + 1;
+    size_t bad = secp256k1_rand_int(n);
+    size_t i;
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    for (i = 0; i < N_KEYS; i++) {
+        secp256k1_scalar sk;
+        random_scalar_order_test(&sk);
+        secp256k1_scalar_get_b32(seckey[i], &sk);
+    }
+
+    CHECK(secp256k1_ec_pubkey_create_batch(ctx, NULL, NULL, NULL, NULL, 0) == 1);
+    CHECK(secp256k1_ec_pubkey_create_batch(ctx, results, pubkey, output33[0], seckey[0], n) == 1);
+    for (i = 0; i < n; i++) {
+        secp256k1_pubkey pk;
+        unsigned char out[33];
+        size_t len = 33;
+        CHECK(results[i] == 1);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pk, seckey[i]) == 1);
+        CHECK(memcmp(&pk, &pubkey[i], sizeof(pk)) == 0);
+        CHECK(secp256k1_ec_pubkey_serialize(ctx, out, &len, &pk, SECP256K1_EC_COMPRESSED) == 1);
+        CHECK(memcmp(out, output33[i], 33) == 0);
+    }
+    CHECK(ecount == 0);
+    CHECK(secp256k1_ec_pubkey_create_batch(ctx, results, NULL, NULL, seckey[0], 1) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ec_pubkey_create_batch(ctx, results, pubkey, NULL, NULL, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ec_pubkey_create_batch(none, results, pubkey, NULL, seckey[0], 1) == 0);
+    CHECK(ecount == 3);
+
+    /* An invalid secret key only affects its own public key */
+    if (secp256k1_rand_bits(1)) {
+        memset(seckey[bad], 0, 32);
+    } else {
+        memset(seckey[bad], 0xFF, 32);
+    }
+    CHECK(secp256k1_ec_pubkey_create_batch(ctx, NULL, pubkey, NULL, seckey[0], n) == 0);
+    CHECK(secp256k1_ec_pubkey_create_batch(ctx, results, pubkey, output33[0], seckey[0], n) == 0);
+    for (i = 0; i < n; i++) {
+        secp256k1_pubkey pk;
+        CHECK(results[i] == (i != bad));
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pk, seckey[i]) == results[i]);
+        CHECK(memcmp(&pk, &pubkey[i], sizeof(pk)) == 0);
+    }
+    CHECK(memcmp(output33[bad], zeros33, 33) == 0);
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+    secp256k1_context_destroy(none);
+}
+#undef N_KEYS
+
+#define N_KEYS 80
+void run_pubkey_tweak_add_batch(void) {
+    static unsigned char tweak[N_KEYS][32];
+    static secp256k1_pubkey pubkey[N_KEYS], output[N_KEYS];
+    static secp256k1_xonly_pubkey xonly_pubkey[N_KEYS], xonly_output[N_KEYS];
+    const secp256k1_pubkey *pubkey_ptr[N_KEYS];
+    const secp256k1_xonly_pubkey *xonly_ptr[N_KEYS];
+    const unsigned char *tweak_ptr[N_KEYS];
+    int results[N_KEYS], is_negated[N_KEYS];
+    secp256k1_context *vrfy = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    size_t n = secp256k1_rand_int(N_KEYS) + 1;
+    size_t bad = secp256k1_rand_int(n);
+    size_t i;
+    int c;
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    for (i = 0; i < N_KEYS; i++) {
+        secp256k1_scalar sk;
+        unsigned char seckey[32];
+        random_scalar_order_test(&sk);
+        secp256k1_scalar_get_b32(seckey, &sk);
+        random_scalar_order_test(&sk);
+        secp256k1_scalar_get_b32(tweak[i], &sk);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pubkey[i], seckey) == 1);
+        CHECK(secp256k1_xonly_pubkey_create(ctx, &xonly_pubkey[i], seckey) == 1);
+        /* Some runs of keys share their parent */
+        pubkey_ptr[i] = (i > 0 && secp256k1_rand_bits(1)) ? pubkey_ptr[i - 1] : &pubkey[i];
+        xonly_ptr[i] = &xonly_pubkey[pubkey_ptr[i] - pubkey];
+        tweak_ptr[i] = tweak[i];
+    }
+
+    CHECK(secp256k1_ec_pubkey_tweak_add_batch(ctx, NULL, NULL, NULL, NULL, 0) == 1);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_batch(ctx, NULL, NULL, NULL, NULL, NULL, 0) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_ec_pubkey_tweak_add_batch(none, results, output, pubkey_ptr, tweak_ptr, n) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ec_pubkey_tweak_add_batch(ctx, results, NULL, pubkey_ptr, tweak_ptr, n) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ec_pubkey_tweak_add_batch(ctx, results, output, NULL, tweak_ptr, n) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_ec_pubkey_tweak_add_batch(ctx, results, output, pubkey_ptr, NULL, n) == 0);
+    CHECK(ecount == 4);
+    CHECK(secp256k1_xonly_pubkey_tweak_add_batch(ctx, results, xonly_output, NULL, xonly_ptr, tweak_ptr, n) == 0);
+    CHECK(ecount == 5);
+    ecount = 0;
+
+    for (c = 0; c < 3; c++) {
+        /* Run with a context with the signing table, one without it, and with a
+         * tweak that is out of range or makes the result infinity. */
+        secp256k1_context *tctx = c == 1 ? vrfy : ctx;
+        if (c == 2) {
+            if (secp256k1_rand_bits(1)) {
+                memset(tweak[bad], 0xFF, 32);
+            } else {
+                secp256k1_ge ge;
+                secp256k1_gej gej;
+                secp256k1_scalar t;
+                /* Use the discrete log of the parent: tweak = -sk */
+                unsigned char seckey[32];
+                secp256k1_scalar sk;
+                random_scalar_order_test(&sk);
+                secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &gej, &sk);
+                secp256k1_ge_set_gej(&ge, &gej);
+                /* Make it a valid x-only key as well */
+                if (!secp256k1_fe_is_quad_var(&ge.y)) {
+                    secp256k1_scalar_negate(&sk, &sk);
+                    secp256k1_ge_neg(&ge, &ge);
+                }
+                secp256k1_scalar_get_b32(seckey, &sk);
+                secp256k1_pubkey_save((secp256k1_pubkey *) pubkey_ptr[bad], &ge);
+                CHECK(secp256k1_xonly_pubkey_create(ctx, (secp256k1_xonly_pubkey *) xonly_ptr[bad], seckey) == 1);
+                secp256k1_scalar_negate(&t, &sk);
+                secp256k1_scalar_get_b32(tweak[bad], &t);
+            }
+        }
+        CHECK(secp256k1_ec_pubkey_tweak_add_batch(tctx, results, output, pubkey_ptr, tweak_ptr, n) == (c != 2));
+        for (i = 0; i < n; i++) {
+            secp256k1_pubkey pk = *pubkey_ptr[i];
+            CHECK(results[i] == (c != 2 || i != bad));
+            CHECK(secp256k1_ec_pubkey_tweak_add(ctx, &pk, tweak[i]) == results[i]);
+            CHECK(memcmp(&pk, &output[i], sizeof(pk)) == 0);
+        }
+        CHECK(secp256k1_xonly_pubkey_tweak_add_batch(tctx, NULL, xonly_output, is_negated, xonly_ptr, tweak_ptr, n) == (c != 2));
+        for (i = 0; i < n; i++) {
+            secp256k1_xonly_pubkey pk = *xonly_ptr[i];
+            int neg = 0;
+            if (c == 2 && i == bad) {
+                CHECK(secp256k1_xonly_pubkey_tweak_add(ctx, &pk, &neg, tweak[i]) == 0);
+                CHECK(is_negated[i] == 0);
+                continue;
+            }
+            CHECK(secp256k1_xonly_pubkey_tweak_add(ctx, &pk, &neg, tweak[i]) == 1);
+            CHECK(memcmp(&pk, &xonly_output[i], sizeof(pk)) == 0);
+            CHECK(neg == is_negated[i]);
+            CHECK(secp256k1_xonly_pubkey_tweak_test(ctx, &xonly_output[i], is_negated[i], xonly_ptr[i], tweak[i]) == 1);
+        }
+    }
+    CHECK(ecount == 0);
+
+    /* Tweaking in place */
+    for (i = 0; i < n; i++) {
+        pubkey_ptr[i] = &pubkey[i];
+        output[i] = pubkey[i];
+    }
+    c = secp256k1_ec_pubkey_tweak_add_batch(ctx, results, pubkey, pubkey_ptr, tweak_ptr, n);
+    for (i = 0; i < n; i++) {
+        secp256k1_pubkey pk = output[i];
+        CHECK(secp256k1_ec_pubkey_tweak_add(ctx, &pk, tweak[i]) == results[i]);
+        CHECK(memcmp(&pk, &pubkey[i], sizeof(pk)) == 0);
+        CHECK(results[i] == 1 || i == bad);
+    }
+    CHECK(c == results[bad]);
+
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+    secp256k1_context_destroy(vrfy);
+    secp256k1_context_destroy(none);
+}
+#undef N_KEYS
+
 void test_xonly_pubkey(void) {
     unsigned char sk[32] = { 0 };
     unsigned char ones32[32];
@@ -4500,6 +5870,66 @@ void test_xonly_pubkey_api(void) {
     secp256k1_context_destroy(vrfy);
 }
 
+void test_keypair(void) {
+    unsigned char sk[32];
+    unsigned char zeros96[96];
+    secp256k1_keypair keypair;
+    secp256k1_xonly_pubkey pk, pk_keypair;
+    secp256k1_context *none = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+    secp256k1_context *vrfy = secp256k1_context_create(SECP256K1_CONTEXT_VERIFY);
+    int i;
+    int ecount = 0;
+
+    memset(zeros96, 0, sizeof(zeros96));
+    secp256k1_context_set_illegal_callback(none, counting_illegal_callback_fn, &ecount);
+    secp256k1_context_set_illegal_callback(vrfy, counting_illegal_callback_fn, &ecount);
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+
+    /* The public key matches secp256k1_xonly_pubkey_create */
+    for (i = 0; i < count; i++) {
+        secp256k1_scalar s;
+        random_scalar_order_test(&s);
+        secp256k1_scalar_get_b32(sk, &s);
+        CHECK(secp256k1_keypair_create(ctx, &keypair, sk) == 1);
+        CHECK(secp256k1_xonly_pubkey_create(ctx, &pk, sk) == 1);
+        CHECK(secp256k1_keypair_xonly_pub(none, &pk_keypair, &keypair) == 1);
+        CHECK(memcmp(&pk, &pk_keypair, sizeof(pk)) == 0);
+    }
+    CHECK(ecount == 0);
+
+    CHECK(secp256k1_keypair_create(none, &keypair, sk) == 0);
+    CHECK(ecount == 1);
+    CHECK(memcmp(&keypair, zeros96, sizeof(keypair)) == 0);
+    CHECK(secp256k1_keypair_create(vrfy, &keypair, sk) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_keypair_create(ctx, NULL, sk) == 0);
+    CHECK(ecount == 3);
+    CHECK(secp256k1_keypair_create(ctx, &keypair, NULL) == 0);
+    CHECK(ecount == 4);
+    CHECK(memcmp(&keypair, zeros96, sizeof(keypair)) == 0);
+
+    /* Invalid secret keys */
+    memset(sk, 0, sizeof(sk));
+    CHECK(secp256k1_keypair_create(ctx, &keypair, sk) == 0);
+    CHECK(memcmp(&keypair, zeros96, sizeof(keypair)) == 0);
+    memset(sk, 0xFF, sizeof(sk));
+    CHECK(secp256k1_keypair_create(ctx, &keypair, sk) == 0);
+    CHECK(memcmp(&keypair, zeros96, sizeof(keypair)) == 0);
+    CHECK(ecount == 4);
+
+    /* Getting the public key of a zeroed keypair fails */
+    CHECK(secp256k1_keypair_xonly_pub(none, &pk, &keypair) == 0);
+    CHECK(ecount == 5);
+    CHECK(secp256k1_keypair_xonly_pub(none, NULL, &keypair) == 0);
+    CHECK(ecount == 6);
+    CHECK(secp256k1_keypair_xonly_pub(none, &pk, NULL) == 0);
+    CHECK(ecount == 7);
+
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+    secp256k1_context_destroy(none);
+    secp256k1_context_destroy(vrfy);
+}
+
 void test_xonly_pubkey_tweak(void) {
     unsigned char zeros[32];
     unsigned char overflows[32];
@@ -4606,6 +6036,86 @@ void run_ecdsa_sign_verify(void) {
     }
 }
 
+#define N_SIGS 80
+void test_ecdsa_verify_batch(void) {
+    unsigned char msg[N_SIGS][32];
+    unsigned char key[32];
+    secp256k1_ecdsa_signature sig[N_SIGS];
+    secp256k1_pubkey pubkey[N_SIGS];
+    const secp256k1_ecdsa_signature *sig_ptr[N_SIGS];
+    const unsigned char *msg_ptr[N_SIGS];
+    const secp256k1_pubkey *pubkey_ptr[N_SIGS];
+    int results[N_SIGS];
+    secp256k1_scalar s;
+    size_t n_sigs = secp256k1_rand_int(N_SIGS) + 1;
+    size_t bad = secp256k1_rand_int(n_sigs);
+    size_t i;
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+    for (i = 0; i < N_SIGS; i++) {
+        secp256k1_scalar sk;
+        random_scalar_order_test(&sk);
+        secp256k1_scalar_get_b32(key, &sk);
+        secp256k1_rand256_test(msg[i]);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pubkey[i], key) == 1);
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig[i], msg[i], key, NULL, NULL) == 1);
+        sig_ptr[i] = &sig[i];
+        msg_ptr[i] = msg[i];
+        pubkey_ptr[i] = &pubkey[i];
+    }
+
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, NULL, NULL, NULL, NULL, 0) == 1);
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, results, sig_ptr, msg_ptr, pubkey_ptr, n_sigs) == 1);
+    for (i = 0; i < n_sigs; i++) {
+        CHECK(results[i] == 1);
+    }
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, NULL, sig_ptr, msg_ptr, pubkey_ptr, n_sigs) == 1);
+    CHECK(ecount == 0);
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, results, NULL, msg_ptr, pubkey_ptr, 1) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, results, sig_ptr, NULL, pubkey_ptr, 1) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, results, sig_ptr, msg_ptr, NULL, 1) == 0);
+    CHECK(ecount == 3);
+
+    /* A wrong message only invalidates its own signature */
+    msg[bad][0] ^= 1;
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, results, sig_ptr, msg_ptr, pubkey_ptr, n_sigs) == 0);
+    for (i = 0; i < n_sigs; i++) {
+        CHECK(results[i] == (i != bad));
+        CHECK(secp256k1_ecdsa_verify(ctx, &sig[i], msg[i], &pubkey[i]) == results[i]);
+    }
+    msg[bad][0] ^= 1;
+
+    /* A high s or a zero s must not affect the other signatures */
+    {
+        secp256k1_scalar r;
+        secp256k1_ecdsa_signature_load(ctx, &r, &s, &sig[bad]);
+        secp256k1_scalar_negate(&s, &s);
+        secp256k1_ecdsa_signature_save(&sig[bad], &r, &s);
+        CHECK(secp256k1_ecdsa_verify_batch(ctx, results, sig_ptr, msg_ptr, pubkey_ptr, n_sigs) == 0);
+        for (i = 0; i < n_sigs; i++) {
+            CHECK(results[i] == (i != bad));
+        }
+        secp256k1_scalar_clear(&s);
+        secp256k1_ecdsa_signature_save(&sig[bad], &r, &s);
+        CHECK(secp256k1_ecdsa_verify_batch(ctx, results, sig_ptr, msg_ptr, pubkey_ptr, n_sigs) == 0);
+        for (i = 0; i < n_sigs; i++) {
+            CHECK(results[i] == (i != bad));
+        }
+    }
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+}
+#undef N_SIGS
+
+void run_ecdsa_verify_batch(void) {
+    int i;
+    for (i = 0; i < count; i++) {
+        test_ecdsa_verify_batch();
+    }
+}
+
 /** Dummy nonce generation function that just uses a precomputed nonce, and fails if it is not accepted. Use only for testing. */
 static int precomputed_nonce_function(unsigned char *nonce32, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, void *data, unsigned int counter) {
     (void)msg32;
@@ -4658,6 +6168,83 @@ int is_empty_signature(const secp256k1_ecdsa_signature *sig) {
     return memcmp(sig, res, sizeof(secp256k1_ecdsa_signature)) == 0;
 }
 
+#define N_SIGS 80
+void test_ecdsa_sign_batch(void) {
+    unsigned char msg[N_SIGS][32];
+    const unsigned char *msg_ptr[N_SIGS];
+    unsigned char key[32];
+    unsigned char extra[32];
+    secp256k1_ecdsa_signature sig[N_SIGS];
+    secp256k1_ecdsa_signature sig2;
+    secp256k1_scalar sk;
+    size_t n_sigs = secp256k1_rand_int(N_SIGS) + 1;
+    size_t i;
+    int ecount = 0;
+
+    secp256k1_context_set_illegal_callback(ctx, counting_illegal_callback_fn, &ecount);
+    random_scalar_order_test(&sk);
+    secp256k1_scalar_get_b32(key, &sk);
+    secp256k1_rand256_test(extra);
+    for (i = 0; i < N_SIGS; i++) {
+        secp256k1_rand256_test(msg[i]);
+        msg_ptr[i] = msg[i];
+    }
+
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, NULL, NULL, 0, NULL, NULL, NULL) == 1);
+    /* The signatures are the same as those of secp256k1_ecdsa_sign */
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sig, msg_ptr, n_sigs, key, NULL, NULL) == 1);
+    for (i = 0; i < n_sigs; i++) {
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig2, msg[i], key, NULL, NULL) == 1);
+        CHECK(memcmp(&sig[i], &sig2, sizeof(sig2)) == 0);
+    }
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sig, msg_ptr, n_sigs, key, secp256k1_nonce_function_rfc6979, extra) == 1);
+    for (i = 0; i < n_sigs; i++) {
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig2, msg[i], key, NULL, extra) == 1);
+        CHECK(memcmp(&sig[i], &sig2, sizeof(sig2)) == 0);
+    }
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sig, msg_ptr, n_sigs, key, secp256k1_nonce_function_bipschnorr, NULL) == 1);
+    for (i = 0; i < n_sigs; i++) {
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig2, msg[i], key, secp256k1_nonce_function_bipschnorr, NULL) == 1);
+        CHECK(memcmp(&sig[i], &sig2, sizeof(sig2)) == 0);
+    }
+    /* Unacceptable nonces are retried with the next counter value */
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sig, msg_ptr, n_sigs, key, nonce_function_test_retry, extra) == 1);
+    for (i = 0; i < n_sigs; i++) {
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig2, msg[i], key, NULL, extra) == 1);
+        CHECK(memcmp(&sig[i], &sig2, sizeof(sig2)) == 0);
+    }
+    CHECK(ecount == 0);
+
+    /* Failures zero the signatures */
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sig, msg_ptr, n_sigs, key, nonce_function_test_fail, NULL) == 0);
+    for (i = 0; i < n_sigs; i++) {
+        CHECK(is_empty_signature(&sig[i]));
+    }
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sig, msg_ptr, n_sigs, key, NULL, NULL) == 1);
+    memset(key, 0, 32);
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sig, msg_ptr, n_sigs, key, NULL, NULL) == 0);
+    for (i = 0; i < n_sigs; i++) {
+        CHECK(is_empty_signature(&sig[i]));
+    }
+    CHECK(ecount == 0);
+
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, NULL, msg_ptr, n_sigs, key, NULL, NULL) == 0);
+    CHECK(ecount == 1);
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sig, NULL, n_sigs, key, NULL, NULL) == 0);
+    CHECK(ecount == 2);
+    CHECK(secp256k1_ecdsa_sign_batch(ctx, sig, msg_ptr, n_sigs, NULL, NULL, NULL) == 0);
+    CHECK(ecount == 3);
+    secp256k1_context_set_illegal_callback(ctx, NULL, NULL);
+}
+#undef N_SIGS
+
+void run_ecdsa_sign_batch(void) {
+    int i;
+    for (i = 0; i < count; i++) {
+        test_ecdsa_sign_batch();
+    }
+}
+
 void test_ecdsa_end_to_end(void) {
     unsigned char extra[32] = {0x00};
     unsigned char privkey[32];
@@ -5709,12 +7296,18 @@ int main(int argc, char **argv) {
         secp256k1_rand256(run32);
         CHECK(secp256k1_context_randomize(ctx, secp256k1_rand_bits(1) ? run32 : NULL));
     }
+    run_context_precomputed_tests();
+    run_context_window_tests();
+    run_context_shared_tests();
 
     run_rand_bits();
     run_rand_int();
     run_util_tests();
+    run_ctz_tests();
 
     run_sha256_tests();
+    run_sha256_transform_tests();
+    run_sha256_multi_tests();
     run_hmac_sha256_tests();
     run_rfc6979_hmac_sha256_tests();
 
@@ -5730,13 +7323,17 @@ int main(int argc, char **argv) {
     run_field_inv();
     run_field_inv_var();
     run_field_inv_all_var();
+    run_inverse_tests();
     run_field_misc();
     run_field_convert();
     run_sqr();
     run_sqrt();
+    run_jacobi_tests();
+    run_field_lanes();
 
     /* group tests */
     run_ge();
+    run_group_lanes();
     run_group_decompress();
 
     /* ecmult tests */
@@ -5744,7 +7341,9 @@ int main(int argc, char **argv) {
     run_point_times_order();
     run_ecmult_chain();
     run_ecmult_constants();
+    run_ecmult_gen_comb();
     run_ecmult_gen_blind();
+    run_ecmult_gen_multi();
     run_ecmult_const_tests();
     run_ecmult_multi_tests();
     run_ec_combine();
@@ -5759,10 +7358,13 @@ int main(int argc, char **argv) {
 
     /* EC key edge cases */
     run_eckey_edge_case_test();
+    run_ec_pubkey_create_batch();
+    run_pubkey_tweak_add_batch();
 
     /* xonly key test cases */
     test_xonly_pubkey();
     test_xonly_pubkey_api();
+    test_keypair();
     test_xonly_pubkey_tweak();
     test_xonly_pubkey_tweak_recursive();
 
@@ -5785,6 +7387,8 @@ int main(int argc, char **argv) {
     run_random_pubkeys();
     run_ecdsa_der_parse();
     run_ecdsa_sign_verify();
+    run_ecdsa_verify_batch();
+    run_ecdsa_sign_batch();
     run_ecdsa_end_to_end();
     run_ecdsa_edge_cases();
 #ifdef ENABLE_OPENSSL_TESTS
@@ -14,6 +14,7 @@
 #include <time.h>
 
 #undef USE_ECMULT_STATIC_PRECOMPUTATION
+#undef USE_ECMULT_VERIFY_STATIC_PRECOMPUTATION
 
 #ifndef EXHAUSTIVE_TEST_ORDER
 /* see group_impl.h for allowable values */